@@ -11,6 +11,7 @@
 
 #include "../common/defs.hpp"
 #include "../common/halo_descriptor.hpp"
+#include "../common/thread_pool.hpp"
 #include "direction.hpp"
 #include "predicate.hpp"
 #include <boost/preprocessor/arithmetic/inc.hpp>
@@ -50,11 +51,18 @@ namespace gridtools {
             const int_t k_low = halo_descriptors[2].loop_low_bound_outside(Direction::k);
             const int_t k_high = halo_descriptors[2].loop_high_bound_outside(Direction::k);
 
+#ifdef GT_USE_THREAD_POOL
+            thread_pool::get().parallel_for(j_high - j_low + 1, k_high - k_low + 1, [&](int_t j, int_t k) {
+                for (int_t i = i_low; i <= i_high; ++i)
+                    boundary_function(Direction(), data_field..., i, j_low + j, k_low + k);
+            });
+#else
 #pragma omp parallel for simd collapse(3)
             for (int_t j = j_low; j <= j_high; ++j)
                 for (int_t k = k_low; k <= k_high; ++k)
                     for (int_t i = i_low; i <= i_high; ++i)
                         boundary_function(Direction(), data_field..., i, j, k);
+#endif
         }
 
       public:
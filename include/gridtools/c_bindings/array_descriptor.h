@@ -11,6 +11,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 
 enum gt_fortran_array_kind {
     gt_fk_Bool,
@@ -25,12 +26,23 @@ enum gt_fortran_array_kind {
 };
 typedef enum gt_fortran_array_kind gt_fortran_array_kind;
 
+/*
+ * `dims`, `strides` and `lbounds` are given in fortran order (first index first). `strides` are in units of elements;
+ * a stride of 0 means that the stride is derived from the previous dimension as if the array was contiguous, such that a
+ * zero initialized `strides` describes a contiguous array. `data` points to the element at the lower bounds. `strides`
+ * and `lbounds` are the last members, such that aggregate initializations of the other members keep working.
+ *
+ * Adding `strides` and `lbounds` changed the size of the struct. This breaks the ABI: Fortran code and C libraries that
+ * were compiled against the previous definition must be recompiled together with the generated bindings. `strides` are
+ * `ptrdiff_t`, such that strides of arrays with more than 2^31 elements do not overflow.
+ */
 struct gt_fortran_array_descriptor {
     gt_fortran_array_kind type;
     int rank;
     int dims[7];
     void *data;
     bool is_acc_present;
-    // TODO: add support for strides, bounds end type gt_fortran_array_descriptor
+    ptrdiff_t strides[7];
+    int lbounds[7];
 };
 typedef struct gt_fortran_array_descriptor gt_fortran_array_descriptor;
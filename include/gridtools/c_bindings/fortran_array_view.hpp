@@ -9,6 +9,7 @@
  */
 
 #pragma once
+#include <cstddef>
 #include <functional>
 #include <stdexcept>
 #include <string>
@@ -73,7 +74,7 @@ namespace gridtools {
             enable_if_t<std::is_array<Arr>::value && std::is_arithmetic<ElementType>::value,
                 gt_fortran_array_descriptor>
             get_fortran_view_meta(T *) {
-                gt_fortran_array_descriptor descriptor;
+                gt_fortran_array_descriptor descriptor{};
                 descriptor.type = fortran_array_element_kind<ElementType>::value;
                 descriptor.rank = std::rank<Arr>::value;
                 descriptor.is_acc_present = false;
@@ -90,7 +91,7 @@ namespace gridtools {
                             (T::gt_is_acc_present::value == T::gt_is_acc_present::value),
                 gt_fortran_array_descriptor>
             get_fortran_view_meta(T *) {
-                gt_fortran_array_descriptor descriptor;
+                gt_fortran_array_descriptor descriptor{};
                 descriptor.type = fortran_array_element_kind<typename T::gt_view_element_type>::value;
                 descriptor.rank = T::gt_view_rank::value;
                 descriptor.is_acc_present = T::gt_is_acc_present::value;
@@ -99,6 +100,31 @@ namespace gridtools {
             }
         } // namespace get_fortran_view_meta_impl
         using get_fortran_view_meta_impl::get_fortran_view_meta;
+
+        /**
+         * @brief Returns the stride (in elements) of dimension `dim` of the fortran array, resolving strides that are
+         * set to 0.
+         */
+        inline std::ptrdiff_t get_fortran_array_stride(gt_fortran_array_descriptor const &descriptor, int dim) {
+            std::ptrdiff_t res = 1;
+            for (int d = 0; d <= dim; ++d)
+                res = descriptor.strides[d] ? descriptor.strides[d] : d ? res * descriptor.dims[d - 1] : 1;
+            return res;
+        }
+
+        /**
+         * @brief Checks whether the fortran array is contiguous in memory.
+         */
+        inline bool is_fortran_array_contiguous(gt_fortran_array_descriptor const &descriptor) {
+            std::ptrdiff_t contiguous_stride = 1;
+            for (int d = 0; d < descriptor.rank; ++d) {
+                if (descriptor.dims[d] > 1 && get_fortran_array_stride(descriptor, d) != contiguous_stride)
+                    return false;
+                contiguous_stride *= descriptor.dims[d];
+            }
+            return true;
+        }
+
         /**
          * A type T is fortran_array_view_inspectable, one of the following conditions holds:
          *
@@ -200,6 +226,8 @@ namespace gridtools {
                 if (cpp_meta.dims[i] != descriptor->dims[descriptor->rank - i - 1])
                     throw std::runtime_error("Extents do not match");
             }
+            if (!is_fortran_array_contiguous(*descriptor))
+                throw std::runtime_error("Non-contiguous fortran arrays can not be converted to c-arrays");
 
             return *reinterpret_cast<remove_reference_t<T> *>(descriptor->data);
         }
@@ -191,6 +191,7 @@ namespace gridtools {
             }
 
             std::string fortran_array_element_type_name(gt_fortran_array_kind kind);
+            int fortran_array_element_size(gt_fortran_array_kind kind);
 
             struct ignore_type_f {
                 template <class T>
@@ -365,13 +366,17 @@ namespace gridtools {
                         if (meta) {
                             const auto var_name = "arg" + std::to_string(i);
                             const auto desc_name = "descriptor" + std::to_string(i);
-                            std::string c_loc = "c_loc(" + var_name + "(";
-                            for (int i = 0; i < meta->rank; ++i) {
-                                if (i)
-                                    c_loc += ",";
-                                c_loc += "lbound(" + var_name + ", " + std::to_string(i + 1) + ")";
-                            }
-                            c_loc += "))";
+                            auto element = [&](int shifted_dim) {
+                                std::string res = var_name + "(";
+                                for (int d = 0; d < meta->rank; ++d) {
+                                    if (d)
+                                        res += ",";
+                                    res += "lbound(" + var_name + ", " + std::to_string(d + 1) + ")";
+                                    if (d == shifted_dim)
+                                        res += " + 1";
+                                }
+                                return res + ")";
+                            };
                             if (meta->is_acc_present)
                                 strm << "      !$acc data present(" << var_name << ")\n" //
                                      << "      !$acc host_data use_device(" << var_name << ")\n";
@@ -380,7 +385,22 @@ namespace gridtools {
                                  << "      " << desc_name << "%type = " << meta->type << "\n"                 //
                                  << "      " << desc_name << "%dims = reshape(shape(" << var_name << "), &\n" //
                                  << "        shape(" << desc_name << "%dims), (/0/))\n"                       //
-                                 << "      " << desc_name << "%data = " << c_loc << "\n";
+                                 << "      " << desc_name << "%lbounds = reshape(lbound(" << var_name << "), &\n" //
+                                 << "        shape(" << desc_name << "%lbounds), (/0/))\n"                    //
+                                 << "      " << desc_name << "%data = c_loc(" << element(-1) << ")\n"        //
+                                 << "      " << desc_name << "%is_acc_present = "
+                                 << (meta->is_acc_present ? ".true." : ".false.") << "\n" //
+                                 << "      " << desc_name << "%strides = 0\n";
+                            // strides are measured in the wrapper, so array sections are passed without copies
+                            for (int d = 0; d < meta->rank; ++d) {
+                                const auto dim = std::to_string(d + 1);
+                                strm << "      if (size(" << var_name << ", " << dim << ") > 1) &\n" //
+                                     << "        " << desc_name << "%strides(" << dim << ") = gt_array_stride("
+                                     << desc_name << "%data, &\n"
+                                     << wrap_line("c_loc(" + element(d) + "), " +
+                                                      std::to_string(fortran_array_element_size(meta->type)) + ")",
+                                            "          ");
+                            }
                             if (meta->is_acc_present)
                                 strm << "      !$acc end host_data\n" //
                                      << "      !$acc end data\n";
@@ -114,7 +114,11 @@ namespace gridtools {
     namespace backend {
         struct cuda {};
         struct mc {};
-        struct x86 {};
+        /** The tile size of the x86 backend is a runtime property of the computation, see `set_tile_size`. */
+        struct x86 {
+            unsigned tile_i = GT_DEFAULT_TILE_I;
+            unsigned tile_j = GT_DEFAULT_TILE_J;
+        };
         struct naive {};
     } // namespace backend
 
@@ -0,0 +1,394 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "defs.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * @file
+ * Placement of the CPU threads on cores and SMT siblings.
+ *
+ * A `thread_placement` maps the threads of the CPU runtime (OpenMP or `thread_pool`) to logical cpus:
+ *  - `compact`: consecutive threads fill a core (all of its SMT siblings) before moving on to the next core,
+ *  - `scatter`: consecutive threads go to different cores, the SMT siblings are used only after every core has a
+ *    thread,
+ *  - `explicit_cpus`: a user provided list of logical cpus.
+ * With `use_smt == false` only the first hardware thread of every core is used.
+ *
+ * `set_thread_placement` pins the threads accordingly. The placement can also be selected with the environment
+ * variable `GT_PLACEMENT`, which is read on first use, e.g. `GT_PLACEMENT=compact`, `GT_PLACEMENT=scatter-nosmt` or
+ * `GT_PLACEMENT=0-7,16-23`.
+ *
+ * The block decomposition of the mc backend takes the placement into account: the blocks are handed out such that
+ * threads that are close in the topology (SMT siblings first, then cores of the same package) work on adjacent
+ * blocks and share the cached halo lines.
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace thread_placement_detail {
+            /**
+             * @brief Position of a logical cpu in the machine topology.
+             */
+            struct cpu_info {
+                int m_cpu;
+                int m_package;
+                int m_core;
+                // rank of the cpu among the hardware threads of its core
+                int m_smt;
+            };
+
+            inline bool less_compact(cpu_info const &lhs, cpu_info const &rhs) {
+                return std::tie(lhs.m_package, lhs.m_core, lhs.m_smt) < std::tie(rhs.m_package, rhs.m_core, rhs.m_smt);
+            }
+
+            inline int read_topology_value(int cpu, char const *name, int default_value) {
+                std::ostringstream path;
+                path << "/sys/devices/system/cpu/cpu" << cpu << "/topology/" << name;
+                std::ifstream file(path.str());
+                int value;
+                return file >> value ? value : default_value;
+            }
+
+            /**
+             * @brief Builds the topology from (cpu, package, core) triples; computes the SMT ranks.
+             */
+            inline std::vector<cpu_info> make_topology(std::vector<cpu_info> cpus) {
+                std::sort(cpus.begin(), cpus.end(), [](cpu_info const &lhs, cpu_info const &rhs) {
+                    return std::tie(lhs.m_package, lhs.m_core, lhs.m_cpu) <
+                           std::tie(rhs.m_package, rhs.m_core, rhs.m_cpu);
+                });
+                for (std::size_t i = 0; i < cpus.size(); ++i)
+                    cpus[i].m_smt = i > 0 && cpus[i].m_package == cpus[i - 1].m_package &&
+                                            cpus[i].m_core == cpus[i - 1].m_core
+                                        ? cpus[i - 1].m_smt + 1
+                                        : 0;
+                return cpus;
+            }
+
+            /**
+             * @brief Topology of the cpus the process may run on. Every cpu is its own core if the topology is not
+             * available.
+             */
+            inline std::vector<cpu_info> detect_topology() {
+                std::vector<cpu_info> res;
+                for (int cpu : thread_pool_detail::allowed_cpus())
+                    res.push_back({cpu,
+                        read_topology_value(cpu, "physical_package_id", 0),
+                        read_topology_value(cpu, "core_id", cpu),
+                        0});
+                return make_topology(std::move(res));
+            }
+
+            inline std::vector<cpu_info> const &topology() {
+                static const std::vector<cpu_info> instance = detect_topology();
+                return instance;
+            }
+
+            /**
+             * @brief Parses a cpu list in the format of `taskset -c`, e.g. "0-3,8,10-11".
+             */
+            inline std::vector<int> parse_cpu_list(std::string const &str) {
+                std::vector<int> res;
+                std::istringstream in(str);
+                std::string item;
+                while (std::getline(in, item, ',')) {
+                    char *end;
+                    long first = std::strtol(item.c_str(), &end, 10);
+                    long last = first;
+                    if (end != item.c_str() && *end == '-') {
+                        char const *begin = end + 1;
+                        last = std::strtol(begin, &end, 10);
+                        if (end == begin)
+                            end = nullptr;
+                    }
+                    if (item.empty() || !end || *end != '\0' || first < 0 || last < first)
+                        throw std::runtime_error("invalid cpu list '" + str + "'");
+                    for (long cpu = first; cpu <= last; ++cpu)
+                        res.push_back(cpu);
+                }
+                if (res.empty())
+                    throw std::runtime_error("invalid cpu list '" + str + "'");
+                return res;
+            }
+        } // namespace thread_placement_detail
+    }     // namespace _impl
+
+    class thread_placement {
+      public:
+        enum class kind { none, compact, scatter, explicit_cpus };
+
+      private:
+        using cpu_info = _impl::thread_placement_detail::cpu_info;
+
+        kind m_kind;
+        bool m_use_smt;
+        std::vector<int> m_cpus;
+
+        thread_placement(kind k, bool use_smt, std::vector<int> cpus)
+            : m_kind(k), m_use_smt(use_smt), m_cpus(std::move(cpus)) {}
+
+      public:
+        /**
+         * @brief No placement: the threads are not pinned and the blocks are handed out in their natural order.
+         */
+        thread_placement() : thread_placement(kind::none, true, {}) {}
+
+        static thread_placement compact(bool use_smt = true) { return {kind::compact, use_smt, {}}; }
+        static thread_placement scatter(bool use_smt = true) { return {kind::scatter, use_smt, {}}; }
+        static thread_placement explicit_cpus(std::vector<int> cpus) {
+            if (cpus.empty())
+                throw std::runtime_error("thread_placement: empty cpu list");
+            return {kind::explicit_cpus, true, std::move(cpus)};
+        }
+
+        /**
+         * @brief Parses "none", "compact", "scatter" (optionally followed by "-nosmt") or a cpu list like "0-3,8".
+         */
+        static thread_placement parse(std::string const &str) {
+            if (str.empty() || str == "none")
+                return {};
+            for (bool use_smt : {true, false}) {
+                std::string suffix = use_smt ? "" : "-nosmt";
+                if (str == "compact" + suffix)
+                    return compact(use_smt);
+                if (str == "scatter" + suffix)
+                    return scatter(use_smt);
+            }
+            return explicit_cpus(_impl::thread_placement_detail::parse_cpu_list(str));
+        }
+
+        kind get_kind() const { return m_kind; }
+        bool use_smt() const { return m_use_smt; }
+
+        std::string name() const {
+            switch (m_kind) {
+            case kind::compact:
+                return m_use_smt ? "compact" : "compact-nosmt";
+            case kind::scatter:
+                return m_use_smt ? "scatter" : "scatter-nosmt";
+            case kind::explicit_cpus: {
+                std::ostringstream res;
+                for (std::size_t i = 0; i < m_cpus.size(); ++i)
+                    res << (i ? "," : "") << m_cpus[i];
+                return res.str();
+            }
+            default:
+                return "none";
+            }
+        }
+
+        /**
+         * @brief The logical cpus in placement order for the given topology; thread `t` runs on
+         * `cpus[t % cpus.size()]`. Empty for `kind::none`.
+         */
+        std::vector<int> cpus(std::vector<cpu_info> const &topology) const {
+            if (m_kind == kind::none)
+                return {};
+            if (m_kind == kind::explicit_cpus)
+                return m_cpus;
+            std::vector<cpu_info> selected;
+            for (auto const &info : topology)
+                if (m_use_smt || info.m_smt == 0)
+                    selected.push_back(info);
+            if (m_kind == kind::compact) {
+                std::sort(selected.begin(), selected.end(), _impl::thread_placement_detail::less_compact);
+            } else {
+                // round robin over the packages, then over the cores, then over the SMT siblings
+                std::map<int, int> core_rank;
+                std::vector<std::tuple<int, int, int, int>> keys;
+                for (auto const &info : selected)
+                    keys.emplace_back(info.m_smt, core_rank[info.m_package]++, info.m_package, info.m_cpu);
+                std::sort(keys.begin(), keys.end());
+                selected.clear();
+                for (auto const &key : keys)
+                    selected.push_back({std::get<3>(key), std::get<2>(key), 0, std::get<0>(key)});
+            }
+            std::vector<int> res;
+            for (auto const &info : selected)
+                res.push_back(info.m_cpu);
+            return res;
+        }
+
+        std::vector<int> cpus() const { return cpus(_impl::thread_placement_detail::topology()); }
+    };
+
+    namespace _impl {
+        namespace thread_placement_detail {
+            /**
+             * @brief Chunk size of the OpenMP loops over the blocks, `schedule(static, chunk)` assigns the iterations
+             * [chunk * t, chunk * (t + 1)) to thread t.
+             */
+            inline int_t static_chunk(int_t n, int threads) { return n > 0 ? (n + threads - 1) / threads : 1; }
+
+            /**
+             * @brief Thread that executes iteration `iteration` of a statically scheduled loop with `n` iterations.
+             */
+            inline int owner(int iteration, int n, int threads, bool pool_schedule) {
+                if (!pool_schedule)
+                    return iteration / static_chunk(n, threads);
+                // thread_pool: thread t processes [n * t / threads, n * (t + 1) / threads)
+                return (int)(((long long)(iteration + 1) * threads - 1) / n);
+            }
+
+            /**
+             * @brief Maps the iterations of a statically scheduled loop over `blocks` blocks to block indices, such
+             * that threads which are close in the topology get adjacent blocks.
+             */
+            inline std::vector<int_t> block_order(int_t blocks,
+                int threads,
+                std::vector<int> const &cpus,
+                std::vector<cpu_info> const &topology,
+                bool pool_schedule) {
+                std::vector<cpu_info> keys;
+                for (int_t b = 0; b < blocks; ++b) {
+                    int cpu = cpus.empty() ? -1 : cpus[owner(b, blocks, threads, pool_schedule) % cpus.size()];
+                    auto it = std::find_if(
+                        topology.begin(), topology.end(), [&](cpu_info const &info) { return info.m_cpu == cpu; });
+                    keys.push_back(it == topology.end() ? cpu_info{cpu, INT_MAX, cpu, 0} : *it);
+                }
+                std::vector<int_t> iterations(blocks);
+                for (int_t b = 0; b < blocks; ++b)
+                    iterations[b] = b;
+                std::stable_sort(iterations.begin(), iterations.end(), [&](int_t lhs, int_t rhs) {
+                    return less_compact(keys[lhs], keys[rhs]);
+                });
+                std::vector<int_t> res(blocks);
+                for (int_t b = 0; b < blocks; ++b)
+                    res[iterations[b]] = b;
+                return res;
+            }
+
+            struct state {
+                std::mutex m_mutex;
+                thread_placement m_placement;
+                std::vector<int> m_cpus;
+                // cached block orders, indexed by the number of blocks
+                std::map<int_t, std::shared_ptr<const std::vector<int_t>>> m_orders;
+            };
+
+            inline state &get_state() {
+                static state instance;
+                return instance;
+            }
+
+            /**
+             * @brief Restricts the calling thread to the given cpus.
+             */
+            inline void set_affinity(std::vector<int> const &cpus) {
+#ifdef __linux__
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                for (int cpu : cpus)
+                    CPU_SET(cpu, &set);
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+            }
+
+            /**
+             * @brief Pins thread `t` of the CPU runtime to `cpus[t % cpus.size()]`, or releases all threads to the
+             * cpus of the topology if `cpus` is empty.
+             */
+            inline void pin_threads(std::vector<int> const &cpus) {
+                std::vector<int> all;
+                for (auto const &info : topology())
+                    all.push_back(info.m_cpu);
+                auto pin = [&](int num) {
+                    set_affinity(cpus.empty() ? all : std::vector<int>{cpus[num % cpus.size()]});
+                };
+#ifdef GT_USE_THREAD_POOL
+                thread_pool::get().parallel([&](int num, int) { pin(num); });
+#else
+#pragma omp parallel
+                pin(omp_get_thread_num());
+#endif
+            }
+
+            inline void apply(state &s, thread_placement const &placement) {
+                s.m_placement = placement;
+                s.m_cpus = placement.cpus();
+                s.m_orders.clear();
+                pin_threads(s.m_cpus);
+            }
+
+            inline state &get_initialized_state() {
+                state &s = get_state();
+                static const bool initialized = [&] {
+                    if (char const *env = std::getenv("GT_PLACEMENT")) {
+                        std::lock_guard<std::mutex> lock(s.m_mutex);
+                        apply(s, thread_placement::parse(env));
+                    }
+                    return true;
+                }();
+                (void)initialized;
+                return s;
+            }
+
+            /**
+             * @brief Block order for the current placement, nullptr if the blocks are processed in natural order.
+             * The order is shared with the cache of the placement, it stays valid if the placement is changed.
+             */
+            inline std::shared_ptr<const std::vector<int_t>> current_block_order(int_t blocks) {
+                state &s = get_initialized_state();
+                std::lock_guard<std::mutex> lock(s.m_mutex);
+                if (s.m_cpus.empty())
+                    return nullptr;
+                auto it = s.m_orders.find(blocks);
+                if (it == s.m_orders.end()) {
+#ifdef GT_USE_THREAD_POOL
+                    const bool pool_schedule = true;
+#else
+                    const bool pool_schedule = false;
+#endif
+                    it = s.m_orders
+                             .emplace(blocks,
+                                 std::make_shared<const std::vector<int_t>>(
+                                     block_order(blocks, host_max_threads(), s.m_cpus, topology(), pool_schedule)))
+                             .first;
+                }
+                return it->second;
+            }
+        } // namespace thread_placement_detail
+    }     // namespace _impl
+
+    /**
+     * @brief Pins the threads of the CPU runtime according to `placement`. The calling thread is pinned as well (it
+     * is thread 0 of the parallel regions); `thread_placement()` releases the threads again. Must not be called while
+     * a computation is running.
+     */
+    inline void set_thread_placement(thread_placement const &placement) {
+        auto &s = _impl::thread_placement_detail::get_initialized_state();
+        std::lock_guard<std::mutex> lock(s.m_mutex);
+        _impl::thread_placement_detail::apply(s, placement);
+    }
+
+    /**
+     * @brief The current placement; initialized from `GT_PLACEMENT` on first use.
+     */
+    inline thread_placement get_thread_placement() {
+        auto &s = _impl::thread_placement_detail::get_initialized_state();
+        std::lock_guard<std::mutex> lock(s.m_mutex);
+        return s.m_placement;
+    }
+} // namespace gridtools
@@ -0,0 +1,342 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "defs.hpp"
+
+/**
+ * @file
+ * Persistent thread pool for the CPU code paths.
+ *
+ * By default the CPU backends, the boundary conditions, the layout transformation and the halo packing open an OpenMP
+ * parallel region per call. If `GT_USE_THREAD_POOL` is defined, those code paths run on a `thread_pool` instead: its
+ * worker threads are created once and woken up per parallel region with a generation counter.
+ * Workers spin for a short while before they fall asleep, and the end of a region is a single atomic latch. The
+ * iterations of `parallel_for` are distributed statically, such that the same worker touches the same blocks (and the
+ * same memory pages) in every call.
+ *
+ * The global pool has `GT_NUM_THREADS` threads (or `omp_get_max_threads()` if that variable is not set). Its workers
+ * are pinned to fixed cores if `GT_THREAD_POOL_PIN=1` is set; they are not pinned by default, such that the pool does
+ * not override the placement of the job scheduler or of `OMP_PROC_BIND`.
+ *
+ * A pool executes a single parallel region at a time. A region that is started while the pool is busy (from within
+ * another region or from a different thread) is executed by the calling thread alone.
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace thread_pool_detail {
+            inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+
+            /**
+             * @brief Number of busy-wait iterations before a waiting thread yields or sleeps.
+             */
+            constexpr int spin_count = 1 << 14;
+
+            inline int env_int(char const *name, int default_value) {
+                char const *value = std::getenv(name);
+                return value && *value ? std::atoi(value) : default_value;
+            }
+
+            /**
+             * @brief The cores the process may run on.
+             */
+            inline std::vector<int> allowed_cpus() {
+                std::vector<int> res;
+#ifdef __linux__
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                if (sched_getaffinity(0, sizeof(set), &set) == 0)
+                    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                        if (CPU_ISSET(cpu, &set))
+                            res.push_back(cpu);
+#endif
+                return res;
+            }
+
+            /**
+             * @brief Binds the calling thread to a single core. Returns false if this is not supported.
+             */
+            inline bool pin_current_thread(int cpu) {
+#ifdef __linux__
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+                return false;
+#endif
+            }
+
+            struct thread_info {
+                int m_num;
+                int m_team_size;
+            };
+
+            inline thread_info &current_thread() {
+                thread_local thread_info info = {0, 1};
+                return info;
+            }
+
+            /**
+             * @brief Centralized spin barrier with a generation counter.
+             */
+            class spin_barrier {
+                std::atomic<int> m_count;
+                std::atomic<unsigned> m_generation;
+
+              public:
+                spin_barrier() : m_count(0), m_generation(0) {}
+
+                void wait(int size) {
+                    unsigned generation = m_generation.load(std::memory_order_acquire);
+                    if (m_count.fetch_add(1, std::memory_order_acq_rel) == size - 1) {
+                        m_count.store(0, std::memory_order_relaxed);
+                        m_generation.fetch_add(1, std::memory_order_release);
+                        return;
+                    }
+                    for (int i = 0; m_generation.load(std::memory_order_acquire) == generation; ++i)
+                        if (i < spin_count)
+                            cpu_relax();
+                        else
+                            std::this_thread::yield();
+                }
+            };
+        } // namespace thread_pool_detail
+    }     // namespace _impl
+
+    class thread_pool {
+        using job_t = void (*)(void const *, int, int);
+
+        int m_size;
+        std::vector<int> m_cpus;
+
+        std::atomic<unsigned> m_generation;
+        std::atomic<int> m_pending;
+        std::atomic<bool> m_busy;
+        bool m_stop;
+        job_t m_job;
+        void const *m_job_data;
+        std::exception_ptr m_error;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::mutex m_error_mutex;
+        _impl::thread_pool_detail::spin_barrier m_barrier;
+
+        std::vector<std::thread> m_workers;
+
+        void execute(int num) {
+            auto &current = _impl::thread_pool_detail::current_thread();
+            auto saved = current;
+            current = {num, m_size};
+            try {
+                m_job(m_job_data, num, m_size);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_error_mutex);
+                if (!m_error)
+                    m_error = std::current_exception();
+            }
+            current = saved;
+        }
+
+        void work(int num) {
+            if (!m_cpus.empty())
+                _impl::thread_pool_detail::pin_current_thread(m_cpus[num % m_cpus.size()]);
+            unsigned seen = 0;
+            while (true) {
+                for (int i = 0; i < _impl::thread_pool_detail::spin_count &&
+                                m_generation.load(std::memory_order_acquire) == seen;
+                     ++i)
+                    _impl::thread_pool_detail::cpu_relax();
+                if (m_generation.load(std::memory_order_acquire) == seen) {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_cv.wait(lock, [&] { return m_generation.load(std::memory_order_acquire) != seen; });
+                }
+                seen = m_generation.load(std::memory_order_acquire);
+                if (m_stop)
+                    return;
+                execute(num);
+                m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+
+        void start_workers() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_generation.fetch_add(1, std::memory_order_acq_rel);
+            }
+            m_cv.notify_all();
+        }
+
+        template <class F>
+        static void call_job(void const *f, int num, int size) {
+            (*static_cast<F const *>(f))(num, size);
+        }
+
+        struct busy_guard {
+            std::atomic<bool> &m_busy;
+            ~busy_guard() { m_busy.store(false, std::memory_order_release); }
+        };
+
+      public:
+        /**
+         * @param size number of threads, including the thread that starts the parallel regions
+         * @param cpus cores to pin the worker threads to (worker `i` goes to `cpus[i % cpus.size()]`), no pinning if
+         * empty. The calling thread is not pinned, it is expected to run on `cpus[0]`.
+         */
+        explicit thread_pool(int size, std::vector<int> cpus = {})
+            : m_size(std::max(size, 1)), m_cpus(std::move(cpus)), m_generation(0), m_pending(0), m_busy(false),
+              m_stop(false), m_job(nullptr), m_job_data(nullptr) {
+            for (int i = 1; i < m_size; ++i)
+                m_workers.emplace_back(&thread_pool::work, this, i);
+        }
+
+        thread_pool(thread_pool const &) = delete;
+        thread_pool &operator=(thread_pool const &) = delete;
+
+        ~thread_pool() {
+            m_stop = true;
+            start_workers();
+            for (auto &worker : m_workers)
+                worker.join();
+        }
+
+        int size() const { return m_size; }
+
+        /**
+         * @brief Calls `f(thread_num, team_size)` on every thread of the pool. The calling thread takes part as
+         * thread 0. Returns after all threads have finished; the first exception thrown by `f` is rethrown.
+         */
+        template <class F>
+        void parallel(F const &f) {
+            if (m_size == 1 || m_busy.exchange(true, std::memory_order_acq_rel)) {
+                auto &current = _impl::thread_pool_detail::current_thread();
+                auto saved = current;
+                current.m_team_size = 1;
+                try {
+                    f(0, 1);
+                } catch (...) {
+                    current = saved;
+                    throw;
+                }
+                current = saved;
+                return;
+            }
+            busy_guard guard{m_busy};
+            m_job = &call_job<F>;
+            m_job_data = &f;
+            m_error = nullptr;
+            m_pending.store(m_size - 1, std::memory_order_relaxed);
+            start_workers();
+            execute(0);
+            for (int i = 0; m_pending.load(std::memory_order_acquire) != 0; ++i)
+                if (i < _impl::thread_pool_detail::spin_count)
+                    _impl::thread_pool_detail::cpu_relax();
+                else
+                    std::this_thread::yield();
+            if (m_error)
+                std::rethrow_exception(m_error);
+        }
+
+        /**
+         * @brief Calls `f(i)` for `i` in `[0, n)`. Every thread processes one contiguous range of iterations.
+         */
+        template <class F>
+        void parallel_for(std::ptrdiff_t n, F const &f) {
+            parallel([&](int num, int size) {
+                const std::ptrdiff_t begin = n * num / size;
+                const std::ptrdiff_t end = n * (num + 1) / size;
+                for (std::ptrdiff_t i = begin; i < end; ++i)
+                    f(i);
+            });
+        }
+
+        /**
+         * @brief Calls `f(i, j)` for the collapsed iteration space `[0, n0) x [0, n1)`.
+         */
+        template <class F>
+        void parallel_for(std::ptrdiff_t n0, std::ptrdiff_t n1, F const &f) {
+            parallel_for(n0 * n1, [&](std::ptrdiff_t ij) { f(ij / n1, ij % n1); });
+        }
+
+        /**
+         * @brief Calls `f(i, j, k)` for the collapsed iteration space `[0, n0) x [0, n1) x [0, n2)`.
+         */
+        template <class F>
+        void parallel_for(std::ptrdiff_t n0, std::ptrdiff_t n1, std::ptrdiff_t n2, F const &f) {
+            parallel_for(n0 * n1 * n2, [&](std::ptrdiff_t ijk) { f(ijk / (n1 * n2), ijk / n2 % n1, ijk % n2); });
+        }
+
+        /**
+         * @brief Synchronizes all threads of the current parallel region.
+         */
+        void barrier() {
+            int team_size = _impl::thread_pool_detail::current_thread().m_team_size;
+            if (team_size > 1)
+                m_barrier.wait(team_size);
+        }
+
+        /**
+         * @brief Number of the calling thread within the current parallel region, 0 outside of parallel regions.
+         */
+        static int thread_num() { return _impl::thread_pool_detail::current_thread().m_num; }
+
+        /**
+         * @brief The pool used by the CPU code paths if `GT_USE_THREAD_POOL` is defined.
+         */
+        static thread_pool &get() {
+            static thread_pool instance(_impl::thread_pool_detail::env_int("GT_NUM_THREADS", omp_get_max_threads()),
+                _impl::thread_pool_detail::env_int("GT_THREAD_POOL_PIN", 0) ? _impl::thread_pool_detail::allowed_cpus()
+                                                                             : std::vector<int>{});
+            return instance;
+        }
+    };
+
+    /**
+     * @brief Number of the calling thread in the CPU runtime that is in use (OpenMP or `thread_pool`).
+     */
+    inline int host_thread_num() {
+#ifdef GT_USE_THREAD_POOL
+        return thread_pool::thread_num();
+#else
+        return omp_get_thread_num();
+#endif
+    }
+
+    /**
+     * @brief Maximal number of threads of the CPU runtime that is in use (OpenMP or `thread_pool`).
+     */
+    inline int host_max_threads() {
+#ifdef GT_USE_THREAD_POOL
+        return thread_pool::get().size();
+#else
+        return omp_get_max_threads();
+#endif
+    }
+} // namespace gridtools
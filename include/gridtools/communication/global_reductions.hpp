@@ -0,0 +1,105 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <tuple>
+#include <vector>
+
+#include "../stencil_composition/reductions.hpp"
+#include "./GCL.hpp"
+
+#ifdef GCL_MPI
+#include "./low_level/data_types_mapping.hpp"
+#endif
+
+/**
+ * @file
+ * Reductions of distributed data stores over the compute domains of all ranks of `GCL_WORLD`.
+ *
+ * Every rank reduces its own compute domain (see `reduce` in `stencil_composition/reductions.hpp`); the partial results
+ * are then combined across the ranks. With `reduction_order::fast`, this is a single `MPI_Allreduce` per term. The
+ * deterministic orders gather the partial results of all ranks and combine them pairwise in the order of the ranks,
+ * such that the result is reproducible for a given number of ranks and independent of the number of threads. All
+ * ranks obtain the same result. Without MPI, `global_reduce` is the local reduction.
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace global_reduction_detail {
+#ifdef GCL_MPI
+            template <class Op>
+            MPI_Op mpi_op(Op const &) {
+                return Op::is_additive ? MPI_SUM : MPI_MAX;
+            }
+
+            inline MPI_Op mpi_op(reduction::min_op const &) { return MPI_MIN; }
+
+            template <class Accumulator, class T>
+            T combine_ranks(T const *values, int n) {
+                std::vector<Accumulator> accs(n);
+                for (int rank = 0; rank != n; ++rank)
+                    accs[rank].add(values[rank]);
+                return reduction_detail::merge_pairwise(accs.data(), accs.size()).value();
+            }
+
+            template <class Term>
+            typename Term::value_t all_reduce(reduction_order order, typename Term::value_t local) {
+                using value_t = typename Term::value_t;
+                value_t res = local;
+                if (order == reduction_order::fast) {
+                    MPI_Allreduce(&local,
+                        &res,
+                        1,
+                        _impl::make_datatype<value_t>::type(),
+                        mpi_op(typename Term::op_t()),
+                        GCL_WORLD);
+                    return res;
+                }
+                int procs;
+                MPI_Comm_size(GCL_WORLD, &procs);
+                std::vector<value_t> values(procs);
+                MPI_Allgather(&local, sizeof(value_t), MPI_BYTE, values.data(), sizeof(value_t), MPI_BYTE, GCL_WORLD);
+                return order == reduction_order::pairwise
+                           ? combine_ranks<reduction_detail::plain_accumulator_t<Term>>(values.data(), procs)
+                           : combine_ranks<reduction_detail::compensated_accumulator_t<Term>>(values.data(), procs);
+            }
+#else
+            template <class Term>
+            typename Term::value_t all_reduce(reduction_order, typename Term::value_t local) {
+                return local;
+            }
+#endif
+
+            template <class... Terms, class Values, size_t... Is>
+            std::tuple<typename Terms::value_t...> all_reduce(
+                reduction_order order, Values const &local, meta::index_sequence<Is...>) {
+                return std::tuple<typename Terms::value_t...>{all_reduce<Terms>(order, std::get<Is>(local))...};
+            }
+        } // namespace global_reduction_detail
+    }     // namespace _impl
+
+    /**
+     * @brief Reduces the distributed data stores of the given reduction terms over the compute domains of all ranks.
+     *
+     * @param grid the grid of the local compute domain, which must not include points owned by other ranks
+     * @return the result of a single term, a `std::tuple` with the results of several terms, on every rank
+     */
+    template <class Grid, class... Ops, class... DataStores>
+    auto global_reduce(reduction_order order, Grid const &grid, reduction::term<Ops, DataStores> const &... terms)
+        GT_AUTO_RETURN(_impl::reduction_detail::make_result(
+            _impl::reduction_detail::finalize<reduction::term<Ops, DataStores>...>(
+                _impl::global_reduction_detail::all_reduce<reduction::term<Ops, DataStores>...>(order,
+                    _impl::reduction_detail::partial_values(order, grid, terms...),
+                    meta::index_sequence_for<DataStores...>()),
+                meta::index_sequence_for<DataStores...>())));
+
+    template <class Grid, class... Ops, class... DataStores>
+    auto global_reduce(Grid const &grid, reduction::term<Ops, DataStores> const &... terms)
+        GT_AUTO_RETURN(global_reduce(reduction_order::fast, grid, terms...));
+} // namespace gridtools
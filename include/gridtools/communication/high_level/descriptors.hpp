@@ -19,6 +19,7 @@
 
 #include "../../common/boollist.hpp"
 #include "../../common/numerics.hpp"
+#include "../../common/thread_pool.hpp"
 #include "../low_level/translate.hpp"
 #include "access.hpp"
 #include "descriptor_base.hpp"
@@ -561,33 +562,43 @@ namespace gridtools {
         struct pack_dims<3, dummy> {
             template <typename T, typename... FIELDS>
             void operator()(T &hm, const FIELDS &... _fields) const {
+#ifdef GT_USE_THREAD_POOL
+                thread_pool::get().parallel_for(3, 3, 3, [&](int_t ii, int_t jj, int_t kk) {
+                    neighbor(hm, (int)ii - 1, (int)jj - 1, (int)kk - 1, _fields...);
+                });
+#else
 #pragma omp parallel for schedule(dynamic, 1) collapse(3)
                 for (int ii = -1; ii <= 1; ++ii) {
                     for (int jj = -1; jj <= 1; ++jj) {
                         for (int kk = -1; kk <= 1; ++kk) {
-                            typedef proc_layout map_type;
-                            const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
-                            const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
-                            const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
-                            if ((ii != 0 || jj != 0 || kk != 0) &&
-                                (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                                DataType *it = &(hm.send_buffer[translate()(ii, jj, kk)][0]);
-                                hm.halo.pack_all(make_array(ii, jj, kk), it, _fields...);
-
-                                hm.m_haloexch.set_send_to_size(
-                                    hm.send_size[translate()(ii, jj, kk)] * sizeof...(_fields) * sizeof(DataType),
-                                    ii_P,
-                                    jj_P,
-                                    kk_P);
-                                hm.m_haloexch.set_receive_from_size(
-                                    hm.recv_size[translate()(ii, jj, kk)] * sizeof...(_fields) * sizeof(DataType),
-                                    ii_P,
-                                    jj_P,
-                                    kk_P);
-                            }
+                            neighbor(hm, ii, jj, kk, _fields...);
                         }
                     }
                 }
+#endif
+            }
+
+            template <typename T, typename... FIELDS>
+            void neighbor(T &hm, int ii, int jj, int kk, const FIELDS &... _fields) const {
+                typedef proc_layout map_type;
+                const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
+                const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
+                const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
+                if ((ii != 0 || jj != 0 || kk != 0) && (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
+                    DataType *it = &(hm.send_buffer[translate()(ii, jj, kk)][0]);
+                    hm.halo.pack_all(make_array(ii, jj, kk), it, _fields...);
+
+                    hm.m_haloexch.set_send_to_size(
+                        hm.send_size[translate()(ii, jj, kk)] * sizeof...(_fields) * sizeof(DataType),
+                        ii_P,
+                        jj_P,
+                        kk_P);
+                    hm.m_haloexch.set_receive_from_size(
+                        hm.recv_size[translate()(ii, jj, kk)] * sizeof...(_fields) * sizeof(DataType),
+                        ii_P,
+                        jj_P,
+                        kk_P);
+                }
             }
         };
 
@@ -598,22 +609,32 @@ namespace gridtools {
         struct unpack_dims<3, dummy> {
             template <typename T, typename... FIELDS>
             void operator()(const T &hm, const FIELDS &... _fields) const {
+#ifdef GT_USE_THREAD_POOL
+                thread_pool::get().parallel_for(3, 3, 3, [&](int_t ii, int_t jj, int_t kk) {
+                    neighbor(hm, (int)ii - 1, (int)jj - 1, (int)kk - 1, _fields...);
+                });
+#else
 #pragma omp parallel for schedule(dynamic, 1) collapse(3)
                 for (int ii = -1; ii <= 1; ++ii) {
                     for (int jj = -1; jj <= 1; ++jj) {
                         for (int kk = -1; kk <= 1; ++kk) {
-                            typedef proc_layout map_type;
-                            const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
-                            const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
-                            const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
-                            if ((ii != 0 || jj != 0 || kk != 0) &&
-                                (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                                DataType *it = &(hm.recv_buffer[translate()(ii, jj, kk)][0]);
-                                hm.halo.unpack_all(make_array(ii, jj, kk), it, _fields...);
-                            }
+                            neighbor(hm, ii, jj, kk, _fields...);
                         }
                     }
                 }
+#endif
+            }
+
+            template <typename T, typename... FIELDS>
+            void neighbor(const T &hm, int ii, int jj, int kk, const FIELDS &... _fields) const {
+                typedef proc_layout map_type;
+                const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
+                const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
+                const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
+                if ((ii != 0 || jj != 0 || kk != 0) && (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
+                    DataType *it = &(hm.recv_buffer[translate()(ii, jj, kk)][0]);
+                    hm.halo.unpack_all(make_array(ii, jj, kk), it, _fields...);
+                }
             }
         };
 
@@ -624,35 +645,39 @@ namespace gridtools {
         struct pack_vector_dims<3, dummy> {
             template <typename T>
             void operator()(T &hm, std::vector<DataType *> const &fields) const {
+#ifdef GT_USE_THREAD_POOL
+                thread_pool::get().parallel_for(3, 3, 3, [&](int_t ii, int_t jj, int_t kk) {
+                    neighbor(hm, (int)ii - 1, (int)jj - 1, (int)kk - 1, fields);
+                });
+#else
 #pragma omp parallel for schedule(dynamic, 1) collapse(3)
                 for (int ii = -1; ii <= 1; ++ii) {
                     for (int jj = -1; jj <= 1; ++jj) {
                         for (int kk = -1; kk <= 1; ++kk) {
-                            typedef proc_layout map_type;
-                            const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
-                            const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
-                            const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
-                            if ((ii != 0 || jj != 0 || kk != 0) &&
-                                (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                                DataType *it = &(hm.send_buffer[translate()(ii, jj, kk)][0]);
-                                for (size_t i = 0; i < fields.size(); ++i) {
-                                    hm.halo.pack(make_array(ii, jj, kk), fields[i], it);
-                                }
-
-                                hm.m_haloexch.set_send_to_size(
-                                    hm.send_size[translate()(ii, jj, kk)] * fields.size() * sizeof(DataType),
-                                    ii_P,
-                                    jj_P,
-                                    kk_P);
-                                hm.m_haloexch.set_receive_from_size(
-                                    hm.recv_size[translate()(ii, jj, kk)] * fields.size() * sizeof(DataType),
-                                    ii_P,
-                                    jj_P,
-                                    kk_P);
-                            }
+                            neighbor(hm, ii, jj, kk, fields);
                         }
                     }
                 }
+#endif
+            }
+
+            template <typename T>
+            void neighbor(T &hm, int ii, int jj, int kk, std::vector<DataType *> const &fields) const {
+                typedef proc_layout map_type;
+                const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
+                const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
+                const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
+                if ((ii != 0 || jj != 0 || kk != 0) && (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
+                    DataType *it = &(hm.send_buffer[translate()(ii, jj, kk)][0]);
+                    for (size_t i = 0; i < fields.size(); ++i) {
+                        hm.halo.pack(make_array(ii, jj, kk), fields[i], it);
+                    }
+
+                    hm.m_haloexch.set_send_to_size(
+                        hm.send_size[translate()(ii, jj, kk)] * fields.size() * sizeof(DataType), ii_P, jj_P, kk_P);
+                    hm.m_haloexch.set_receive_from_size(
+                        hm.recv_size[translate()(ii, jj, kk)] * fields.size() * sizeof(DataType), ii_P, jj_P, kk_P);
+                }
             }
         };
 
@@ -663,24 +688,34 @@ namespace gridtools {
         struct unpack_vector_dims<3, dummy> {
             template <typename T>
             void operator()(const T &hm, std::vector<DataType *> const &fields) const {
+#ifdef GT_USE_THREAD_POOL
+                thread_pool::get().parallel_for(3, 3, 3, [&](int_t ii, int_t jj, int_t kk) {
+                    neighbor(hm, (int)ii - 1, (int)jj - 1, (int)kk - 1, fields);
+                });
+#else
 #pragma omp parallel for schedule(dynamic, 1) collapse(3)
                 for (int ii = -1; ii <= 1; ++ii) {
                     for (int jj = -1; jj <= 1; ++jj) {
                         for (int kk = -1; kk <= 1; ++kk) {
-                            typedef proc_layout map_type;
-                            const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
-                            const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
-                            const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
-                            if ((ii != 0 || jj != 0 || kk != 0) &&
-                                (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                                DataType *it = &(hm.recv_buffer[translate()(ii, jj, kk)][0]);
-                                for (size_t i = 0; i < fields.size(); ++i) {
-                                    hm.halo.unpack(make_array(ii, jj, kk), fields[i], it);
-                                }
-                            }
+                            neighbor(hm, ii, jj, kk, fields);
                         }
                     }
                 }
+#endif
+            }
+
+            template <typename T>
+            void neighbor(const T &hm, int ii, int jj, int kk, std::vector<DataType *> const &fields) const {
+                typedef proc_layout map_type;
+                const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
+                const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
+                const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
+                if ((ii != 0 || jj != 0 || kk != 0) && (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
+                    DataType *it = &(hm.recv_buffer[translate()(ii, jj, kk)][0]);
+                    for (size_t i = 0; i < fields.size(); ++i) {
+                        hm.halo.unpack(make_array(ii, jj, kk), fields[i], it);
+                    }
+                }
             }
         };
 
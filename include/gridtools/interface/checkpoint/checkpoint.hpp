@@ -0,0 +1,312 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../common/defs.hpp"
+#include "../layout_transformation/layout_transformation.hpp"
+#include "checkpoint_format.hpp"
+#include "checkpoint_io.hpp"
+#include "compression.hpp"
+
+/**
+ * @file
+ * Streaming binary checkpoint/restart of data_stores.
+ *
+ * Fields are identified by the name of the data_store, which therefore has to be non-empty and unique within a
+ * checkpoint. The complete padded host buffer of every data_store is written, such that restarting into a data_store
+ * with the same storage_info is a plain parallel read into the buffer. Restarting into a data_store with the same
+ * sizes but a different layout, alignment or halo is supported through the layout transformation.
+ *
+ * Checkpoints written with write_compressed_checkpoint only contain the inner regions of the fields; restarting from
+ * them leaves the halos of the data_stores untouched.
+ *
+ * Example:
+ * \code
+ * write_checkpoint("step_100.gtckpt", u, v, w);
+ * ...
+ * read_checkpoint("step_100.gtckpt", u, v, w);
+ * \endcode
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace checkpoint_detail {
+            template <class DataStore>
+            char *host_ptr(DataStore const &data_store) {
+                return reinterpret_cast<char *>(data_store.get_storage_ptr()->get_cpu_ptr());
+            }
+
+            template <class DataStore>
+            checkpoint_field_info make_writable_field_info(DataStore const &data_store) {
+                auto res = make_field_info(data_store);
+                if (res.name.empty())
+                    throw std::runtime_error("checkpoint: only named data_stores can be checkpointed");
+                if (data_store.host_needs_update())
+                    throw std::runtime_error(
+                        "checkpoint: host copy of data_store '" + res.name + "' is outdated, sync it first");
+                return res;
+            }
+
+            inline void check_unique_names(std::vector<checkpoint_field_info> const &fields) {
+                std::vector<std::string> names;
+                for (auto const &field : fields)
+                    names.push_back(field.name);
+                std::sort(names.begin(), names.end());
+                auto dup = std::adjacent_find(names.begin(), names.end());
+                if (dup != names.end())
+                    throw std::runtime_error("checkpoint: duplicated field name '" + *dup + "'");
+            }
+
+            template <class... DataStores>
+            std::vector<checkpoint_field_info> make_field_infos(DataStores const &... data_stores) {
+                std::vector<checkpoint_field_info> res = {make_writable_field_info(data_stores)...};
+                check_unique_names(res);
+                return res;
+            }
+
+            /**
+             * @brief Restores `data_store` from the payload described by `src`.
+             */
+            template <class DataStore>
+            void restore(checkpoint_file const &file, checkpoint_field_info const &src, DataStore const &data_store) {
+                using data_t = typename DataStore::data_t;
+                auto dst = make_field_info(data_store);
+                if (src.kind != dst.kind || src.value_size != dst.value_size)
+                    throw std::runtime_error("checkpoint: value type mismatch for field '" + src.name + "'");
+                if (src.codec == checkpoint_codec::none && src.total_lengths != dst.total_lengths)
+                    throw std::runtime_error("checkpoint: size mismatch for field '" + src.name + "'");
+                data_t *ptr = data_store.get_storage_ptr()->get_cpu_ptr();
+                if (src.codec == checkpoint_codec::shuffle_lz || src.codec == checkpoint_codec::quantize_lz) {
+                    std::vector<char> payload(src.payload_bytes);
+                    parallel_read(file, payload.data(), payload.size(), src.payload_offset);
+                    decompress_field(payload.data(), src, ptr, dst);
+                } else if (src.codec != checkpoint_codec::none) {
+                    throw std::runtime_error("checkpoint: unknown codec of field '" + src.name + "'");
+                } else if (src.strides == dst.strides && src.padded_lengths == dst.padded_lengths) {
+                    parallel_read(file, reinterpret_cast<char *>(ptr), src.payload_bytes, src.payload_offset);
+                } else {
+                    std::vector<data_t> staging(src.payload_bytes / sizeof(data_t));
+                    parallel_read(file, reinterpret_cast<char *>(staging.data()), src.payload_bytes, src.payload_offset);
+                    interface::transform(ptr,
+                        staging.data(),
+                        std::vector<uint_t>(src.total_lengths.begin(), src.total_lengths.end()),
+                        std::vector<uint_t>(dst.strides.begin(), dst.strides.end()),
+                        std::vector<uint_t>(src.strides.begin(), src.strides.end()));
+                }
+                data_store.clone_to_device();
+            }
+
+            template <class DataStore>
+            void compress_data_store(DataStore const &data_store,
+                checkpoint_field_info &info,
+                std::vector<std::vector<char>> &payloads,
+                std::vector<checkpoint_compression_stats> &stats) {
+                std::uint64_t raw_bytes = std::uint64_t(slab_count(info)) * (info.total_lengths[0] - 2 * info.halo[0]) *
+                                          (info.total_lengths[1] - 2 * info.halo[1]) * info.value_size;
+                auto start = std::chrono::steady_clock::now();
+                payloads.push_back(compress_field(data_store.get_storage_ptr()->get_cpu_ptr(), info));
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                stats.push_back({info.name, raw_bytes, info.payload_bytes, elapsed.count()});
+            }
+        } // namespace checkpoint_detail
+    }     // namespace _impl
+
+    /**
+     * @brief Writes the given data_stores to a checkpoint file.
+     *
+     * The payloads are written directly from the host buffers of the data_stores by all OpenMP threads in parallel.
+     */
+    template <class DataStore, class... DataStores>
+    void write_checkpoint(std::string const &path, DataStore const &data_store, DataStores const &... data_stores) {
+        using namespace _impl::checkpoint_detail;
+        auto fields = make_field_infos(data_store, data_stores...);
+        std::uint64_t file_size;
+        auto header = layout_file(fields, file_size);
+        std::array<char *, sizeof...(DataStores) + 1> ptrs = {host_ptr(data_store), host_ptr(data_stores)...};
+
+        checkpoint_file file(path, checkpoint_file::mode::write);
+        file.truncate(file_size);
+        parallel_write(file, header.data(), header.size(), 0, 1);
+        for (std::size_t i = 0; i < fields.size(); ++i)
+            parallel_write(file, ptrs[i], fields[i].payload_bytes, fields[i].payload_offset);
+    }
+
+    /**
+     * @brief Writes the inner regions of the given data_stores compressed to a checkpoint file.
+     *
+     * The fields are compressed k-slab by k-slab by all OpenMP threads in parallel, directly from the host buffers of
+     * the data_stores.
+     *
+     * @return The compression statistics of every field.
+     */
+    template <class DataStore, class... DataStores>
+    std::vector<checkpoint_compression_stats> write_compressed_checkpoint(std::string const &path,
+        checkpoint_compression const &compression,
+        DataStore const &data_store,
+        DataStores const &... data_stores) {
+        using namespace _impl::checkpoint_detail;
+        auto fields = make_field_infos(data_store, data_stores...);
+        for (auto &field : fields) {
+            field.codec = compression.codec;
+            field.error_bound = compression.error_bound;
+            check_compressible(field);
+        }
+        std::vector<std::vector<char>> payloads;
+        std::vector<checkpoint_compression_stats> stats;
+        std::size_t i = 0;
+        (void)(int[]){((void)compress_data_store(data_store, fields[i++], payloads, stats), 0),
+            ((void)compress_data_store(data_stores, fields[i++], payloads, stats), 0)...};
+
+        std::uint64_t file_size;
+        auto header = layout_file(fields, file_size);
+        checkpoint_file file(path, checkpoint_file::mode::write);
+        file.truncate(file_size);
+        parallel_write(file, header.data(), header.size(), 0, 1);
+        for (i = 0; i < fields.size(); ++i)
+            parallel_write(file, payloads[i].data(), payloads[i].size(), fields[i].payload_offset);
+        return stats;
+    }
+
+    /**
+     * @brief Random access to the fields of a checkpoint file.
+     */
+    class checkpoint_reader {
+        _impl::checkpoint_detail::checkpoint_file m_file;
+        std::vector<checkpoint_field_info> m_fields;
+
+      public:
+        explicit checkpoint_reader(std::string const &path)
+            : m_file(path, _impl::checkpoint_detail::checkpoint_file::mode::read) {
+            using namespace _impl::checkpoint_detail;
+            std::vector<char> header(preamble_bytes);
+            parallel_read(m_file, header.data(), header.size(), 0, 1);
+            auto header_bytes = parse_preamble(header.data(), header.data() + header.size());
+            header.resize(header_bytes);
+            parallel_read(m_file, header.data(), header.size(), 0, 1);
+            m_fields = parse_header(header.data(), header.data() + header.size());
+        }
+
+        std::vector<checkpoint_field_info> const &fields() const { return m_fields; }
+
+        bool has_field(std::string const &name) const {
+            return std::any_of(
+                m_fields.begin(), m_fields.end(), [&](checkpoint_field_info const &f) { return f.name == name; });
+        }
+
+        checkpoint_field_info const &field(std::string const &name) const {
+            for (auto const &f : m_fields)
+                if (f.name == name)
+                    return f;
+            throw std::runtime_error("checkpoint: no field '" + name + "' in '" + m_file.path() + "'");
+        }
+
+        /**
+         * @brief Restores the field with the name of `data_store` into `data_store`.
+         */
+        template <class DataStore>
+        void read(DataStore &data_store) const {
+            _impl::checkpoint_detail::restore(m_file, field(data_store.name()), data_store);
+        }
+    };
+
+    /**
+     * @brief Restores the given data_stores from a checkpoint file, matching fields by name.
+     */
+    template <class... DataStores>
+    void read_checkpoint(std::string const &path, DataStores &... data_stores) {
+        checkpoint_reader reader(path);
+        (void)(int[]){((void)reader.read(data_stores), 0)...};
+    }
+
+    /**
+     * @brief Double-buffered asynchronous checkpoint writer.
+     *
+     * `write` takes a snapshot of the data_stores into one of two reusable staging buffers and returns as soon as the
+     * snapshot is complete; the buffer is drained to disk by a background task. The caller only blocks if both buffers
+     * are still in flight. I/O errors of a background write are rethrown by the next call that reuses its buffer, by
+     * `wait` or, as a last resort, swallowed by the destructor.
+     */
+    class async_checkpoint_writer {
+        struct slot {
+            std::vector<char> image;
+            std::future<void> pending;
+        };
+        std::array<slot, 2> m_slots;
+        std::size_t m_next = 0;
+        int m_io_threads;
+
+        static void finish(slot &s) {
+            if (s.pending.valid())
+                s.pending.get();
+        }
+
+      public:
+        /**
+         * @param io_threads Number of threads used to drain a snapshot to disk.
+         */
+        explicit async_checkpoint_writer(int io_threads = 1) : m_io_threads(io_threads) {
+            if (io_threads < 1)
+                throw std::invalid_argument("async_checkpoint_writer: io_threads must be positive");
+        }
+
+        async_checkpoint_writer(async_checkpoint_writer const &) = delete;
+        async_checkpoint_writer &operator=(async_checkpoint_writer const &) = delete;
+
+        ~async_checkpoint_writer() {
+            for (auto &s : m_slots)
+                try {
+                    finish(s);
+                } catch (...) {
+                }
+        }
+
+        template <class DataStore, class... DataStores>
+        void write(std::string const &path, DataStore const &data_store, DataStores const &... data_stores) {
+            using namespace _impl::checkpoint_detail;
+            auto fields = make_field_infos(data_store, data_stores...);
+            std::uint64_t file_size;
+            auto header = layout_file(fields, file_size);
+            std::array<char const *, sizeof...(DataStores) + 1> ptrs = {host_ptr(data_store), host_ptr(data_stores)...};
+
+            slot &s = m_slots[m_next];
+            m_next = (m_next + 1) % m_slots.size();
+            finish(s);
+
+            s.image.resize(file_size);
+            std::copy(header.begin(), header.end(), s.image.begin());
+            for (std::size_t i = 0; i < fields.size(); ++i)
+                parallel_copy(s.image.data() + fields[i].payload_offset, ptrs[i], fields[i].payload_bytes);
+
+            char const *image = s.image.data();
+            int io_threads = m_io_threads;
+            s.pending = std::async(std::launch::async, [path, image, file_size, io_threads] {
+                checkpoint_file file(path, checkpoint_file::mode::write);
+                parallel_write(file, image, file_size, 0, io_threads);
+            });
+        }
+
+        /**
+         * @brief Blocks until all pending snapshots are on disk.
+         */
+        void wait() {
+            for (auto &s : m_slots)
+                finish(s);
+        }
+    };
+} // namespace gridtools
@@ -0,0 +1,279 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../../common/defs.hpp"
+#include "../../meta/utility.hpp"
+
+/**
+ * @file
+ * Self-describing binary format of checkpoint files.
+ *
+ * A checkpoint file consists of a header followed by the raw payloads of the fields. The header starts with a fixed
+ * preamble (magic, version, byte order marker, number of fields, size of the header) followed by one record per field
+ * that contains the name, the value type, the storage_info meta data (id, alignment, layout, halo, total lengths,
+ * padded lengths, strides), the codec and the position of the payload in the file. Payloads start at page aligned
+ * offsets. Uncompressed payloads contain the complete padded buffer of a data_store, such that a storage with the same
+ * meta data can be restored without any reindexing. The layout of compressed payloads is described in compression.hpp.
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace checkpoint_detail {
+            constexpr char magic[8] = {'G', 'T', 'C', 'K', 'P', 'T', '\0', '\0'};
+            constexpr std::uint32_t version = 2;
+            constexpr std::uint32_t byte_order_marker = 0x01020304;
+            constexpr std::uint64_t payload_alignment = 4096;
+
+            inline std::uint64_t align_offset(std::uint64_t offset) {
+                return (offset + payload_alignment - 1) / payload_alignment * payload_alignment;
+            }
+
+            template <class T>
+            void put(std::vector<char> &dst, T const &value) {
+                GT_STATIC_ASSERT(std::is_trivially_copyable<T>::value, GT_INTERNAL_ERROR);
+                char const *src = reinterpret_cast<char const *>(&value);
+                dst.insert(dst.end(), src, src + sizeof(T));
+            }
+
+            inline void put(std::vector<char> &dst, std::string const &value) {
+                put(dst, static_cast<std::uint32_t>(value.size()));
+                dst.insert(dst.end(), value.begin(), value.end());
+            }
+
+            template <class T>
+            void put(std::vector<char> &dst, std::vector<T> const &values) {
+                for (auto const &value : values)
+                    put(dst, value);
+            }
+
+            class header_parser {
+                char const *m_cur;
+                char const *m_end;
+
+                void check(std::size_t bytes) const {
+                    if (m_cur + bytes > m_end)
+                        throw std::runtime_error("checkpoint: truncated header");
+                }
+
+              public:
+                header_parser(char const *begin, char const *end) : m_cur(begin), m_end(end) {}
+
+                template <class T>
+                T get() {
+                    check(sizeof(T));
+                    T res;
+                    std::memcpy(&res, m_cur, sizeof(T));
+                    m_cur += sizeof(T);
+                    return res;
+                }
+
+                std::string get_string() {
+                    auto size = get<std::uint32_t>();
+                    check(size);
+                    std::string res(m_cur, m_cur + size);
+                    m_cur += size;
+                    return res;
+                }
+
+                template <class T>
+                std::vector<T> get_vector(std::size_t size) {
+                    std::vector<T> res;
+                    res.reserve(size);
+                    for (std::size_t i = 0; i < size; ++i)
+                        res.push_back(get<T>());
+                    return res;
+                }
+            };
+        } // namespace checkpoint_detail
+    }     // namespace _impl
+
+    /**
+     * @brief Category of the value type of a checkpointed field.
+     */
+    enum class checkpoint_value_kind : std::uint32_t {
+        boolean,
+        signed_integral,
+        unsigned_integral,
+        floating_point,
+        other
+    };
+
+    /**
+     * @brief Encoding of the payload of a checkpointed field.
+     */
+    enum class checkpoint_codec : std::uint32_t {
+        none,        /**< raw padded buffer */
+        shuffle_lz,  /**< lossless, byte shuffle followed by LZ compression of the inner region */
+        quantize_lz, /**< error bounded quantization followed by LZ compression of the inner region */
+    };
+
+    template <class T>
+    constexpr checkpoint_value_kind get_checkpoint_value_kind() {
+        return std::is_same<T, bool>::value
+                   ? checkpoint_value_kind::boolean
+                   : std::is_floating_point<T>::value
+                         ? checkpoint_value_kind::floating_point
+                         : std::is_integral<T>::value ? (std::is_signed<T>::value
+                                                                ? checkpoint_value_kind::signed_integral
+                                                                : checkpoint_value_kind::unsigned_integral)
+                                                      : checkpoint_value_kind::other;
+    }
+
+    /**
+     * @brief Meta data of a single field in a checkpoint file.
+     */
+    struct checkpoint_field_info {
+        std::string name;
+        checkpoint_value_kind kind;
+        std::uint32_t value_size;
+        std::uint32_t storage_info_id;
+        std::uint32_t alignment;
+        std::vector<std::int32_t> layout;
+        std::vector<std::uint32_t> halo;
+        std::vector<std::uint32_t> total_lengths;
+        std::vector<std::uint32_t> padded_lengths;
+        std::vector<std::uint32_t> strides;
+        checkpoint_codec codec;
+        double error_bound;
+        std::uint64_t payload_offset;
+        std::uint64_t payload_bytes;
+
+        std::size_t ndims() const { return layout.size(); }
+    };
+
+    namespace _impl {
+        namespace checkpoint_detail {
+            template <class Layout, class Halo, std::size_t... Is>
+            void fill_layout_and_halo(checkpoint_field_info &info, meta::index_sequence<Is...>) {
+                info.layout = {static_cast<std::int32_t>(Layout::template at<Is>())...};
+                info.halo = {static_cast<std::uint32_t>(Halo::template at<Is>())...};
+            }
+
+            template <class DataStore>
+            checkpoint_field_info make_field_info(DataStore const &data_store) {
+                using storage_info_t = typename DataStore::storage_info_t;
+                using data_t = typename DataStore::data_t;
+                if (!data_store.valid())
+                    throw std::runtime_error("checkpoint: data_store '" + data_store.name() + "' is not valid");
+                auto const &si = data_store.info();
+                checkpoint_field_info info;
+                info.name = data_store.name();
+                info.kind = get_checkpoint_value_kind<data_t>();
+                info.value_size = sizeof(data_t);
+                info.storage_info_id = storage_info_t::id;
+                info.alignment = storage_info_t::alignment_t::value;
+                fill_layout_and_halo<typename storage_info_t::layout_t, typename storage_info_t::halo_t>(
+                    info, meta::make_index_sequence<storage_info_t::ndims>{});
+                info.total_lengths.assign(si.total_lengths().begin(), si.total_lengths().end());
+                info.padded_lengths.assign(si.padded_lengths().begin(), si.padded_lengths().end());
+                info.strides.assign(si.strides().begin(), si.strides().end());
+                info.codec = checkpoint_codec::none;
+                info.error_bound = 0;
+                info.payload_offset = 0;
+                info.payload_bytes = std::uint64_t(si.padded_total_length()) * sizeof(data_t);
+                return info;
+            }
+
+            inline std::vector<char> serialize_header(std::vector<checkpoint_field_info> const &fields) {
+                std::vector<char> res(std::begin(magic), std::end(magic));
+                put(res, version);
+                put(res, byte_order_marker);
+                put(res, static_cast<std::uint32_t>(fields.size()));
+                std::size_t header_bytes_pos = res.size();
+                put(res, std::uint64_t(0));
+                for (auto const &field : fields) {
+                    put(res, field.name);
+                    put(res, static_cast<std::uint32_t>(field.kind));
+                    put(res, field.value_size);
+                    put(res, field.storage_info_id);
+                    put(res, field.alignment);
+                    put(res, static_cast<std::uint32_t>(field.ndims()));
+                    put(res, field.layout);
+                    put(res, field.halo);
+                    put(res, field.total_lengths);
+                    put(res, field.padded_lengths);
+                    put(res, field.strides);
+                    put(res, static_cast<std::uint32_t>(field.codec));
+                    put(res, field.error_bound);
+                    put(res, field.payload_offset);
+                    put(res, field.payload_bytes);
+                }
+                std::uint64_t header_bytes = res.size();
+                std::memcpy(res.data() + header_bytes_pos, &header_bytes, sizeof(header_bytes));
+                return res;
+            }
+
+            /**
+             * @brief Assigns page aligned payload offsets to all fields and returns the serialized header together
+             * with the total file size.
+             */
+            inline std::vector<char> layout_file(std::vector<checkpoint_field_info> &fields, std::uint64_t &file_size) {
+                // offsets have a fixed size in the header, so the header size does not depend on their values
+                std::uint64_t offset = align_offset(serialize_header(fields).size());
+                for (auto &field : fields) {
+                    field.payload_offset = offset;
+                    offset = align_offset(offset + field.payload_bytes);
+                }
+                file_size = offset;
+                return serialize_header(fields);
+            }
+
+            constexpr std::size_t preamble_bytes = sizeof(magic) + 3 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+            inline std::uint64_t parse_preamble(char const *begin, char const *end) {
+                if (end - begin < (std::ptrdiff_t)preamble_bytes || std::memcmp(begin, magic, sizeof(magic)) != 0)
+                    throw std::runtime_error("checkpoint: not a GridTools checkpoint file");
+                header_parser parser(begin + sizeof(magic), end);
+                if (parser.get<std::uint32_t>() != version)
+                    throw std::runtime_error("checkpoint: unsupported format version");
+                if (parser.get<std::uint32_t>() != byte_order_marker)
+                    throw std::runtime_error("checkpoint: file was written with a different byte order");
+                parser.get<std::uint32_t>();
+                return parser.get<std::uint64_t>();
+            }
+
+            inline std::vector<checkpoint_field_info> parse_header(char const *begin, char const *end) {
+                parse_preamble(begin, end);
+                header_parser parser(begin + sizeof(magic), end);
+                parser.get<std::uint32_t>();
+                parser.get<std::uint32_t>();
+                auto n_fields = parser.get<std::uint32_t>();
+                parser.get<std::uint64_t>();
+                std::vector<checkpoint_field_info> res(n_fields);
+                for (auto &field : res) {
+                    field.name = parser.get_string();
+                    field.kind = static_cast<checkpoint_value_kind>(parser.get<std::uint32_t>());
+                    field.value_size = parser.get<std::uint32_t>();
+                    field.storage_info_id = parser.get<std::uint32_t>();
+                    field.alignment = parser.get<std::uint32_t>();
+                    auto ndims = parser.get<std::uint32_t>();
+                    field.layout = parser.get_vector<std::int32_t>(ndims);
+                    field.halo = parser.get_vector<std::uint32_t>(ndims);
+                    field.total_lengths = parser.get_vector<std::uint32_t>(ndims);
+                    field.padded_lengths = parser.get_vector<std::uint32_t>(ndims);
+                    field.strides = parser.get_vector<std::uint32_t>(ndims);
+                    field.codec = static_cast<checkpoint_codec>(parser.get<std::uint32_t>());
+                    field.error_bound = parser.get<double>();
+                    field.payload_offset = parser.get<std::uint64_t>();
+                    field.payload_bytes = parser.get<std::uint64_t>();
+                }
+                return res;
+            }
+        } // namespace checkpoint_detail
+    }     // namespace _impl
+} // namespace gridtools
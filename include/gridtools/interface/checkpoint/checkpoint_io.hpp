@@ -0,0 +1,165 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../common/defs.hpp"
+
+/**
+ * @file
+ * Chunked parallel file I/O used by the checkpoint module. Every OpenMP thread transfers whole chunks with
+ * positioned reads/writes, such that no file offset is shared between threads.
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace checkpoint_detail {
+            /**
+             * @brief Default number of bytes transferred by a single pwrite/pread call.
+             */
+            constexpr std::uint64_t default_chunk_bytes = 4 << 20;
+
+            /**
+             * @brief RAII wrapper of a POSIX file descriptor.
+             */
+            class checkpoint_file {
+                int m_fd;
+                std::string m_path;
+
+              public:
+                enum class mode { read, write };
+
+                checkpoint_file(std::string const &path, mode m) : m_path(path) {
+                    m_fd = m == mode::read ? ::open(path.c_str(), O_RDONLY)
+                                           : ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                    if (m_fd < 0)
+                        throw std::runtime_error(
+                            "checkpoint: can not open '" + path + "': " + std::string(std::strerror(errno)));
+                }
+
+                checkpoint_file(checkpoint_file const &) = delete;
+                checkpoint_file &operator=(checkpoint_file const &) = delete;
+
+                ~checkpoint_file() { ::close(m_fd); }
+
+                int fd() const { return m_fd; }
+                std::string const &path() const { return m_path; }
+
+                /**
+                 * @brief Sets the file size, such that chunks can be written in any order.
+                 */
+                void truncate(std::uint64_t size) const {
+                    if (::ftruncate(m_fd, (off_t)size) != 0)
+                        throw std::runtime_error(
+                            "checkpoint: can not resize '" + m_path + "': " + std::string(std::strerror(errno)));
+                }
+            };
+
+            template <class Transfer>
+            bool transfer_chunk(Transfer transfer, char *buf, std::uint64_t bytes, std::uint64_t offset) {
+                while (bytes > 0) {
+                    auto res = transfer(buf, bytes, offset);
+                    if (res < 0 && errno == EINTR)
+                        continue;
+                    if (res <= 0)
+                        return false;
+                    buf += res;
+                    bytes -= res;
+                    offset += res;
+                }
+                return true;
+            }
+
+            template <class Transfer>
+            void parallel_transfer(checkpoint_file const &file,
+                Transfer transfer,
+                char *buf,
+                std::uint64_t bytes,
+                std::uint64_t offset,
+                int threads,
+                std::uint64_t chunk_bytes) {
+                const std::int64_t n_chunks = (bytes + chunk_bytes - 1) / chunk_bytes;
+                std::atomic<bool> failed(false);
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+                for (std::int64_t c = 0; c < n_chunks; ++c) {
+                    const std::uint64_t begin = c * chunk_bytes;
+                    const std::uint64_t size = begin + chunk_bytes > bytes ? bytes - begin : chunk_bytes;
+                    if (!failed.load(std::memory_order_relaxed) &&
+                        !transfer_chunk(transfer, buf + begin, size, offset + begin))
+                        failed = true;
+                }
+                if (failed)
+                    throw std::runtime_error("checkpoint: I/O error on '" + file.path() + "'");
+            }
+
+            /**
+             * @brief Writes `bytes` bytes from `buf` to the file at position `offset`.
+             */
+            inline void parallel_write(checkpoint_file const &file,
+                char const *buf,
+                std::uint64_t bytes,
+                std::uint64_t offset,
+                int threads = omp_get_max_threads(),
+                std::uint64_t chunk_bytes = default_chunk_bytes) {
+                int fd = file.fd();
+                parallel_transfer(file,
+                    [fd](char *b, std::uint64_t n, std::uint64_t o) { return ::pwrite(fd, b, n, (off_t)o); },
+                    const_cast<char *>(buf),
+                    bytes,
+                    offset,
+                    threads,
+                    chunk_bytes);
+            }
+
+            /**
+             * @brief Reads `bytes` bytes at position `offset` of the file into `buf`.
+             */
+            inline void parallel_read(checkpoint_file const &file,
+                char *buf,
+                std::uint64_t bytes,
+                std::uint64_t offset,
+                int threads = omp_get_max_threads(),
+                std::uint64_t chunk_bytes = default_chunk_bytes) {
+                int fd = file.fd();
+                parallel_transfer(file,
+                    [fd](char *b, std::uint64_t n, std::uint64_t o) { return ::pread(fd, b, n, (off_t)o); },
+                    buf,
+                    bytes,
+                    offset,
+                    threads,
+                    chunk_bytes);
+            }
+
+            /**
+             * @brief Parallel memcpy, used for staging snapshots of data stores.
+             */
+            inline void parallel_copy(
+                char *dst, char const *src, std::uint64_t bytes, std::uint64_t chunk_bytes = default_chunk_bytes) {
+                const std::int64_t n_chunks = (bytes + chunk_bytes - 1) / chunk_bytes;
+#pragma omp parallel for
+                for (std::int64_t c = 0; c < n_chunks; ++c) {
+                    const std::uint64_t begin = c * chunk_bytes;
+                    const std::uint64_t size = begin + chunk_bytes > bytes ? bytes - begin : chunk_bytes;
+                    std::memcpy(dst + begin, src + begin, size);
+                }
+            }
+        } // namespace checkpoint_detail
+    }     // namespace _impl
+} // namespace gridtools
@@ -0,0 +1,454 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../common/defs.hpp"
+#include "checkpoint_format.hpp"
+
+/**
+ * @file
+ * Codecs for compressed checkpoints.
+ *
+ * Compressed fields only contain the inner region of a data_store (the halos are skipped) and are split into k-slabs
+ * which are compressed independently and in parallel. The payload of a compressed field is a table with the size of
+ * every slab followed by the slabs. Every slab starts with the size of its uncompressed byte stream followed by the
+ * LZ compressed byte stream.
+ *
+ * - checkpoint_codec::shuffle_lz: the byte stream of a slab contains the values with their bytes shuffled (first all
+ *   first bytes, then all second bytes, ...) which makes the LZ stage efficient on floating point data.
+ * - checkpoint_codec::quantize_lz: the values are quantized to multiples of 2 * error_bound and the differences between
+ *   consecutive quantized values are stored as variable length integers. Values which can not be represented within
+ *   the error bound (e.g. infinities or NaNs) are stored verbatim.
+ *
+ * The LZ stage is a byte oriented LZ77 variant similar to LZ4.
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace checkpoint_detail {
+            [[noreturn]] inline void corrupted() {
+                throw std::runtime_error("checkpoint: corrupted compressed data");
+            }
+
+            constexpr std::size_t lz_min_match = 4;
+            constexpr std::size_t lz_max_offset = 65535;
+            constexpr int lz_hash_bits = 14;
+
+            inline void lz_put_length(std::vector<unsigned char> &out, std::size_t len) {
+                for (; len >= 255; len -= 255)
+                    out.push_back(255);
+                out.push_back(static_cast<unsigned char>(len));
+            }
+
+            /**
+             * @brief Appends the LZ compressed representation of `src` to `out`.
+             *
+             * The stream is a sequence of (token, literals, offset, match length) records; the last record only
+             * contains literals.
+             */
+            inline void lz_compress(unsigned char const *src, std::size_t n, std::vector<unsigned char> &out) {
+                std::vector<std::uint32_t> table(std::size_t(1) << lz_hash_bits, 0);
+                std::size_t anchor = 0;
+                auto emit = [&](std::size_t literals_end, std::size_t match_len, std::size_t offset) {
+                    std::size_t lit = literals_end - anchor;
+                    std::size_t ml = match_len ? match_len - lz_min_match : 0;
+                    out.push_back(static_cast<unsigned char>((std::min<std::size_t>(lit, 15) << 4) |
+                                                             std::min<std::size_t>(ml, 15)));
+                    if (lit >= 15)
+                        lz_put_length(out, lit - 15);
+                    out.insert(out.end(), src + anchor, src + literals_end);
+                    if (match_len) {
+                        out.push_back(static_cast<unsigned char>(offset & 0xff));
+                        out.push_back(static_cast<unsigned char>(offset >> 8));
+                        if (ml >= 15)
+                            lz_put_length(out, ml - 15);
+                    }
+                };
+                std::size_t pos = 0;
+                while (pos + lz_min_match <= n) {
+                    std::uint32_t seq;
+                    std::memcpy(&seq, src + pos, sizeof(seq));
+                    std::size_t h = (seq * 2654435761u) >> (32 - lz_hash_bits);
+                    std::size_t candidate = table[h];
+                    table[h] = static_cast<std::uint32_t>(pos);
+                    if (candidate < pos && pos - candidate <= lz_max_offset &&
+                        std::memcmp(src + candidate, src + pos, lz_min_match) == 0) {
+                        std::size_t len = lz_min_match;
+                        while (pos + len < n && src[candidate + len] == src[pos + len])
+                            ++len;
+                        emit(pos, len, pos - candidate);
+                        pos += len;
+                        anchor = pos;
+                    } else {
+                        ++pos;
+                    }
+                }
+                emit(n, 0, 0);
+            }
+
+            /**
+             * @brief Decompresses `n` bytes of LZ compressed data into exactly `dst_n` bytes at `dst`.
+             */
+            inline void lz_decompress(unsigned char const *src, std::size_t n, unsigned char *dst, std::size_t dst_n) {
+                std::size_t ip = 0, op = 0;
+                auto get_length = [&](std::size_t len) {
+                    unsigned char b;
+                    do {
+                        if (ip >= n)
+                            corrupted();
+                        b = src[ip++];
+                        len += b;
+                    } while (b == 255);
+                    return len;
+                };
+                while (true) {
+                    if (ip >= n)
+                        corrupted();
+                    unsigned char token = src[ip++];
+                    std::size_t lit = token >> 4;
+                    if (lit == 15)
+                        lit = get_length(lit);
+                    if (lit > n - ip || lit > dst_n - op)
+                        corrupted();
+                    std::memcpy(dst + op, src + ip, lit);
+                    ip += lit;
+                    op += lit;
+                    if (op == dst_n)
+                        break;
+                    if (n - ip < 2)
+                        corrupted();
+                    std::size_t offset = src[ip] | (std::size_t(src[ip + 1]) << 8);
+                    ip += 2;
+                    std::size_t len = token & 15;
+                    if (len == 15)
+                        len = get_length(len);
+                    len += lz_min_match;
+                    if (offset == 0 || offset > op || len > dst_n - op)
+                        corrupted();
+                    // the regions may overlap, so copy byte by byte
+                    for (std::size_t end = op + len; op != end; ++op)
+                        dst[op] = dst[op - offset];
+                }
+            }
+
+            inline void put_varint(std::vector<unsigned char> &out, std::uint64_t value) {
+                for (; value >= 0x80; value >>= 7)
+                    out.push_back(static_cast<unsigned char>(value | 0x80));
+                out.push_back(static_cast<unsigned char>(value));
+            }
+
+            inline std::uint64_t get_varint(unsigned char const *&cur, unsigned char const *end) {
+                std::uint64_t res = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    if (cur == end)
+                        corrupted();
+                    unsigned char b = *cur++;
+                    res |= std::uint64_t(b & 0x7f) << shift;
+                    if (!(b & 0x80))
+                        return res;
+                }
+                corrupted();
+            }
+
+            /**
+             * @brief Strided view of the inner region of one k-slab of a 3D field.
+             */
+            template <class T>
+            struct slab_view {
+                T *origin;
+                std::uint64_t ni, nj, stride_i, stride_j;
+
+                T &operator()(std::uint64_t i, std::uint64_t j) const { return origin[i * stride_i + j * stride_j]; }
+            };
+
+            template <class T>
+            void encode_shuffle(slab_view<T const> const &slab, std::vector<unsigned char> &stream) {
+                const std::uint64_t n = slab.ni * slab.nj;
+                stream.resize(n * sizeof(T));
+                std::uint64_t idx = 0;
+                for (std::uint64_t j = 0; j < slab.nj; ++j)
+                    for (std::uint64_t i = 0; i < slab.ni; ++i, ++idx) {
+                        unsigned char bytes[sizeof(T)];
+                        std::memcpy(bytes, &slab(i, j), sizeof(T));
+                        for (std::size_t b = 0; b < sizeof(T); ++b)
+                            stream[b * n + idx] = bytes[b];
+                    }
+            }
+
+            template <class T>
+            void decode_shuffle(unsigned char const *stream, std::uint64_t bytes, slab_view<T> const &slab) {
+                const std::uint64_t n = slab.ni * slab.nj;
+                if (bytes != n * sizeof(T))
+                    corrupted();
+                std::uint64_t idx = 0;
+                for (std::uint64_t j = 0; j < slab.nj; ++j)
+                    for (std::uint64_t i = 0; i < slab.ni; ++i, ++idx) {
+                        unsigned char bytes[sizeof(T)];
+                        for (std::size_t b = 0; b < sizeof(T); ++b)
+                            bytes[b] = stream[b * n + idx];
+                        std::memcpy(&slab(i, j), bytes, sizeof(T));
+                    }
+            }
+
+            /**
+             * @brief Quantizer of the error bounded codec; `reconstruct` is used by both encoder and decoder to
+             * guarantee that the bound holds for the decoded values.
+             */
+            template <class T>
+            struct quantizer {
+                double step;
+
+                explicit quantizer(double error_bound) : step(2 * error_bound) {}
+
+                T reconstruct(std::int64_t q) const { return static_cast<T>(q * step); }
+
+                bool quantize(T value, double error_bound, std::int64_t &q) const {
+                    double scaled = std::round(static_cast<double>(value) / step);
+                    // also rejects NaNs and infinities
+                    if (!(std::abs(scaled) < 9.0e15))
+                        return false;
+                    q = static_cast<std::int64_t>(scaled);
+                    return std::abs(static_cast<double>(reconstruct(q)) - static_cast<double>(value)) <= error_bound;
+                }
+            };
+
+            inline std::uint64_t zigzag(std::int64_t v) { return (std::uint64_t(v) << 1) ^ std::uint64_t(v >> 63); }
+            inline std::int64_t unzigzag(std::uint64_t v) { return std::int64_t(v >> 1) ^ -std::int64_t(v & 1); }
+
+            template <class T>
+            void encode_quantize(
+                slab_view<T const> const &slab, double error_bound, std::vector<unsigned char> &stream) {
+                quantizer<T> quant(error_bound);
+                std::int64_t prev = 0;
+                stream.clear();
+                for (std::uint64_t j = 0; j < slab.nj; ++j)
+                    for (std::uint64_t i = 0; i < slab.ni; ++i) {
+                        T value = slab(i, j);
+                        std::int64_t q;
+                        if (quant.quantize(value, error_bound, q)) {
+                            // 0 is reserved as escape marker
+                            put_varint(stream, zigzag(q - prev) + 1);
+                            prev = q;
+                        } else {
+                            stream.push_back(0);
+                            unsigned char const *bytes = reinterpret_cast<unsigned char const *>(&value);
+                            stream.insert(stream.end(), bytes, bytes + sizeof(T));
+                        }
+                    }
+            }
+
+            template <class T>
+            void decode_quantize(
+                unsigned char const *stream, std::uint64_t bytes, double error_bound, slab_view<T> const &slab) {
+                quantizer<T> quant(error_bound);
+                unsigned char const *cur = stream;
+                unsigned char const *end = stream + bytes;
+                std::int64_t prev = 0;
+                for (std::uint64_t j = 0; j < slab.nj; ++j)
+                    for (std::uint64_t i = 0; i < slab.ni; ++i) {
+                        std::uint64_t code = get_varint(cur, end);
+                        if (code == 0) {
+                            if (std::uint64_t(end - cur) < sizeof(T))
+                                corrupted();
+                            std::memcpy(&slab(i, j), cur, sizeof(T));
+                            cur += sizeof(T);
+                        } else {
+                            prev += unzigzag(code - 1);
+                            slab(i, j) = quant.reconstruct(prev);
+                        }
+                    }
+                if (cur != end)
+                    corrupted();
+            }
+
+            template <class T>
+            void compress_slab(slab_view<T const> const &slab,
+                checkpoint_codec codec,
+                double error_bound,
+                std::vector<unsigned char> &stream,
+                std::vector<unsigned char> &out) {
+                if (codec == checkpoint_codec::shuffle_lz)
+                    encode_shuffle(slab, stream);
+                else
+                    encode_quantize(slab, error_bound, stream);
+                out.clear();
+                std::uint64_t stream_bytes = stream.size();
+                unsigned char const *size_bytes = reinterpret_cast<unsigned char const *>(&stream_bytes);
+                out.insert(out.end(), size_bytes, size_bytes + sizeof(stream_bytes));
+                lz_compress(stream.data(), stream.size(), out);
+            }
+
+            template <class T>
+            void decompress_slab(unsigned char const *src,
+                std::uint64_t n,
+                checkpoint_codec codec,
+                double error_bound,
+                std::vector<unsigned char> &stream,
+                slab_view<T> const &slab) {
+                std::uint64_t stream_bytes;
+                if (n < sizeof(stream_bytes))
+                    corrupted();
+                std::memcpy(&stream_bytes, src, sizeof(stream_bytes));
+                // every LZ output byte needs at least 1/255 input byte, this bounds the allocation
+                if (stream_bytes / 255 > n)
+                    corrupted();
+                stream.resize(stream_bytes);
+                lz_decompress(src + sizeof(stream_bytes), n - sizeof(stream_bytes), stream.data(), stream_bytes);
+                if (codec == checkpoint_codec::shuffle_lz)
+                    decode_shuffle(stream.data(), stream_bytes, slab);
+                else
+                    decode_quantize(stream.data(), stream_bytes, error_bound, slab);
+            }
+
+            template <class T>
+            slab_view<T> make_slab_view(T *ptr, checkpoint_field_info const &info, std::uint64_t k) {
+                return {ptr + info.halo[0] * info.strides[0] + info.halo[1] * info.strides[1] +
+                            (info.halo[2] + k) * info.strides[2],
+                    info.total_lengths[0] - 2 * info.halo[0],
+                    info.total_lengths[1] - 2 * info.halo[1],
+                    info.strides[0],
+                    info.strides[1]};
+            }
+
+            inline std::uint64_t slab_count(checkpoint_field_info const &info) {
+                return info.total_lengths[2] - 2 * info.halo[2];
+            }
+
+            inline void check_compressible(checkpoint_field_info const &info) {
+                if (info.ndims() != 3)
+                    throw std::runtime_error("checkpoint: only 3D fields can be compressed ('" + info.name + "')");
+                for (std::size_t d = 0; d < 3; ++d)
+                    if (info.total_lengths[d] < 2 * info.halo[d])
+                        throw std::runtime_error("checkpoint: halo exceeds the size of field '" + info.name + "'");
+                if (info.codec == checkpoint_codec::quantize_lz &&
+                    (info.kind != checkpoint_value_kind::floating_point || !(info.error_bound > 0)))
+                    throw std::runtime_error("checkpoint: error bounded compression of field '" + info.name +
+                                             "' requires a floating point type and a positive error bound");
+            }
+
+            /**
+             * @brief Compresses the inner region of the field at `ptr`, k-slab by k-slab in parallel.
+             *
+             * Returns the payload and sets info.payload_bytes accordingly.
+             */
+            template <class T>
+            std::vector<char> compress_field(T const *ptr, checkpoint_field_info &info) {
+                check_compressible(info);
+                const std::int64_t n_slabs = slab_count(info);
+                std::vector<std::vector<unsigned char>> slabs(n_slabs);
+#pragma omp parallel
+                {
+                    std::vector<unsigned char> stream;
+#pragma omp for schedule(dynamic)
+                    for (std::int64_t k = 0; k < n_slabs; ++k)
+                        compress_slab(make_slab_view(ptr, info, k), info.codec, info.error_bound, stream, slabs[k]);
+                }
+                std::vector<std::uint64_t> offsets(n_slabs + 1, n_slabs * sizeof(std::uint64_t));
+                for (std::int64_t k = 0; k < n_slabs; ++k)
+                    offsets[k + 1] = offsets[k] + slabs[k].size();
+                std::vector<char> res(offsets[n_slabs]);
+                for (std::int64_t k = 0; k < n_slabs; ++k) {
+                    std::uint64_t size = slabs[k].size();
+                    std::memcpy(res.data() + k * sizeof(size), &size, sizeof(size));
+                }
+#pragma omp parallel for
+                for (std::int64_t k = 0; k < n_slabs; ++k)
+                    std::memcpy(res.data() + offsets[k], slabs[k].data(), slabs[k].size());
+                info.payload_bytes = res.size();
+                return res;
+            }
+
+            /**
+             * @brief Decompresses a payload produced by compress_field into the inner region of a field with the meta
+             * data `dst` at `ptr`.
+             */
+            template <class T>
+            void decompress_field(
+                char const *payload, checkpoint_field_info const &src, T *ptr, checkpoint_field_info const &dst) {
+                check_compressible(src);
+                for (std::size_t d = 0; d < 3; ++d)
+                    if (src.total_lengths[d] - 2 * src.halo[d] != dst.total_lengths[d] - 2 * dst.halo[d])
+                        throw std::runtime_error("checkpoint: size mismatch for field '" + src.name + "'");
+                const std::int64_t n_slabs = slab_count(src);
+                if (src.payload_bytes < n_slabs * sizeof(std::uint64_t))
+                    corrupted();
+                std::vector<std::uint64_t> offsets(n_slabs + 1, n_slabs * sizeof(std::uint64_t));
+                for (std::int64_t k = 0; k < n_slabs; ++k) {
+                    std::uint64_t size;
+                    std::memcpy(&size, payload + k * sizeof(size), sizeof(size));
+                    if (size > src.payload_bytes - offsets[k])
+                        corrupted();
+                    offsets[k + 1] = offsets[k] + size;
+                }
+                bool failed = false;
+#pragma omp parallel
+                {
+                    std::vector<unsigned char> stream;
+#pragma omp for schedule(dynamic)
+                    for (std::int64_t k = 0; k < n_slabs; ++k) {
+                        try {
+                            decompress_slab(reinterpret_cast<unsigned char const *>(payload + offsets[k]),
+                                offsets[k + 1] - offsets[k],
+                                src.codec,
+                                src.error_bound,
+                                stream,
+                                make_slab_view(ptr, dst, k));
+                        } catch (std::runtime_error const &) {
+#pragma omp atomic write
+                            failed = true;
+                        }
+                    }
+                }
+                if (failed)
+                    corrupted();
+            }
+        } // namespace checkpoint_detail
+    }     // namespace _impl
+
+    /**
+     * @brief Options of compressed checkpoints.
+     */
+    struct checkpoint_compression {
+        checkpoint_codec codec = checkpoint_codec::shuffle_lz;
+        /** Maximal absolute error of checkpoint_codec::quantize_lz. */
+        double error_bound = 0;
+
+        static checkpoint_compression lossless() { return {}; }
+        static checkpoint_compression error_bounded(double error_bound) {
+            checkpoint_compression res;
+            res.codec = checkpoint_codec::quantize_lz;
+            res.error_bound = error_bound;
+            return res;
+        }
+    };
+
+    /**
+     * @brief Compression statistics of a single field.
+     */
+    struct checkpoint_compression_stats {
+        std::string name;
+        std::uint64_t raw_bytes;
+        std::uint64_t compressed_bytes;
+        double seconds;
+
+        double ratio() const { return compressed_bytes ? double(raw_bytes) / compressed_bytes : 0; }
+        double gb_per_second() const { return seconds > 0 ? raw_bytes / seconds * 1e-9 : 0; }
+    };
+} // namespace gridtools
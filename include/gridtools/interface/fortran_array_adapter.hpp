@@ -9,8 +9,15 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
 #include "../c_bindings/fortran_array_view.hpp"
 #include "../storage/common/storage_info_rt.hpp"
+#include "../storage/storage_facility.hpp"
 #include "./layout_transformation/layout_transformation.hpp"
 
 namespace gridtools {
@@ -30,6 +37,56 @@ namespace gridtools {
         fortran_array_adapter(const fortran_array_adapter &) = delete;
         fortran_array_adapter(fortran_array_adapter &&other) = default;
 
+        /**
+         * @brief Checks whether the fortran array can be used as the memory of a DataStore without copying, i.e.
+         * whether the strides of the fortran array are compatible with the layout and the alignment of StorageInfo.
+         */
+        bool is_adoptable() const {
+            using element_t = typename DataStore::data_t;
+            using alignment_t = typename StorageInfo::alignment_t;
+            if (!m_descriptor.data || m_descriptor.is_acc_present ||
+                m_descriptor.type != c_bindings::fortran_array_element_kind<element_t>::value)
+                return false;
+            auto dims = fortran_dims();
+            auto strides = fortran_strides();
+            // the storage_info requires unit stride in the innermost dimension
+            uint_t min_stride = std::numeric_limits<uint_t>::max();
+            for (uint_t d = 0; d < Layout::masked_length; ++d)
+                if (Layout::at(d) >= 0 && dims[d] > 1)
+                    min_stride = std::min(min_stride, strides[d]);
+            if (min_stride != 1 && min_stride != std::numeric_limits<uint_t>::max())
+                return false;
+            for (uint_t a = 0; a < Layout::masked_length; ++a)
+                for (uint_t b = 0; b < Layout::masked_length; ++b)
+                    if (Layout::at(a) >= 0 && Layout::at(b) >= 0 && dims[a] > 1 && dims[b] > 1 &&
+                        (Layout::at(a) > Layout::at(b)) != (strides[a] < strides[b]))
+                        return false;
+            if (alignment_t::value > 1) {
+                if (reinterpret_cast<std::uintptr_t>(m_descriptor.data) % (alignment_t::value * sizeof(element_t)))
+                    return false;
+                for (uint_t d = 0; d < Layout::masked_length; ++d)
+                    if (strides[d] > 1 && strides[d] % alignment_t::value)
+                        return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Creates a DataStore which aliases the memory of the fortran array (ownership::external_cpu).
+         *
+         * No data is copied, the fortran array has to outlive the returned DataStore. Throws if the fortran array is
+         * not adoptable, see is_adoptable().
+         */
+        DataStore adopt(std::string const &name = "") const {
+            if (!is_adoptable())
+                throw std::runtime_error("fortran array can not be adopted by the data_store (type, strides or "
+                                         "alignment do not match)");
+            return DataStore(StorageInfo(fortran_dims(), fortran_strides()),
+                static_cast<typename DataStore::data_t *>(m_descriptor.data),
+                ownership::external_cpu,
+                name);
+        }
+
         using gt_view_rank = std::integral_constant<size_t, Layout::unmasked_length>;
         using gt_view_element_type = typename DataStore::data_t;
         using gt_is_acc_present = bool_constant<true>;
@@ -42,6 +99,28 @@ namespace gridtools {
         }
 
       private:
+        array<uint_t, Layout::masked_length> fortran_dims() const {
+            array<uint_t, Layout::masked_length> res;
+            for (uint_t c_dim = 0, fortran_dim = 0; c_dim < Layout::masked_length; ++c_dim)
+                res[c_dim] = Layout::at(c_dim) >= 0 ? m_descriptor.dims[fortran_dim++] : 1;
+            return res;
+        }
+
+        array<uint_t, Layout::masked_length> fortran_strides() const {
+            array<uint_t, Layout::masked_length> res;
+            for (uint_t c_dim = 0, fortran_dim = 0; c_dim < Layout::masked_length; ++c_dim) {
+                if (Layout::at(c_dim) >= 0) {
+                    std::ptrdiff_t stride = c_bindings::get_fortran_array_stride(m_descriptor, fortran_dim++);
+                    if (stride < 0)
+                        throw std::runtime_error("fortran arrays with negative strides are not supported");
+                    res[c_dim] = stride;
+                } else {
+                    res[c_dim] = 0;
+                }
+            }
+            return res;
+        }
+
         class adapter {
             using ElementType = typename DataStore::data_t;
 
@@ -77,21 +156,21 @@ namespace gridtools {
                     }
                 }
 
-                uint_t current_stride = 1;
-                for (uint_t i = 0; i < Layout::masked_length; ++i) {
-                    if (Layout::at(i) >= 0) {
-                        m_fortran_strides.push_back(current_stride);
-                        current_stride *= m_dims[i];
-                    } else {
-                        m_fortran_strides.push_back(0);
-                    }
-                }
+                auto fortran_strides = view.fortran_strides();
+                m_fortran_strides.assign(fortran_strides.begin(), fortran_strides.end());
             }
 
+            // nothing to do if the data_store aliases the fortran array, see fortran_array_adapter::adopt
+            bool is_alias() const { return m_cpp_pointer == m_fortran_pointer && m_cpp_strides == m_fortran_strides; }
+
             void from_array() const {
+                if (is_alias())
+                    return;
                 interface::transform(m_cpp_pointer, m_fortran_pointer, m_dims, m_cpp_strides, m_fortran_strides);
             }
             void to_array() const {
+                if (is_alias())
+                    return;
                 interface::transform(m_fortran_pointer, m_cpp_pointer, m_dims, m_fortran_strides, m_cpp_strides);
             }
 
@@ -12,4 +12,8 @@
 
 namespace gridtools {
     constexpr static int GT_TRANSFORM_MAX_DIM = 5;
+    /** edge length of the square tiles used for transposing layout transformations on the host */
+    constexpr static int GT_TRANSFORM_TILE_SIZE = 32;
+    /** number of elements copied by one work item of non-transposing layout transformations on the host */
+    constexpr static int GT_TRANSFORM_LINEAR_CHUNK = 1024;
 }
@@ -10,19 +10,144 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 
+#include "../../common/array.hpp"
 #include "../../common/defs.hpp"
-#include "../../common/hypercube_iterator.hpp"
-#include "../../common/layout_map_metafunctions.hpp"
-#include "../../common/make_array.hpp"
-#include "../../common/tuple_util.hpp"
-#include "../../storage/storage_facility.hpp"
+#include "../../common/thread_pool.hpp"
 #include "layout_transformation_config.hpp"
-#include "layout_transformation_helper.hpp"
 
 namespace gridtools {
     namespace impl {
+        struct transform_dim {
+            std::ptrdiff_t size;
+            std::ptrdiff_t dst_stride;
+            std::ptrdiff_t src_stride;
+        };
+
+        /**
+         * @brief Loop nest of a host layout transformation.
+         *
+         * The dimensions are ranked by their strides: `a` is the dimension with the smallest destination stride, `b`
+         * the one with the smallest source stride. If they differ, the transformation is a transpose in the (a, b)
+         * plane which is processed in square tiles, such that both the reads and the writes of a tile stay in cache;
+         * otherwise `a` is split into linear chunks. All remaining dimensions are outer dimensions, sorted by
+         * decreasing destination stride. Tiles of all outer indices are flattened into a single iteration space.
+         */
+        struct transform_plan {
+            transform_dim a;
+            transform_dim b;
+            bool transpose;
+            std::ptrdiff_t tile_a;
+            std::ptrdiff_t tile_b;
+            std::ptrdiff_t n_tiles_a;
+            std::ptrdiff_t n_tiles_b;
+            int n_outer;
+            array<transform_dim, GT_TRANSFORM_MAX_DIM> outer;
+
+            std::ptrdiff_t size() const {
+                std::ptrdiff_t res = n_tiles_a * n_tiles_b;
+                for (int d = 0; d < n_outer; ++d)
+                    res *= outer[d].size;
+                return res;
+            }
+        };
+
+        inline transform_plan make_transform_plan(const std::vector<uint_t> &dims,
+            const std::vector<uint_t> &dst_strides,
+            const std::vector<uint_t> &src_strides) {
+            std::vector<transform_dim> nontrivial;
+            for (std::size_t d = 0; d < dims.size(); ++d)
+                if (dims[d] != 1)
+                    nontrivial.push_back({std::ptrdiff_t(dims[d]), dst_strides[d], src_strides[d]});
+            if (nontrivial.empty())
+                nontrivial.push_back({1, 0, 0});
+
+            std::stable_sort(nontrivial.begin(), nontrivial.end(), [](transform_dim const &l, transform_dim const &r) {
+                return l.dst_stride > r.dst_stride || (l.dst_stride == r.dst_stride && l.src_stride > r.src_stride);
+            });
+            std::size_t a = nontrivial.size() - 1;
+            std::size_t b = a;
+            for (std::size_t d = 0; d < nontrivial.size(); ++d)
+                if (nontrivial[d].src_stride < nontrivial[b].src_stride)
+                    b = d;
+
+            transform_plan plan;
+            plan.a = nontrivial[a];
+            plan.b = nontrivial[b];
+            plan.transpose = a != b;
+            plan.tile_a = plan.transpose ? GT_TRANSFORM_TILE_SIZE : GT_TRANSFORM_LINEAR_CHUNK;
+            plan.tile_b = plan.transpose ? GT_TRANSFORM_TILE_SIZE : 1;
+            plan.n_tiles_a = (plan.a.size + plan.tile_a - 1) / plan.tile_a;
+            plan.n_tiles_b = plan.transpose ? (plan.b.size + plan.tile_b - 1) / plan.tile_b : 1;
+            plan.n_outer = 0;
+            for (std::size_t d = 0; d < nontrivial.size(); ++d)
+                if (d != a && d != b)
+                    plan.outer[plan.n_outer++] = nontrivial[d];
+            return plan;
+        }
+
+        /**
+         * @brief Copies a (tile_b x tile_a) tile with contiguous writes along `a`.
+         */
+        template <typename DataType>
+        void transform_tile(DataType *GT_RESTRICT dst,
+            DataType const *GT_RESTRICT src,
+            std::ptrdiff_t size_a,
+            std::ptrdiff_t size_b,
+            std::ptrdiff_t dst_stride_a,
+            std::ptrdiff_t dst_stride_b,
+            std::ptrdiff_t src_stride_a,
+            std::ptrdiff_t src_stride_b) {
+            for (std::ptrdiff_t ib = 0; ib < size_b; ++ib) {
+                DataType *GT_RESTRICT d = dst + ib * dst_stride_b;
+                DataType const *GT_RESTRICT s = src + ib * src_stride_b;
+#pragma omp simd
+                for (std::ptrdiff_t ia = 0; ia < size_a; ++ia)
+                    d[ia * dst_stride_a] = s[ia * src_stride_a];
+            }
+        }
+
+        /**
+         * @brief Copies the item-th tile of the transformation plan.
+         */
+        template <typename DataType>
+        void transform_item(DataType *dst, DataType *src, transform_plan const &plan, std::ptrdiff_t item) {
+            std::ptrdiff_t rest = item;
+            const std::ptrdiff_t tile_a = rest % plan.n_tiles_a;
+            rest /= plan.n_tiles_a;
+            const std::ptrdiff_t tile_b = rest % plan.n_tiles_b;
+            rest /= plan.n_tiles_b;
+
+            const std::ptrdiff_t begin_a = tile_a * plan.tile_a;
+            const std::ptrdiff_t begin_b = tile_b * plan.tile_b;
+            std::ptrdiff_t dst_offset = begin_a * plan.a.dst_stride;
+            std::ptrdiff_t src_offset = begin_a * plan.a.src_stride;
+            if (plan.transpose) {
+                dst_offset += begin_b * plan.b.dst_stride;
+                src_offset += begin_b * plan.b.src_stride;
+            }
+            for (int d = plan.n_outer - 1; d >= 0; --d) {
+                const std::ptrdiff_t index = rest % plan.outer[d].size;
+                rest /= plan.outer[d].size;
+                dst_offset += index * plan.outer[d].dst_stride;
+                src_offset += index * plan.outer[d].src_stride;
+            }
+
+            transform_tile(dst + dst_offset,
+                src + src_offset,
+                std::min(plan.tile_a, plan.a.size - begin_a),
+                plan.transpose ? std::min(plan.tile_b, plan.b.size - begin_b) : 1,
+                plan.a.dst_stride,
+                plan.b.dst_stride,
+                plan.a.src_stride,
+                plan.b.src_stride);
+        }
+
         template <typename DataType>
         void transform_openmp_loop(DataType *dst,
             DataType *src,
@@ -33,34 +158,22 @@ namespace gridtools {
             if (dims.size() > GT_TRANSFORM_MAX_DIM)
                 throw std::runtime_error("Reached compile time GT_TRANSFORM_MAX_DIM in layout transformation. Increase "
                                          "the value for higher dimensional transformations.");
+            if (dims.size() != dst_strides.size() || dims.size() != src_strides.size())
+                throw std::runtime_error("transform(): dims and strides vectors have different size");
+            if (std::find(dims.begin(), dims.end(), 0) != dims.end())
+                return;
 
-            using dummy_layout_map =
-                default_layout_map_t<GT_TRANSFORM_MAX_DIM>; // not used since we pass strides directly
-
-            using storage_info = gridtools::storage_info<0, dummy_layout_map>;
-            auto a_dims = impl::vector_to_dims_array<GT_TRANSFORM_MAX_DIM>(dims);
-            auto a_dst_strides = impl::vector_to_strides_array<GT_TRANSFORM_MAX_DIM>(dst_strides);
-            auto a_src_strides = impl::vector_to_strides_array<GT_TRANSFORM_MAX_DIM>(src_strides);
-
-            storage_info si_dst(a_dims, a_dst_strides);
-            storage_info si_src(a_dims, a_src_strides);
-
-            array<size_t, GT_TRANSFORM_MAX_DIM - 3> outer_dims;
-            for (size_t i = 0; i < GT_TRANSFORM_MAX_DIM - 3; ++i)
-                outer_dims[i] = a_dims[3 + i];
-
-            for (auto &&outer : make_hypercube_view(outer_dims)) {
-                uint_t size_i = a_dims[0]; // because ICC 17 complains otherwise...
-                uint_t size_j = a_dims[1];
-                uint_t size_k = a_dims[2];
-#pragma omp parallel for collapse(3)
-                for (int i = 0; i < (int)size_i; ++i)
-                    for (int j = 0; j < (int)size_j; ++j)
-                        for (int k = 0; k < (int)size_k; ++k) {
-                            auto index = tuple_util::push_front(tuple_util::convert_to<array, int>(outer), i, j, k);
-                            dst[si_dst.index(index)] = src[si_src.index(index)];
-                        }
-            }
+            const transform_plan plan = make_transform_plan(dims, dst_strides, src_strides);
+            const std::ptrdiff_t n_items = plan.size();
+
+#ifdef GT_USE_THREAD_POOL
+            thread_pool::get().parallel_for(
+                n_items, [&](std::ptrdiff_t item) { transform_item(dst, src, plan, item); });
+#else
+#pragma omp parallel for schedule(static)
+            for (std::ptrdiff_t item = 0; item < n_items; ++item)
+                transform_item(dst, src, plan, item);
+#endif
         }
     } // namespace impl
 } // namespace gridtools
@@ -136,7 +136,32 @@ namespace gridtools {
         template <uint_t>
         struct arg_tag;
 
+        template <uint_t, class ComputeType>
+        struct mixed_precision_arg_tag;
+
+        template <class Tag, class Default>
+        struct tag_compute_type {
+            using type = Default;
+        };
+
+        template <uint_t I, class ComputeType, class Default>
+        struct tag_compute_type<mixed_precision_arg_tag<I, ComputeType>, Default> {
+            using type = ComputeType;
+        };
     } // namespace _impl
+
+    /**
+     * The type to which the values of a placeholder are converted when they are read through an `in_accessor`. This
+     * is the value type of the data store, unless the placeholder is declared with `mixed_precision_arg` or
+     * `mixed_precision_tmp_arg`.
+     */
+    template <class Plh>
+    struct compute_type;
+
+    template <class Tag, class DataStore, class Location, bool Temporary>
+    struct compute_type<plh<Tag, DataStore, Location, Temporary>>
+        : _impl::tag_compute_type<Tag, typename DataStore::data_t> {};
+
     /** alias template that provides convenient tmp arg declaration.
      *
      *  Here we force tmp storages to share storage info type. To achieve this we substitute the storage info ID
@@ -151,4 +176,20 @@ namespace gridtools {
 
     template <uint_t I, typename T, typename LocationType = enumtype::default_location_type>
     using arg = plh<_impl::arg_tag<I>, T, LocationType, false>;
+
+    /**
+     * Placeholders for fields that are stored with another precision than they are computed with. `DataStoreType`
+     * determines the storage, e.g. a data store of `float` to halve the memory traffic and footprint of a
+     * temporary, including its ij- and k-caches. The values are converted to `ComputeType` when read through an
+     * `in_accessor` and back to the value type of the data store when written. Note that `inout_accessor`s refer to
+     * the stored values directly, thus reading through them does not convert.
+     */
+    template <uint_t I, class ComputeType, typename DataStoreType, typename Location = enumtype::default_location_type>
+    using mixed_precision_tmp_arg = plh<_impl::mixed_precision_arg_tag<I, ComputeType>,
+        typename _impl::tmp_data_store<_impl::tmp_storage_info_id<Location>::value, DataStoreType>::type,
+        Location,
+        true>;
+
+    template <uint_t I, class ComputeType, typename DataStoreType, typename Location = enumtype::default_location_type>
+    using mixed_precision_arg = plh<_impl::mixed_precision_arg_tag<I, ComputeType>, DataStoreType, Location, false>;
 } // namespace gridtools
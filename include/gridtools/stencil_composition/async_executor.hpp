@@ -0,0 +1,173 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../common/defs.hpp"
+#include "arg.hpp"
+#include "computation_dependencies.hpp"
+
+/**
+ * @file
+ * Asynchronous execution of computations on a persistent team of worker threads.
+ *
+ * Every submitted run records the data stores it reads and writes. A run starts only after all previously submitted
+ * runs that conflict with it (read after write, write after read, write after write on the same data store, or the
+ * same computation object) have finished. Independent runs may be executed concurrently if the executor has more
+ * than one worker. Only the data stores that are passed to `run_async` take part in the ordering; data stores that
+ * were bound at `make_computation` time are invisible to the executor.
+ *
+ * Each worker is a long lived thread that executes the OpenMP parallel regions of the computations it runs, such
+ * that the OpenMP thread team of a worker is created once and reused for all subsequent runs. A computation whose
+ * temporaries hold a slice per thread (CPU backends) reallocates them if `threads_per_worker` differs from the number
+ * of threads it was run with before.
+ */
+namespace gridtools {
+    class async_executor {
+        struct task {
+            std::function<void()> m_run;
+            std::vector<_impl::computation_detail::data_store_access> m_accesses;
+            std::promise<void> m_promise;
+            bool m_running;
+        };
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        // all submitted tasks that did not finish yet, in submission order
+        std::list<std::shared_ptr<task>> m_tasks;
+        bool m_stop = false;
+        int m_threads_per_worker;
+        std::vector<std::thread> m_workers;
+
+        // the first task that waits and does not conflict with any task submitted before it
+        std::list<std::shared_ptr<task>>::iterator find_ready() {
+            for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+                if ((*it)->m_running)
+                    continue;
+                bool ready = std::none_of(m_tasks.begin(), it, [&](std::shared_ptr<task> const &prev) {
+                    return _impl::computation_detail::conflicts(prev->m_accesses, (*it)->m_accesses);
+                });
+                if (ready)
+                    return it;
+            }
+            return m_tasks.end();
+        }
+
+        void work() {
+#ifdef _OPENMP
+            omp_set_num_threads(m_threads_per_worker);
+#endif
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true) {
+                auto it = find_ready();
+                if (it == m_tasks.end()) {
+                    if (m_stop && m_tasks.empty())
+                        return;
+                    m_cv.wait(lock);
+                    continue;
+                }
+                auto current = *it;
+                current->m_running = true;
+                lock.unlock();
+                std::exception_ptr error;
+                try {
+                    current->m_run();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                lock.lock();
+                m_tasks.erase(std::find(m_tasks.begin(), m_tasks.end(), current));
+                if (error)
+                    current->m_promise.set_exception(error);
+                else
+                    current->m_promise.set_value();
+                m_cv.notify_all();
+            }
+        }
+
+      public:
+        /**
+         * @param workers number of runs that may be executed concurrently
+         * @param threads_per_worker number of OpenMP threads used by each run
+         */
+        explicit async_executor(int workers = 1, int threads_per_worker = omp_get_max_threads())
+            : m_threads_per_worker(std::max(threads_per_worker, 1)) {
+            for (int i = 0; i < std::max(workers, 1); ++i)
+                m_workers.emplace_back(&async_executor::work, this);
+        }
+
+        async_executor(async_executor const &) = delete;
+        async_executor &operator=(async_executor const &) = delete;
+
+        /**
+         * @brief Finishes all submitted runs and joins the workers.
+         */
+        ~async_executor() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_all();
+            for (auto &worker : m_workers)
+                worker.join();
+        }
+
+        /**
+         * @brief Submits a run of `comp` with the given data stores.
+         *
+         * The data stores are kept alive until the run has finished. The computation is referenced and has to outlive
+         * the run. Exceptions thrown by the run are rethrown by `get()` on the returned future.
+         */
+        template <class Computation, class... Args, class... DataStores>
+        std::future<void> submit(Computation &comp, arg_storage_pair<Args, DataStores> const &... args) {
+            std::shared_ptr<task> t(new task{_impl::computation_detail::bind_run(comp, args...),
+                _impl::computation_detail::collect_accesses(comp, args...),
+                {},
+                false});
+            auto res = t->m_promise.get_future();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(std::move(t));
+            }
+            m_cv.notify_all();
+            return res;
+        }
+
+        /**
+         * @brief Blocks until all submitted runs have finished.
+         */
+        void wait() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_tasks.empty(); });
+        }
+
+        int workers() const { return m_workers.size(); }
+
+        /**
+         * @brief The executor used by `run_async` of computations. It has a single worker that uses all OpenMP
+         * threads, such that runs are executed one after another in submission order.
+         */
+        static async_executor &get_default() {
+            static async_executor instance;
+            return instance;
+        }
+    };
+} // namespace gridtools
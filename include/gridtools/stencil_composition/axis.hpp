@@ -77,4 +77,50 @@ namespace gridtools {
       private:
         array<uint_t, NIntervals> interval_sizes_;
     };
+
+    /**
+     * The splitter positions of an axis whose interval sizes are known at compile time.
+     */
+    template <uint_t... Splitters>
+    struct static_splitters {
+        GT_FUNCTION static constexpr uint_t at(uint_t index) { return get_value_from_pack(index, Splitters...); }
+    };
+
+    namespace _impl {
+        template <uint_t Last, class Splitters, uint_t... IntervalSizes>
+        struct make_static_splitters;
+
+        template <uint_t Last, uint_t... Splitters>
+        struct make_static_splitters<Last, static_splitters<Splitters...>> {
+            using type = static_splitters<Splitters...>;
+        };
+
+        template <uint_t Last, uint_t... Splitters, uint_t IntervalSize, uint_t... IntervalSizes>
+        struct make_static_splitters<Last, static_splitters<Splitters...>, IntervalSize, IntervalSizes...>
+            : make_static_splitters<Last + IntervalSize,
+                  static_splitters<Splitters..., Last + IntervalSize>,
+                  IntervalSizes...> {};
+    } // namespace _impl
+
+    /**
+     * An axis with interval sizes that are fixed at compile time, e.g. `static_axis<axis<1>, 60>` for columns of 60
+     * levels.
+     *
+     * A grid made from a static axis (see make_grid) computes the vertical loop bounds from compile time constants,
+     * such that the compiler can specialize the k-loops of the backends for the given sizes. Only the loop bounds are
+     * affected: the k-caches are sized by the vertical extents of the accessors anyway, the strides of the storages
+     * stay runtime values. The intervals are the same as those of `Axis`, hence the stencils can be run on either
+     * kind of grid.
+     */
+    template <class Axis, uint_t... IntervalSizes>
+    class static_axis : public Axis {
+        GT_STATIC_ASSERT(sizeof...(IntervalSizes) == Axis::axis_interval_t::ToLevel::splitter,
+            "The number of interval sizes does not match the number of intervals of the axis.");
+
+      public:
+        using static_splitters_t =
+            typename _impl::make_static_splitters<0, static_splitters<0>, IntervalSizes...>::type;
+
+        static_axis() : Axis(IntervalSizes...) {}
+    };
 } // namespace gridtools
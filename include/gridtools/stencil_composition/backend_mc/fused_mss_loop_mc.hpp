@@ -9,6 +9,9 @@
  */
 #pragma once
 
+#include "../../common/thread_placement.hpp"
+#include "../../common/thread_pool.hpp"
+#include "../column_mask.hpp"
 #include "../mss_functor.hpp"
 
 /**@file
@@ -44,13 +47,22 @@ namespace gridtools {
         execinfo_mc exinfo(grid);
         const int_t i_blocks = exinfo.i_blocks();
         const int_t j_blocks = exinfo.j_blocks();
-#pragma omp parallel for collapse(2)
+#ifdef GT_USE_THREAD_POOL
+        thread_pool::get().parallel_for(j_blocks, i_blocks, [&](int_t bj, int_t bi) {
+            host::for_each<GT_META_CALL(meta::make_indices_for, MssComponents)>(
+                make_mss_functor<MssComponents>(backend_target, local_domain_lists, grid, exinfo.block(bi, bj)));
+        });
+#else
+        // the block order of a thread placement relies on the iteration to thread mapping of this schedule
+        const int_t chunk = _impl::thread_placement_detail::static_chunk(i_blocks * j_blocks, host_max_threads());
+#pragma omp parallel for collapse(2) schedule(static, chunk)
         for (int_t bj = 0; bj < j_blocks; ++bj) {
             for (int_t bi = 0; bi < i_blocks; ++bi) {
                 host::for_each<GT_META_CALL(meta::make_indices_for, MssComponents)>(
                     make_mss_functor<MssComponents>(backend_target, local_domain_lists, grid, exinfo.block(bi, bj)));
             }
         }
+#endif
     }
 
     /**
@@ -70,7 +82,14 @@ namespace gridtools {
         const int_t j_blocks = exinfo.j_blocks();
         const int_t k_first = grid.k_min();
         const int_t k_last = grid.k_max();
-#pragma omp parallel for collapse(3)
+#ifdef GT_USE_THREAD_POOL
+        thread_pool::get().parallel_for(j_blocks, k_last - k_first + 1, i_blocks, [&](int_t bj, int_t k, int_t bi) {
+            host::for_each<GT_META_CALL(meta::make_indices_for, MssComponents)>(make_mss_functor<MssComponents>(
+                backend_target, local_domain_lists, grid, exinfo.block(bi, bj, k_first + k)));
+        });
+#else
+        // static like the thread pool, such that a thread works on the same blocks and levels in every run
+#pragma omp parallel for collapse(3) schedule(static)
         for (int_t bj = 0; bj < j_blocks; ++bj) {
             for (int_t k = k_first; k <= k_last; ++k) {
                 for (int_t bi = 0; bi < i_blocks; ++bi) {
@@ -79,6 +98,45 @@ namespace gridtools {
                 }
             }
         }
+#endif
+    }
+
+    /**
+     * @brief executes all mss functors on the active columns of `mask` only
+     *
+     * The active columns are split into one chunk per thread with the same number of active columns. Each thread
+     * executes its columns in runs along i (the vectorized dimension) of at most the i-size of the regular blocks,
+     * such that the per-thread temporaries of the regular blocks can be used. The parallelism comes from the columns
+     * only: all multi-stage stencils, also the k-parallel ones, traverse the whole column of a run at once.
+     */
+    template <class MssComponents, class LocalDomainListArray, class Grid>
+    GT_FORCE_INLINE static void fused_mss_loop(backend::mc const &backend_target,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        column_mask const &mask) {
+        GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
+
+        execinfo_mc exinfo(grid);
+        const int_t chunks = host_max_threads();
+        auto run_chunk = [&](int_t chunk) {
+            mask.for_each_segment<0>(chunk, chunks, exinfo.i_block_size(), [&](column_segment const &segment) {
+                host::for_each<GT_META_CALL(meta::make_indices_for, MssComponents)>(
+                    make_mss_functor<MssComponents>(backend_target,
+                        local_domain_lists,
+                        grid,
+                        execinfo_block_kserial_mc{(int_t)grid.i_low_bound() + segment.i,
+                            (int_t)grid.j_low_bound() + segment.j,
+                            segment.i_size,
+                            segment.j_size}));
+            });
+        };
+#ifdef GT_USE_THREAD_POOL
+        thread_pool::get().parallel_for(chunks, run_chunk);
+#else
+#pragma omp parallel for schedule(static, 1)
+        for (int_t chunk = 0; chunk < chunks; ++chunk)
+            run_chunk(chunk);
+#endif
     }
 
     /**
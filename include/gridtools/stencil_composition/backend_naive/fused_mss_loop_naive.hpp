@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../../meta.hpp"
+#include "../column_mask.hpp"
 #include "../mss_functor.hpp"
 
 /**@file
@@ -35,6 +36,24 @@ namespace gridtools {
             make_mss_functor<MssComponents>(backend_target, local_domain_lists, grid, execution_info_naive{}));
     }
 
+#ifndef GT_ICOSAHEDRAL_GRIDS
+    /**
+     * @brief executes all mss functors on the active columns of `mask` only, run by run
+     */
+    template <class MssComponents, class LocalDomainListArray, class Grid>
+    GT_FORCE_INLINE static void fused_mss_loop(backend::naive const &backend_target,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        column_mask const &mask) {
+        GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
+        GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
+        mask.for_each_segment<1>(0, 1, mask.j_size(), [&](column_segment const &segment) {
+            host::for_each<GT_META_CALL(meta::make_indices_for, MssComponents)>(
+                make_mss_functor<MssComponents>(backend_target, local_domain_lists, grid, segment));
+        });
+    }
+#endif
+
     /**
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
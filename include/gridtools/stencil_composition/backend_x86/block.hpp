@@ -9,11 +9,45 @@
  */
 #pragma once
 
+#include <cstdlib>
+#include <stdexcept>
+
 #include "../../common/defs.hpp"
 #include "../../common/host_device.hpp"
 #include "../grid.hpp"
 
 namespace gridtools {
-    GT_FUNCTION constexpr uint_t block_i_size(backend::x86 const &) { return GT_DEFAULT_TILE_I; }
-    GT_FUNCTION constexpr uint_t block_j_size(backend::x86 const &) { return GT_DEFAULT_TILE_J; }
+    GT_FUNCTION constexpr uint_t block_i_size(backend::x86 const &backend) { return backend.tile_i; }
+    GT_FUNCTION constexpr uint_t block_j_size(backend::x86 const &backend) { return backend.tile_j; }
+
+    namespace _impl {
+        namespace x86_tile_detail {
+            inline uint_t env_tile(char const *name, uint_t default_value) {
+                char const *value = std::getenv(name);
+                int res = value && *value ? std::atoi(value) : 0;
+                return res > 0 ? res : default_value;
+            }
+        } // namespace x86_tile_detail
+    }     // namespace _impl
+
+    /**
+     * @brief The tile size is taken from the environment variables `GT_TILE_I` and `GT_TILE_J` if they are set, from
+     * `GT_DEFAULT_TILE_I/J` otherwise.
+     */
+    inline backend::x86 configure_backend(backend::x86 const &) {
+        backend::x86 res;
+        res.tile_i = _impl::x86_tile_detail::env_tile("GT_TILE_I", GT_DEFAULT_TILE_I);
+        res.tile_j = _impl::x86_tile_detail::env_tile("GT_TILE_J", GT_DEFAULT_TILE_J);
+        return res;
+    }
+
+    /**
+     * @brief Sets the size of the blocks that are executed by one thread at a time (x86 backend).
+     */
+    inline void set_tile_size(backend::x86 &backend, uint_t i, uint_t j) {
+        if (i == 0 || j == 0)
+            throw std::runtime_error("set_tile_size: the tile size should be positive");
+        backend.tile_i = i;
+        backend.tile_j = j;
+    }
 } // namespace gridtools
@@ -9,7 +9,9 @@
  */
 #pragma once
 
+#include "../../common/thread_pool.hpp"
 #include "../../meta.hpp"
+#include "../column_mask.hpp"
 #include "../mss_functor.hpp"
 
 /**@file
@@ -38,6 +40,14 @@ namespace gridtools {
         uint_t NBI = n / block_i_size(backend_target);
         uint_t NBJ = m / block_j_size(backend_target);
 
+#ifdef GT_USE_THREAD_POOL
+        thread_pool::get().parallel_for(NBI + 1, [&](int_t bi) {
+            for (uint_t bj = 0; bj <= NBJ; ++bj) {
+                host::for_each<GT_META_CALL(meta::make_indices_for, MssComponents)>(make_mss_functor<MssComponents>(
+                    backend_target, local_domain_lists, grid, execution_info_x86{(uint_t)bi, bj}));
+            }
+        });
+#else
 #pragma omp parallel
         {
 #pragma omp for nowait
@@ -48,7 +58,39 @@ namespace gridtools {
                 }
             }
         }
+#endif
+    }
+
+#ifndef GT_ICOSAHEDRAL_GRIDS
+    /**
+     * @brief executes all mss functors on the active columns of `mask` only
+     *
+     * The active columns are split into one chunk per thread with the same number of active columns. Each thread
+     * executes its columns in runs along j (the innermost loop of the blocks) of at most one block size.
+     */
+    template <class MssComponents, class LocalDomainListArray, class Grid>
+    GT_FORCE_INLINE static void fused_mss_loop(backend::x86 const &backend_target,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        column_mask const &mask) {
+        GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
+        GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
+        const int_t chunks = host_max_threads();
+        auto run_chunk = [&](int_t chunk) {
+            mask.for_each_segment<1>(chunk, chunks, block_j_size(backend_target), [&](column_segment const &segment) {
+                host::for_each<GT_META_CALL(meta::make_indices_for, MssComponents)>(
+                    make_mss_functor<MssComponents>(backend_target, local_domain_lists, grid, segment));
+            });
+        };
+#ifdef GT_USE_THREAD_POOL
+        thread_pool::get().parallel_for(chunks, run_chunk);
+#else
+#pragma omp parallel for schedule(static, 1)
+        for (int_t chunk = 0; chunk < chunks; ++chunk)
+            run_chunk(chunk);
+#endif
     }
+#endif
 
     /**
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
@@ -11,22 +11,25 @@
 
 #include "../../common/defs.hpp"
 #include "../../common/host_device.hpp"
+#include "../../common/thread_pool.hpp"
 
 #include "../dim.hpp"
 
 namespace gridtools {
     namespace tmp_storage {
+        constexpr std::true_type sized_per_thread(backend::x86 const &) { return {}; }
+
         // Block specialisations
         template <class StorageInfo, class /*MaxExtent*/>
         uint_t get_i_size(backend::x86 const &, uint_t block_size, uint_t /*total_size*/) {
             static constexpr auto halo = StorageInfo::halo_t::template at<dim::i::value>();
-            return (block_size + 2 * halo) * omp_get_max_threads();
+            return (block_size + 2 * halo) * host_max_threads();
         }
 
         template <class StorageInfo, class /*MaxExtent*/>
         GT_FUNCTION int_t get_i_block_offset(backend::x86 const &, uint_t block_size, uint_t /*block_no*/) {
             static constexpr auto halo = StorageInfo::halo_t::template at<dim::i::value>();
-            return (block_size + 2 * halo) * omp_get_thread_num() + halo;
+            return (block_size + 2 * halo) * host_thread_num() + halo;
         }
 
         template <class StorageInfo, class /*MaxExtent*/>
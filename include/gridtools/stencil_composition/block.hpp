@@ -27,9 +27,12 @@
  *
  *  Ideally for backends where block size is compile time, it is enough to define only constexpr version.
  *  And for backends where block size is run time, it is enough to define only the version with two args.
- *  However X86/Naive backend still have to define constexpr version that returns 0.
+ *  However Naive backend still has to define constexpr version that returns 0.
  *  TODO(anstaf): fix that
  *
+ *  The x86 backend object carries its tile size: its constexpr form is evaluated at run time on the backend object
+ *  of the computation, such that the tile size can be changed without recompiling.
+ *
  */
 
 #include "../common/defs.hpp"
@@ -46,6 +49,14 @@
 #endif
 
 namespace gridtools {
+    /**
+     * @brief The backend object a computation starts with, backends with runtime parameters overload it.
+     */
+    template <class Backend>
+    Backend configure_backend(Backend const &backend) {
+        return backend;
+    }
+
     template <class Backend>
     GT_FUNCTION constexpr uint_t block_k_size(Backend const &) {
         return 0;
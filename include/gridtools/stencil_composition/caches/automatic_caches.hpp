@@ -0,0 +1,102 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <tuple>
+
+#include "../../common/defs.hpp"
+#include "../../meta.hpp"
+#include "../arg.hpp"
+#include "../esf_metafunctions.hpp"
+#include "../execution_types.hpp"
+#include "../extract_placeholders.hpp"
+#include "../mss.hpp"
+#include "./cache.hpp"
+#include "./cache_traits.hpp"
+#include "./extract_extent_caches.hpp"
+
+/**
+ * @file
+ * Automatic caching of temporaries.
+ *
+ * Temporaries that are written and read within a single multi-stage stencil do not need to be kept in memory beyond
+ * the k-level or the column they are used in. Such temporaries are classified by the offsets of the accesses within
+ * their multi-stage stencil and get a local cache if the user did not specify one:
+ *  - no offsets at all (a scalar per grid point): a k-cache with an empty window in k-serial multi-stage stencils
+ *    (a register on the GPU), an ij-cache in parallel ones,
+ *  - no offsets along k: an ij-cache,
+ *  - no offsets along i and j in k-serial multi-stage stencils: a k-cache,
+ *  - all other temporaries stay in memory.
+ *
+ * Backends that do not support caches keep allocating and accessing those temporaries in memory. The classification
+ * is opt-in: computations use it only if `GT_ENABLE_AUTOMATIC_CACHES` is defined. An ij-cache takes shared memory on
+ * the GPU, which lowers the occupancy of the kernel, hence it is not always faster than a temporary in global memory.
+ */
+namespace gridtools {
+    namespace automatic_caches_impl_ {
+        template <class Arg>
+        struct uses_arg {
+            template <class Mss>
+            GT_META_DEFINE_ALIAS(
+                apply, meta::st_contains, (GT_META_CALL(extract_placeholders_from_mss, Mss), Arg));
+        };
+
+        template <class Mss, class Msses>
+        struct add_caches {
+            using esfs_t = GT_META_CALL(unwrap_independent, typename Mss::esf_sequence_t);
+            using cache_sequence_t = typename Mss::cache_sequence_t;
+            using user_cached_args_t = GT_META_CALL(meta::transform, (cache_parameter, cache_sequence_t));
+            using rw_args_t = GT_META_CALL(compute_readwrite_args, esfs_t);
+            using tmp_args_t = GT_META_CALL(
+                meta::filter, (is_tmp_arg, GT_META_CALL(extract_placeholders_from_mss, Mss)));
+
+            static constexpr bool is_serial = !execute::is_parallel<typename Mss::execution_engine_t>::value;
+
+            template <class Arg,
+                class Extent = GT_META_CALL(extract_k_extent_for_cache, (Arg, esfs_t)),
+                bool IsCandidate = !meta::st_contains<user_cached_args_t, Arg>::value &&
+                                   meta::st_contains<rw_args_t, Arg>::value &&
+                                   meta::length<GT_META_CALL(meta::filter,
+                                       (uses_arg<Arg>::template apply, Msses))>::value == 1,
+                bool ZeroK = Extent::kminus::value == 0 && Extent::kplus::value == 0,
+                bool ZeroIJ = Extent::iminus::value == 0 && Extent::iplus::value == 0 && Extent::jminus::value == 0 &&
+                              Extent::jplus::value == 0>
+            struct get_cache_impl
+                : meta::lazy::if_c<IsCandidate && ZeroIJ && is_serial,
+                      std::tuple<detail::cache_impl<cache_type::k, Arg, cache_io_policy::local>>,
+                      GT_META_CALL(meta::if_c,
+                          (IsCandidate && ZeroK,
+                              std::tuple<detail::cache_impl<cache_type::ij, Arg, cache_io_policy::local>>,
+                              std::tuple<>))> {};
+
+            template <class Arg>
+            GT_META_DEFINE_ALIAS(get_cache, meta::id, typename get_cache_impl<Arg>::type);
+
+            using caches_t = GT_META_CALL(meta::flatten,
+                (GT_META_CALL(
+                    meta::push_front, (GT_META_CALL(meta::transform, (get_cache, tmp_args_t)), cache_sequence_t))));
+
+            using type = mss_descriptor<typename Mss::execution_engine_t, typename Mss::esf_sequence_t, caches_t>;
+        };
+
+        template <class Msses>
+        struct add_caches_f {
+            template <class Mss>
+            GT_META_DEFINE_ALIAS(apply, meta::id, (typename add_caches<Mss, Msses>::type));
+        };
+    } // namespace automatic_caches_impl_
+
+    /**
+     * @brief Adds local caches for the temporaries of the multi-stage stencils `Msses` that can be cached.
+     */
+    template <class Msses>
+    GT_META_DEFINE_ALIAS(
+        add_automatic_caches, meta::transform, (automatic_caches_impl_::add_caches_f<Msses>::template apply, Msses));
+} // namespace gridtools
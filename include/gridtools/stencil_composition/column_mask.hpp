@@ -0,0 +1,154 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../common/array.hpp"
+#include "../common/defs.hpp"
+
+/**
+ * @file
+ * Masked execution of computations on a subset of the columns of the compute domain (see `intermediate::run_masked`).
+ *
+ * The active columns are stored as a compact list of runs of consecutive active columns, once with runs along i and
+ * once with runs along j, such that every backend can traverse them in the order of its memory layout. A computation
+ * that runs with a mask executes every run like a small block of the regular blocked execution: stages with
+ * horizontal extents compute the values they need around the run, temporaries live in the usual per-thread block
+ * storages, and the points outside the active columns are neither read as results nor written.
+ */
+namespace gridtools {
+    /**
+     * @brief Consecutive active columns that are executed together, relative to the origin of the compute domain.
+     */
+    struct column_segment {
+        int_t i;
+        int_t j;
+        int_t i_size;
+        int_t j_size;
+    };
+
+    /**
+     * @brief Set of active columns of a compute domain of size `i_size` x `j_size`.
+     */
+    class column_mask {
+        struct column_run {
+            int_t i;
+            int_t j;
+            int_t length;
+        };
+
+        uint_t m_i_size;
+        uint_t m_j_size;
+        std::vector<bool> m_active;
+        // runs along i (index 0) and along j (index 1) and the number of active columns before every run
+        std::vector<column_run> m_runs[2];
+        std::vector<int_t> m_offsets[2];
+
+        void init() {
+            for (int dir = 0; dir != 2; ++dir) {
+                const uint_t outer_size = dir == 0 ? m_j_size : m_i_size;
+                const uint_t inner_size = dir == 0 ? m_i_size : m_j_size;
+                int_t count = 0;
+                for (uint_t outer = 0; outer != outer_size; ++outer) {
+                    for (uint_t inner = 0; inner != inner_size;) {
+                        auto is_active = [&](uint_t pos) {
+                            return dir == 0 ? active(pos, outer) : active(outer, pos);
+                        };
+                        if (!is_active(inner)) {
+                            ++inner;
+                            continue;
+                        }
+                        uint_t end = inner + 1;
+                        while (end != inner_size && is_active(end))
+                            ++end;
+                        m_runs[dir].push_back({(int_t)(dir == 0 ? inner : outer),
+                            (int_t)(dir == 0 ? outer : inner),
+                            (int_t)(end - inner)});
+                        m_offsets[dir].push_back(count);
+                        count += end - inner;
+                        inner = end;
+                    }
+                }
+            }
+        }
+
+      public:
+        /**
+         * @param i_size size of the compute domain along the i-axis
+         * @param j_size size of the compute domain along the j-axis
+         * @param mask callable, `mask(i, j)` returns true if the column (i, j) of the compute domain is active
+         */
+        template <class Mask>
+        column_mask(uint_t i_size, uint_t j_size, Mask const &mask)
+            : m_i_size(i_size), m_j_size(j_size), m_active(i_size * j_size) {
+            for (uint_t j = 0; j != j_size; ++j)
+                for (uint_t i = 0; i != i_size; ++i)
+                    m_active[i + i_size * j] = mask((int_t)i, (int_t)j);
+            init();
+        }
+
+        /**
+         * @param i_size size of the compute domain along the i-axis
+         * @param j_size size of the compute domain along the j-axis
+         * @param columns the (i, j) indices of the active columns in any order, duplicates are ignored
+         */
+        column_mask(uint_t i_size, uint_t j_size, std::vector<array<int_t, 2>> const &columns)
+            : m_i_size(i_size), m_j_size(j_size), m_active(i_size * j_size) {
+            for (auto const &column : columns) {
+                if (column[0] < 0 || column[0] >= (int_t)i_size || column[1] < 0 || column[1] >= (int_t)j_size)
+                    throw std::runtime_error("column_mask: column outside of the compute domain");
+                m_active[column[0] + i_size * column[1]] = true;
+            }
+            init();
+        }
+
+        uint_t i_size() const { return m_i_size; }
+        uint_t j_size() const { return m_j_size; }
+
+        /** @brief Number of active columns. */
+        int_t size() const { return m_offsets[0].empty() ? 0 : m_offsets[0].back() + m_runs[0].back().length; }
+
+        bool active(uint_t i, uint_t j) const { return m_active[i + m_i_size * j]; }
+
+        /**
+         * @brief Calls `f(segment)` for the active columns of chunk `chunk` out of `chunks` chunks.
+         *
+         * The active columns are ordered such that runs along the axis `Dim` (0 for i, 1 for j) are contiguous and
+         * split into `chunks` chunks with the same number of active columns. The columns of the chunk are passed as
+         * segments of at most `max_length` consecutive columns along `Dim`.
+         */
+        template <int Dim, class F>
+        void for_each_segment(int_t chunk, int_t chunks, int_t max_length, F &&f) const {
+            GT_STATIC_ASSERT(Dim == 0 || Dim == 1, "masks support runs along i or j only");
+            auto const &runs = m_runs[Dim];
+            auto const &offsets = m_offsets[Dim];
+            const int_t total = size();
+            int_t first = total * chunk / chunks;
+            const int_t last = total * (chunk + 1) / chunks;
+            if (first >= last)
+                return;
+            size_t r = std::upper_bound(offsets.begin(), offsets.end(), first) - offsets.begin() - 1;
+            while (first < last) {
+                const int_t pos = first - offsets[r];
+                const int_t length = std::min(std::min(runs[r].length - pos, last - first), max_length);
+                if (Dim == 0)
+                    f(column_segment{runs[r].i + pos, runs[r].j, length, 1});
+                else
+                    f(column_segment{runs[r].i, runs[r].j + pos, 1, length});
+                first += length;
+                if (first == offsets[r] + runs[r].length)
+                    ++r;
+            }
+        }
+    };
+} // namespace gridtools
@@ -9,8 +9,11 @@
  */
 #pragma once
 
+#include <future>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <typeinfo>
 #include <utility>
 
 #include "../common/defs.hpp"
@@ -18,6 +21,7 @@
 #include "../meta/type_traits.hpp"
 #include "accessor_intent.hpp"
 #include "arg.hpp"
+#include "async_executor.hpp"
 #include "extent.hpp"
 
 namespace gridtools {
@@ -34,6 +38,29 @@ namespace gridtools {
                 }
             };
 
+            // computations that are bound to a grid of the given type can be rebound, see `intermediate::rebind_grid`
+            template <class Obj, class Grid = decay_t<decltype(std::declval<Obj const &>().grid())>>
+            void rebind_grid(Obj &obj, void const *grid, std::type_info const &type) {
+                if (type != typeid(Grid))
+                    throw std::runtime_error("rebind_grid: the type of the grid does not match the computation");
+                obj.rebind_grid(*static_cast<Grid const *>(grid));
+            }
+
+            template <class Obj, class... Ts>
+            void rebind_grid(Obj &, Ts const &...) {
+                throw std::runtime_error("rebind_grid: the computation is not bound to a grid");
+            }
+
+            template <class Obj, class = decltype(std::declval<Obj &>().set_tile_size(1, 1))>
+            void set_tile_size(Obj &obj, uint_t i, uint_t j) {
+                obj.set_tile_size(i, j);
+            }
+
+            template <class Obj, class... Ts>
+            void set_tile_size(Obj &, Ts const &...) {
+                throw std::runtime_error("set_tile_size: not supported by the computation");
+            }
+
             template <typename Arg>
             struct iface_arg {
                 virtual ~iface_arg() = default;
@@ -72,6 +99,8 @@ namespace gridtools {
             virtual double get_time() const = 0;
             virtual size_t get_count() const = 0;
             virtual void reset_meter() = 0;
+            virtual void rebind_grid(void const *grid, std::type_info const &type) = 0;
+            virtual void set_tile_size(uint_t i, uint_t j) = 0;
         };
 
         template <class Obj>
@@ -87,6 +116,12 @@ namespace gridtools {
             double get_time() const override { return m_obj.get_time(); }
             size_t get_count() const override { return m_obj.get_count(); }
             void reset_meter() override { m_obj.reset_meter(); }
+            void rebind_grid(void const *grid, std::type_info const &type) override {
+                _impl::computation_detail::rebind_grid(m_obj, grid, type);
+            }
+            void set_tile_size(uint_t i, uint_t j) override {
+                _impl::computation_detail::set_tile_size(m_obj, i, j);
+            }
         };
 
         std::unique_ptr<iface> m_impl;
@@ -109,6 +144,22 @@ namespace gridtools {
             m_impl->run(permute_to<arg_storage_pair_crefs_t>(std::make_tuple(std::cref(args)...)));
         }
 
+        /**
+         * Non-blocking version of `run`. The run is dispatched to an `async_executor` (the default one if not given)
+         * and is ordered after all previously dispatched runs that touch the same data stores.
+         */
+        template <class... SomeArgs, class... SomeDataStores>
+        typename std::enable_if<sizeof...(SomeArgs) == sizeof...(Args), std::future<void>>::type run_async(
+            arg_storage_pair<SomeArgs, SomeDataStores> const &... args) {
+            return run_async(async_executor::get_default(), args...);
+        }
+
+        template <class... SomeArgs, class... SomeDataStores>
+        typename std::enable_if<sizeof...(SomeArgs) == sizeof...(Args), std::future<void>>::type run_async(
+            async_executor &executor, arg_storage_pair<SomeArgs, SomeDataStores> const &... args) {
+            return executor.submit(*this, args...);
+        }
+
         std::string print_meter() const { return m_impl->print_meter(); }
 
         double get_time() const { return m_impl->get_time(); }
@@ -117,6 +168,21 @@ namespace gridtools {
 
         void reset_meter() { m_impl->reset_meter(); }
 
+        /**
+         * Rebinds the computation to another grid of the type it was made with, without reallocating the temporaries
+         * unless the new grid needs larger ones. Throws if the computation does not support it.
+         */
+        template <class Grid>
+        void rebind_grid(Grid const &grid) {
+            m_impl->rebind_grid(&grid, typeid(Grid));
+        }
+
+        /**
+         * Sets the size of the blocks along i and j that are executed by one thread at a time on the x86 backend.
+         * Throws if the computation does not support it.
+         */
+        void set_tile_size(uint_t i, uint_t j) { m_impl->set_tile_size(i, j); }
+
         template <class Arg>
         enable_if_t<meta::st_contains<meta::list<Args...>, Arg>::value, rt_extent> get_arg_extent(Arg) const {
             return static_cast<_impl::computation_detail::iface_arg<Arg> const &>(*m_impl).get_arg_extent(Arg());
@@ -0,0 +1,99 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../common/tuple_util.hpp"
+#include "accessor_intent.hpp"
+#include "arg.hpp"
+
+/**
+ * @file
+ * Read/write dependencies between computation runs, derived from `get_arg_intent` and the identity of the data stores.
+ * Used by `computation_graph` and by the asynchronous execution of computations.
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace computation_detail {
+            /**
+             * @brief Access of a computation to a single data store.
+             */
+            struct data_store_access {
+                void const *m_ptr;
+                intent m_intent;
+            };
+
+            /**
+             * @brief Two runs conflict if they access the same data store and at least one of them writes it.
+             */
+            inline bool conflicts(
+                std::vector<data_store_access> const &lhs, std::vector<data_store_access> const &rhs) {
+                for (auto const &l : lhs)
+                    for (auto const &r : rhs)
+                        if (l.m_ptr == r.m_ptr && (l.m_intent == intent::inout || r.m_intent == intent::inout))
+                            return true;
+                return false;
+            }
+
+            template <class DataStore>
+            void const *data_store_identity(DataStore const &data_store) {
+                if (!data_store.valid())
+                    throw std::runtime_error("data_store '" + data_store.name() + "' is not valid");
+                return data_store.get_storage_ptr()->get_cpu_ptr();
+            }
+
+            /**
+             * @brief Collects the accesses of `comp` to the data stores bound by `args`. The computation object itself
+             * is recorded as written, such that a computation is never run concurrently with itself.
+             */
+            template <class Computation, class... Args, class... DataStores>
+            std::vector<data_store_access> collect_accesses(
+                Computation const &comp, arg_storage_pair<Args, DataStores> const &... args) {
+                std::vector<data_store_access> res = {{&comp, intent::inout}};
+                (void)(int[]){((void)res.push_back({data_store_identity(args.m_value),
+                                   intent(comp.get_arg_intent(Args()))}),
+                                  0)...,
+                    0};
+                return res;
+            }
+
+            template <class Computation>
+            struct apply_run_f {
+                Computation &m_comp;
+
+                template <class... ArgStoragePairs>
+                void operator()(ArgStoragePairs const &... args) const {
+                    m_comp.run(args...);
+                }
+            };
+
+            /**
+             * @brief Nullary function object that runs a computation with a stored set of data stores.
+             */
+            template <class Computation, class... ArgStoragePairs>
+            struct bound_run_f {
+                Computation *m_comp;
+                std::tuple<ArgStoragePairs...> m_args;
+
+                void operator()() const { tuple_util::apply(apply_run_f<Computation>{*m_comp}, m_args); }
+            };
+
+            template <class Computation, class... Args, class... DataStores>
+            bound_run_f<Computation, arg_storage_pair<Args, DataStores>...> bind_run(
+                Computation &comp, arg_storage_pair<Args, DataStores> const &... args) {
+                return {&comp, std::make_tuple(args...)};
+            }
+        } // namespace computation_detail
+    }     // namespace _impl
+} // namespace gridtools
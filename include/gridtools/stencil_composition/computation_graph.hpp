@@ -0,0 +1,247 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "../common/defs.hpp"
+#include "arg.hpp"
+#include "computation_dependencies.hpp"
+
+/**
+ * @file
+ * Dependency-aware concurrent execution of independent computations.
+ *
+ * A `computation_graph` records computations together with the data stores they are run on. The read/write
+ * dependencies between them are derived from `get_arg_intent` and the identity of the data stores: a node depends on
+ * every previously added node that writes a data store it accesses, or that reads a data store it writes. Nodes without
+ * mutual dependencies form a wave; the nodes of a wave run concurrently, each on its own (nested) OpenMP thread team.
+ *
+ * Teams are sized by a cost model. Initially every node has the cost hint given by the user (1 by default); after a
+ * node was executed its cost is the measured work (wall time times team size) averaged over all runs. Within a wave
+ * the nodes are distributed to the teams by a longest-processing-time-first assignment and the threads are assigned
+ * to the teams such that the work per thread is balanced. The temporaries of the CPU backends hold one slice per
+ * thread: a computation that runs on a team of another size than before reallocates them.
+ *
+ * Only the data stores that are passed to `add` take part in the dependency analysis. Data stores that were bound
+ * at `make_computation` time are invisible to the graph. The same computation object may be added several times,
+ * such nodes are never run concurrently.
+ */
+namespace gridtools {
+    namespace _impl {
+        namespace computation_graph_detail {
+            /**
+             * @brief A group of nodes that is executed sequentially by a team of `m_threads` threads.
+             */
+            struct team {
+                std::vector<std::size_t> m_nodes;
+                double m_load;
+                int m_threads;
+            };
+
+            /**
+             * @brief Distributes nodes with the given costs to at most `max_threads` teams.
+             */
+            inline std::vector<team> plan_teams(
+                std::vector<std::size_t> const &nodes, std::vector<double> const &costs, int max_threads) {
+                // nodes with a negligible cost estimate still occupy a thread
+                constexpr double min_cost = 1e-9;
+                std::size_t n_teams = std::max<std::size_t>(1, std::min<std::size_t>(nodes.size(), max_threads));
+                std::vector<team> res(n_teams, team{{}, 0., 1});
+
+                std::vector<std::size_t> order(nodes.size());
+                for (std::size_t i = 0; i != order.size(); ++i)
+                    order[i] = i;
+                std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+                    return costs[lhs] > costs[rhs];
+                });
+                for (std::size_t i : order) {
+                    auto &dst = *std::min_element(res.begin(), res.end(), [](team const &lhs, team const &rhs) {
+                        return lhs.m_load < rhs.m_load;
+                    });
+                    dst.m_nodes.push_back(nodes[i]);
+                    dst.m_load += std::max(costs[i], min_cost);
+                }
+
+                // every additional thread goes to the team with the highest load per thread
+                for (int spare = max_threads - (int)n_teams; spare > 0; --spare) {
+                    auto &dst = *std::max_element(res.begin(), res.end(), [](team const &lhs, team const &rhs) {
+                        return lhs.m_load / lhs.m_threads < rhs.m_load / rhs.m_threads;
+                    });
+                    ++dst.m_threads;
+                }
+                return res;
+            }
+        } // namespace computation_graph_detail
+    }     // namespace _impl
+
+    /**
+     * @brief Executes a DAG of computations, running independent computations concurrently.
+     *
+     * Usage:
+     *   computation_graph graph;
+     *   graph.add(physics_a, p_in = t, p_out = tend_a);
+     *   graph.add(physics_b, p_in = t, p_out = tend_b);
+     *   graph.add(sum, p_a = tend_a, p_b = tend_b, p_out = t);
+     *   for (int step = 0; step < steps; ++step)
+     *       graph.run();
+     *
+     * Here the first two computations are run concurrently, the third one waits for both of them. The computations
+     * are stored by reference and have to outlive the graph.
+     */
+    class computation_graph {
+        struct node {
+            std::function<void()> m_run;
+            std::vector<_impl::computation_detail::data_store_access> m_accesses;
+            std::vector<std::size_t> m_predecessors;
+            std::size_t m_wave;
+            double m_cost_hint;
+            double m_measured_work;
+            std::size_t m_runs;
+
+            double cost() const { return m_runs ? m_measured_work / m_runs : m_cost_hint; }
+        };
+
+        std::vector<node> m_nodes;
+        std::vector<std::vector<std::size_t>> m_waves;
+        int m_max_threads;
+
+        void run_node(std::size_t id, int threads) {
+            auto &n = m_nodes[id];
+            auto start = std::chrono::steady_clock::now();
+            n.m_run();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            n.m_measured_work += elapsed.count() * threads;
+            ++n.m_runs;
+        }
+
+        void run_wave(std::vector<std::size_t> const &wave) {
+            std::vector<double> costs;
+            for (std::size_t id : wave)
+                costs.push_back(m_nodes[id].cost());
+            auto teams = _impl::computation_graph_detail::plan_teams(wave, costs, m_max_threads);
+            if (teams.size() == 1) {
+                for (std::size_t id : teams.front().m_nodes)
+                    run_node(id, m_max_threads);
+                return;
+            }
+#ifdef _OPENMP
+            int max_active_levels = omp_get_max_active_levels();
+            omp_set_max_active_levels(std::max(max_active_levels, 2));
+            std::exception_ptr error;
+#pragma omp parallel num_threads((int)teams.size())
+            {
+                // in case the runtime provides less threads than requested, the remaining teams are processed
+                // round robin
+                for (std::size_t t = omp_get_thread_num(); t < teams.size(); t += omp_get_num_threads()) {
+                    omp_set_num_threads(teams[t].m_threads);
+                    try {
+                        for (std::size_t id : teams[t].m_nodes)
+                            run_node(id, teams[t].m_threads);
+                    } catch (...) {
+#pragma omp critical(gt_computation_graph_error)
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+            }
+            omp_set_max_active_levels(max_active_levels);
+            if (error)
+                std::rethrow_exception(error);
+#else
+            for (auto const &t : teams)
+                for (std::size_t id : t.m_nodes)
+                    run_node(id, 1);
+#endif
+        }
+
+      public:
+        /**
+         * @param max_threads the total number of threads that is distributed among concurrently running computations
+         */
+        explicit computation_graph(int max_threads = omp_get_max_threads()) : m_max_threads(std::max(max_threads, 1)) {}
+
+        /**
+         * @brief Adds a node that runs `comp` with the given data stores.
+         *
+         * @param comp a `computation` or any object that models it (like the result of `make_computation`)
+         * @return the id of the new node
+         */
+        template <class Computation, class... Args, class... DataStores>
+        std::size_t add(Computation &comp, arg_storage_pair<Args, DataStores> const &... args) {
+            namespace detail = _impl::computation_detail;
+            node n;
+            n.m_run = detail::bind_run(comp, args...);
+            n.m_accesses = detail::collect_accesses(comp, args...);
+            n.m_wave = 0;
+            for (std::size_t id = 0; id != m_nodes.size(); ++id)
+                if (detail::conflicts(m_nodes[id].m_accesses, n.m_accesses)) {
+                    n.m_predecessors.push_back(id);
+                    n.m_wave = std::max(n.m_wave, m_nodes[id].m_wave + 1);
+                }
+            n.m_cost_hint = 1;
+            n.m_measured_work = 0;
+            n.m_runs = 0;
+            if (n.m_wave == m_waves.size())
+                m_waves.emplace_back();
+            m_waves[n.m_wave].push_back(m_nodes.size());
+            m_nodes.push_back(std::move(n));
+            return m_nodes.size() - 1;
+        }
+
+        /**
+         * @brief Runs all nodes once. Dependent nodes are executed in the order they were added.
+         */
+        void run() {
+            for (auto const &wave : m_waves)
+                run_wave(wave);
+        }
+
+        /**
+         * @brief Sets the relative cost that is used for a node until its execution time was measured.
+         */
+        void set_cost_hint(std::size_t id, double cost) { m_nodes.at(id).m_cost_hint = cost; }
+
+        /**
+         * @brief Current cost estimate of a node.
+         */
+        double cost(std::size_t id) const { return m_nodes.at(id).cost(); }
+
+        /**
+         * @brief Forgets all timings, such that the cost hints are used again.
+         */
+        void reset_timings() {
+            for (auto &n : m_nodes) {
+                n.m_measured_work = 0;
+                n.m_runs = 0;
+            }
+        }
+
+        std::size_t size() const { return m_nodes.size(); }
+
+        /**
+         * @brief The nodes on which the given node depends directly.
+         */
+        std::vector<std::size_t> const &predecessors(std::size_t id) const { return m_nodes.at(id).m_predecessors; }
+
+        /**
+         * @brief Groups of mutually independent nodes, in execution order.
+         */
+        std::vector<std::vector<std::size_t>> const &waves() const { return m_waves; }
+
+        int max_threads() const { return m_max_threads; }
+    };
+} // namespace gridtools
@@ -19,14 +19,17 @@
 
 namespace gridtools {
     /** @brief factor determining the length of the "chunks" in an expandable parameters list
-        \tparam Tile The unrlolling factor
+        \tparam Value The unrlolling factor
+        \tparam ConcurrentChunks The number of chunks that are executed concurrently, each by its own team of threads
      */
-    template <size_t Value>
-    struct expand_factor : std::integral_constant<size_t, Value> {};
+    template <size_t Value, size_t ConcurrentChunks = 1>
+    struct expand_factor : std::integral_constant<size_t, Value> {
+        static constexpr size_t concurrent_chunks = ConcurrentChunks;
+    };
 
     template <class>
     struct is_expand_factor : std::false_type {};
 
-    template <size_t Value>
-    struct is_expand_factor<expand_factor<Value>> : std::true_type {};
+    template <size_t Value, size_t ConcurrentChunks>
+    struct is_expand_factor<expand_factor<Value, ConcurrentChunks>> : std::true_type {};
 } // namespace gridtools
@@ -9,8 +9,10 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <exception>
 #include <functional>
 #include <type_traits>
 #include <utility>
@@ -38,6 +40,13 @@ namespace gridtools {
             // expandable parameters (0...ExpandFactor).
             template <size_t I, class Tag>
             struct unrolled_tag;
+        } // namespace expand_detail
+
+        // the unrolled placeholders keep the compute type of the expandable ones
+        template <size_t I, class Tag, class Default>
+        struct tag_compute_type<expand_detail::unrolled_tag<I, Tag>, Default> : tag_compute_type<Tag, Default> {};
+
+        namespace expand_detail {
 
             /*
              * The logic here is the following:
@@ -256,6 +265,52 @@ namespace gridtools {
             void invoke_run(Intermediate &intermediate, Args &&args) {
                 tuple_util::apply(run_f<Intermediate>{intermediate}, std::forward<Args>(args));
             }
+
+            template <class Plh>
+            struct is_expandable_plh : std::false_type {};
+
+            template <class ID, class DataStore, class Location, bool Temporary>
+            struct is_expandable_plh<plh<ID, std::vector<DataStore>, Location, Temporary>> : std::true_type {};
+
+            template <class Plh>
+            GT_META_DEFINE_ALIAS(
+                is_written_by_all_chunks, bool_constant, (!is_tmp_arg<Plh>::value && !is_expandable_plh<Plh>::value));
+
+            // the powers of two that are smaller than `ExpandFactor`, in decreasing order
+            template <size_t ExpandFactor, size_t Factor = 1, bool = (Factor < ExpandFactor)>
+            struct remainder_factors {
+                using type = meta::list<>;
+            };
+
+            template <size_t ExpandFactor, size_t Factor>
+            struct remainder_factors<ExpandFactor, Factor, true> {
+                using type = GT_META_CALL(meta::push_back,
+                    (typename remainder_factors<ExpandFactor, 2 * Factor>::type,
+                        std::integral_constant<size_t, Factor>));
+            };
+
+            template <class... Intermediates, class Grid, class ArgStoragePairs>
+            std::tuple<Intermediates...> make_intermediates(
+                meta::list<Intermediates...>, Grid const &grid, ArgStoragePairs const &arg_storage_pairs) {
+                return std::tuple<Intermediates...>{Intermediates(grid, arg_storage_pairs, false)...};
+            }
+
+            /**
+             * @brief Number of threads of every team if chunks are executed concurrently by `teams` teams.
+             */
+            inline std::vector<int> team_threads(size_t teams) {
+#if defined(_OPENMP) && !defined(GT_USE_THREAD_POOL)
+                const int threads = omp_get_max_threads();
+#else
+                // teams are nested OpenMP parallel regions, the chunks are executed sequentially otherwise
+                const int threads = 1;
+#endif
+                teams = std::max<size_t>(1, std::min<size_t>(teams, threads));
+                std::vector<int> res(teams);
+                for (size_t t = 0; t != teams; ++t)
+                    res[t] = (int)(threads * (t + 1) / teams - threads * t / teams);
+                return res;
+            }
         } // namespace expand_detail
     }     // namespace _impl
     /**
@@ -270,20 +325,35 @@ namespace gridtools {
        in a Single-Stencil-Multiple-Storage way. In order to avoid resource contention usually
        it is convenient to split the execution in multiple stencil, each stencil operating on a chunk
        of the list. Say that we have an expandable parameters list of length 23, and a chunk size of
-       4, we'll execute 5 stencil with a "vector width" of 4, and one stencil with a "vector width"
-       of 3 (23%4).
-
-       This object contains two objects of @ref gridtools::intermediate type, one with a vector width
-       corresponding to the expand factor defined by the user (4 in the previous example), and another
-       one with a vector width of expand_factor%total_parameters (3 in the previous example).
+       8, we'll execute 2 stencils with a "vector width" of 8, and the remaining 7 storages with
+       stencils of "vector width" 4, 2 and 1.
+
+       This object contains one object of @ref gridtools::intermediate type with a vector width corresponding to
+       the expand factor defined by the user (8 in the previous example) and one for every power of two that is
+       smaller than the expand factor, which process the remainder. Their temporaries are shared: an intermediate
+       for a remainder uses the temporaries of the first unrolled storages of a larger one.
+
+       If `ConcurrentChunks` is larger than one, the threads are partitioned into `ConcurrentChunks` teams that
+       execute the full chunks concurrently (nested OpenMP parallelism), every team with its own intermediate and
+       temporaries. This pays off if a single chunk does not scale to all threads. The chunks must be independent,
+       i.e. the computation must not write non-expandable fields. The remainder is executed afterwards by all
+       threads.
      */
     template <size_t ExpandFactor,
         bool IsStateful,
         class Backend,
         class Grid,
         class BoundArgStoragePairs,
-        class MssDescriptors>
+        class MssDescriptors,
+        size_t ConcurrentChunks = 1>
     class intermediate_expand {
+        GT_STATIC_ASSERT(ExpandFactor > 0 && ConcurrentChunks > 0, "invalid expand factor");
+        GT_STATIC_ASSERT(ConcurrentChunks == 1 ||
+                             meta::is_empty<GT_META_CALL(meta::filter,
+                                 (_impl::expand_detail::is_written_by_all_chunks,
+                                     GT_META_CALL(_impl::all_rw_args, MssDescriptors)))>::value,
+            "chunks can be executed concurrently only if the computation writes expandable fields only");
+
         using non_expandable_bound_arg_storage_pairs_t = GT_META_CALL(
             meta::filter, (meta::not_<_impl::expand_detail::is_expandable>::apply, BoundArgStoragePairs));
         using expandable_bound_arg_storage_pairs_t = GT_META_CALL(
@@ -296,17 +366,32 @@ namespace gridtools {
             non_expandable_bound_arg_storage_pairs_t,
             GT_META_CALL(_impl::expand_detail::converted_mss_descriptors, (N, MssDescriptors))>;
 
+        struct converted_intermediate_f {
+            template <class Factor>
+            GT_META_DEFINE_ALIAS(apply, meta::id, converted_intermediate<Factor::value>);
+        };
+
+        using remainder_factors_t = typename _impl::expand_detail::remainder_factors<ExpandFactor>::type;
+        using remainder_intermediates_t = GT_META_CALL(meta::transform,
+            (converted_intermediate_f::template apply, remainder_factors_t));
+
         /// Storages that are expandable, is bound in construction time.
         //
         expandable_bound_arg_storage_pairs_t m_expandable_bound_arg_storage_pairs;
 
-        /// The object of `intermediate` type to which the computation will be delegated.
+        /// Number of threads of the teams that process full chunks concurrently, one team if chunks are sequential.
+        //
+        std::vector<int> m_team_threads;
+
+        /// The objects of `intermediate` type to which the computation of the full chunks will be delegated, one per
+        /// team.
         //
-        converted_intermediate<ExpandFactor> m_intermediate;
+        std::vector<converted_intermediate<ExpandFactor>> m_intermediates;
 
-        /// If the actual size of storages is not divided by `ExpandFactor`, this `intermediate` will process
-        /// reminder.
-        converted_intermediate<1> m_intermediate_remainder;
+        /// If the actual size of storages is not divided by `ExpandFactor`, these `intermediate`s will process
+        /// the remainder, one per power of two smaller than `ExpandFactor` in decreasing order.
+        GT_META_CALL(meta::rename, (meta::ctor<std::tuple<>>::apply, remainder_intermediates_t))
+        m_remainder_intermediates;
 
         typename timer_traits<Backend>::timer_type m_meter;
 
@@ -315,9 +400,146 @@ namespace gridtools {
             std::pair<ExpandableBoundArgStoragePairRefs, NonExpandableBoundArgStoragePairRefs> &&arg_refs)
             // expandable arg_storage_pairs are kept as a class member until run will be called.
             : m_expandable_bound_arg_storage_pairs(std::move(arg_refs.first)),
-              // plain arg_storage_pairs are bound to both intermediates;
-              m_intermediate(grid, arg_refs.second, false), m_intermediate_remainder(grid, arg_refs.second, false),
-              m_meter("NoName") {}
+              m_team_threads(_impl::expand_detail::team_threads(ConcurrentChunks)),
+              // plain arg_storage_pairs are bound to all intermediates;
+              m_remainder_intermediates(
+                  _impl::expand_detail::make_intermediates(remainder_intermediates_t(), grid, arg_refs.second)),
+              m_meter("NoName") {
+            m_intermediates.reserve(m_team_threads.size());
+            if (m_team_threads.size() == 1) {
+                m_intermediates.emplace_back(grid, arg_refs.second, false);
+            } else {
+#if defined(_OPENMP) && !defined(GT_USE_THREAD_POOL)
+                // the temporaries of a team are allocated for the number of threads of the team
+                const int max_threads = omp_get_max_threads();
+                for (int threads : m_team_threads) {
+                    omp_set_num_threads(threads);
+                    m_intermediates.emplace_back(grid, arg_refs.second, false);
+                }
+                omp_set_num_threads(max_threads);
+#endif
+            }
+            share_temporaries(std::integral_constant<size_t, 0>());
+        }
+
+        template <size_t I>
+        enable_if_t<(I < meta::length<remainder_factors_t>::value)> share_temporaries(
+            std::integral_constant<size_t, I>) {
+            // the remainders are executed by all threads, as the chunks if they are not executed by teams
+            if (I > 0)
+                std::get<I>(m_remainder_intermediates).share_temporaries(std::get<0>(m_remainder_intermediates));
+            else if (m_team_threads.size() == 1)
+                std::get<I>(m_remainder_intermediates).share_temporaries(m_intermediates.front());
+            share_temporaries(std::integral_constant<size_t, I + 1>());
+        }
+
+        template <size_t I>
+        enable_if_t<(I == meta::length<remainder_factors_t>::value)> share_temporaries(
+            std::integral_constant<size_t, I>) {}
+
+        struct rebind_grid_f {
+            Grid const &m_grid;
+
+            template <class Intermediate>
+            void operator()(Intermediate &intermediate) const {
+                intermediate.rebind_grid(m_grid);
+            }
+        };
+
+        struct set_tile_size_f {
+            uint_t m_i, m_j;
+
+            template <class Intermediate>
+            void operator()(Intermediate &intermediate) const {
+                intermediate.set_tile_size(m_i, m_j);
+            }
+        };
+
+        // applies `f` to the intermediates of the full chunks, with the number of threads of their teams
+        template <class F>
+        void for_each_team_intermediate(F const &f) {
+            if (m_team_threads.size() == 1) {
+                f(m_intermediates.front());
+            } else {
+#if defined(_OPENMP) && !defined(GT_USE_THREAD_POOL)
+                // the temporaries of a team are allocated for the number of threads of the team
+                const int max_threads = omp_get_max_threads();
+                try {
+                    for (size_t t = 0; t != m_team_threads.size(); ++t) {
+                        omp_set_num_threads(m_team_threads[t]);
+                        f(m_intermediates[t]);
+                    }
+                } catch (...) {
+                    omp_set_num_threads(max_threads);
+                    throw;
+                }
+                omp_set_num_threads(max_threads);
+#endif
+            }
+        }
+
+        template <size_t Factor, class Intermediate, class PlainArgs, class ExpandableArgs>
+        static void run_chunk(Intermediate &intermediate,
+            size_t offset,
+            PlainArgs const &plain_args,
+            ExpandableArgs const &expandable_args) {
+            // form the chunk from expandable_args with the given offset
+            auto converted_args = _impl::expand_detail::convert_arg_storage_pairs<Factor>(offset, expandable_args);
+            // concatenate that chunk with the plain portion of the arguments and invoke the `run` of the intermediate
+            _impl::expand_detail::invoke_run(intermediate, tuple_util::flatten(std::tie(plain_args, converted_args)));
+        }
+
+        template <class PlainArgs, class ExpandableArgs>
+        void run_chunks(size_t chunks, PlainArgs const &plain_args, ExpandableArgs const &expandable_args) {
+            const size_t teams = m_intermediates.size();
+            if (teams == 1) {
+                for (size_t chunk = 0; chunk != chunks; ++chunk)
+                    run_chunk<ExpandFactor>(m_intermediates.front(), chunk * ExpandFactor, plain_args, expandable_args);
+                return;
+            }
+#if defined(_OPENMP) && !defined(GT_USE_THREAD_POOL)
+            const int max_threads = omp_get_max_threads();
+            const int max_active_levels = omp_get_max_active_levels();
+            omp_set_max_active_levels(std::max(max_active_levels, 2));
+            std::exception_ptr error;
+#pragma omp parallel num_threads((int)teams)
+            {
+                // in case the runtime provides less threads than requested, the remaining teams are processed
+                // round robin
+                for (size_t t = omp_get_thread_num(); t < teams; t += omp_get_num_threads()) {
+                    omp_set_num_threads(m_team_threads[t]);
+                    try {
+                        for (size_t chunk = t; chunk < chunks; chunk += teams)
+                            run_chunk<ExpandFactor>(
+                                m_intermediates[t], chunk * ExpandFactor, plain_args, expandable_args);
+                    } catch (...) {
+#pragma omp critical(gt_intermediate_expand_error)
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+            }
+            omp_set_max_active_levels(max_active_levels);
+            omp_set_num_threads(max_threads);
+            if (error)
+                std::rethrow_exception(error);
+#endif
+        }
+
+        template <size_t I, class PlainArgs, class ExpandableArgs>
+        enable_if_t<(I < meta::length<remainder_factors_t>::value)> run_remainder(
+            size_t size, size_t offset, PlainArgs const &plain_args, ExpandableArgs const &expandable_args) {
+            static constexpr size_t factor = GT_META_CALL(meta::at_c, (remainder_factors_t, I))::value;
+            if (size - offset >= factor) {
+                run_chunk<factor>(std::get<I>(m_remainder_intermediates), offset, plain_args, expandable_args);
+                offset += factor;
+            }
+            run_remainder<I + 1>(size, offset, plain_args, expandable_args);
+        }
+
+        template <size_t I, class PlainArgs, class ExpandableArgs>
+        enable_if_t<(I == meta::length<remainder_factors_t>::value)> run_remainder(
+            size_t, size_t, PlainArgs const &, ExpandableArgs const &) {}
 
       public:
         template <class BoundArgStoragePairsRefs>
@@ -339,25 +561,37 @@ namespace gridtools {
             // extract size from the vectors within expandable args.
             // if vectors are not of the same length assert within `get_expandable_size` fails.
             size_t size = _impl::expand_detail::get_expandable_size(expandable_args);
-            size_t offset = 0;
-            for (; size - offset >= ExpandFactor; offset += ExpandFactor) {
-                // form the chunks from expandable_args with the given offset
-                auto converted_args =
-                    _impl::expand_detail::convert_arg_storage_pairs<ExpandFactor>(offset, expandable_args);
-                // concatenate that chunk with the plain portion of the arguments
-                // and invoke the `run` of the `m_intermediate`.
-                _impl::expand_detail::invoke_run(
-                    m_intermediate, tuple_util::flatten(std::tie(plain_args, converted_args)));
-            }
-            // process the reminder the same way
-            for (; offset < size; ++offset) {
-                auto converted_args = _impl::expand_detail::convert_arg_storage_pairs<1>(offset, expandable_args);
-                _impl::expand_detail::invoke_run(
-                    m_intermediate_remainder, tuple_util::flatten(std::tie(plain_args, converted_args)));
-            }
+            const size_t chunks = size / ExpandFactor;
+            run_chunks(chunks, plain_args, expandable_args);
+            // process the remainder with the binary decomposition of its size
+            run_remainder<0>(size, chunks * ExpandFactor, plain_args, expandable_args);
             m_meter.pause();
         }
 
+        Grid const &grid() const { return m_intermediates.front().grid(); }
+
+        /**
+         * Rebinds all intermediates to `grid`, see `intermediate::rebind_grid`. The temporaries are shared again
+         * afterwards, as some of them might have been reallocated.
+         */
+        void rebind_grid(Grid const &grid) {
+            for_each_team_intermediate(rebind_grid_f{grid});
+            tuple_util::for_each(rebind_grid_f{grid}, m_remainder_intermediates);
+            share_temporaries(std::integral_constant<size_t, 0>());
+        }
+
+        /**
+         * Sets the tile size of all intermediates, see `intermediate::set_tile_size`. The temporaries are shared
+         * again afterwards.
+         */
+        template <class B = Backend>
+        auto set_tile_size(uint_t i, uint_t j)
+            -> decltype(::gridtools::set_tile_size(std::declval<B &>(), i, j), void()) {
+            for_each_team_intermediate(set_tile_size_f{i, j});
+            tuple_util::for_each(set_tile_size_f{i, j}, m_remainder_intermediates);
+            share_temporaries(std::integral_constant<size_t, 0>());
+        }
+
         std::string print_meter() const { return m_meter.to_string(); }
 
         double get_time() const { return m_meter.total_time(); }
@@ -18,14 +18,14 @@
 namespace gridtools {
     namespace _impl {
 
-        template <uint_t Factor, bool IsStateful, class Backend>
+        template <uint_t Factor, bool IsStateful, class Backend, size_t ConcurrentChunks = 1>
         struct make_intermediate_expand_f {
             template <class Grid,
                 class... Args,
                 class ArgsPair = decltype(split_args<is_arg_storage_pair>(std::forward<Args>(std::declval<Args>())...)),
                 class ArgStoragePairs = GT_META_CALL(decay_elements, typename ArgsPair::first_type),
                 class Msses = GT_META_CALL(decay_elements, typename ArgsPair::second_type)>
-            intermediate_expand<Factor, IsStateful, Backend, Grid, ArgStoragePairs, Msses> operator()(
+            intermediate_expand<Factor, IsStateful, Backend, Grid, ArgStoragePairs, Msses, ConcurrentChunks> operator()(
                 Grid const &grid, Args &&... args) const {
                 // split arg_storage_pair and mss descriptor arguments and forward it to intermediate constructor
                 auto &&args_pair = split_args<is_arg_storage_pair>(std::forward<Args>(args)...);
@@ -43,16 +43,29 @@ namespace gridtools {
 
     /// generator for intermediate/intermediate_expand
     ///
-    template <class Backend, class Grid, size_t N, class Arg, class... Args, enable_if_t<is_grid<Grid>::value, int> = 0>
-    auto make_expandable_computation(expand_factor<N>, Grid const &grid, Arg &&arg, Args &&... args)
-        GT_AUTO_RETURN((_impl::make_intermediate_expand_f<N, GT_POSITIONAL_WHEN_DEBUGGING, Backend>{}(
+    template <class Backend,
+        class Grid,
+        size_t N,
+        size_t ConcurrentChunks,
+        class Arg,
+        class... Args,
+        enable_if_t<is_grid<Grid>::value, int> = 0>
+    auto make_expandable_computation(expand_factor<N, ConcurrentChunks>, Grid const &grid, Arg &&arg, Args &&... args)
+        GT_AUTO_RETURN((_impl::make_intermediate_expand_f<N, GT_POSITIONAL_WHEN_DEBUGGING, Backend, ConcurrentChunks>{}(
             grid, std::forward<Arg>(arg), std::forward<Args>(args)...)));
 
 #undef GT_POSITIONAL_WHEN_DEBUGGING
 
-    template <class Backend, class Grid, size_t N, class Arg, class... Args, enable_if_t<is_grid<Grid>::value, int> = 0>
-    auto make_expandable_positional_computation(expand_factor<N>, Grid const &grid, Arg &&arg, Args &&... args)
-        GT_AUTO_RETURN((_impl::make_intermediate_expand_f<N, true, Backend>{}(
+    template <class Backend,
+        class Grid,
+        size_t N,
+        size_t ConcurrentChunks,
+        class Arg,
+        class... Args,
+        enable_if_t<is_grid<Grid>::value, int> = 0>
+    auto make_expandable_positional_computation(
+        expand_factor<N, ConcurrentChunks>, Grid const &grid, Arg &&arg, Args &&... args)
+        GT_AUTO_RETURN((_impl::make_intermediate_expand_f<N, true, Backend, ConcurrentChunks>{}(
             grid, std::forward<Arg>(arg), std::forward<Args>(args)...)));
 
     // user protection only, catch the case where no backend is specified
@@ -0,0 +1,270 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include "../common/defs.hpp"
+#include "../common/tuple_util.hpp"
+#include "../meta.hpp"
+#include "arg.hpp"
+#include "caches/cache.hpp"
+#include "extract_placeholders.hpp"
+#include "intermediate.hpp"
+#include "intermediate_impl.hpp"
+
+/**
+ * @file
+ * Fusion of computations that are executed one after another into a single computation.
+ *
+ * `fuse_computations(comp_a, comp_b, ...)` creates one `intermediate` whose multi-stage stencils are the
+ * concatenation of the multi-stage stencils of the given computations. The fused computation traverses the domain
+ * once: all stages of all computations are executed per block (see `fused_mss_loop`).
+ *
+ * The temporaries of the computations stay independent of each other. Fields that are only used to pass data from
+ * one computation to the next can be turned into temporaries with `as_temporaries(p_field, ...)`; they are then no
+ * longer passed to `run` and do not need a data store:
+ *
+ *     auto fused = fuse_computations(as_temporaries(p_tendency), tendency_comp, update_comp);
+ *     fused.run(p_u = u, p_u_new = u_new);
+ *
+ * A field that is written by one of the computations and accessed by another one has to be accessed without
+ * horizontal offsets, otherwise blocks would see partially updated neighbor blocks. This is checked at compile time;
+ * fields turned into temporaries are exempt, their producing stages are extended by the offsets as usual.
+ * All computations have to be defined on the same grid and backend.
+ */
+namespace gridtools {
+    /**
+     * @brief Placeholders that become temporaries of a fused computation, see `as_temporaries`.
+     */
+    template <class... Placeholders>
+    struct fused_temporaries {};
+
+    template <class... Placeholders>
+    fused_temporaries<Placeholders...> as_temporaries(Placeholders...) {
+        return {};
+    }
+
+    namespace _impl {
+        namespace fuse_computations_detail {
+            /**
+             * @brief Tag of the I-th computation's temporary with tag `Tag`.
+             */
+            template <size_t I, class Tag>
+            struct fused_tmp_tag;
+
+            /**
+             * @brief Tag of a field that was promoted to a temporary.
+             */
+            template <class Tag>
+            struct promoted_tag;
+        } // namespace fuse_computations_detail
+
+        // the renamed placeholders keep the compute type of the original ones
+        template <size_t I, class Tag, class Default>
+        struct tag_compute_type<fuse_computations_detail::fused_tmp_tag<I, Tag>, Default>
+            : tag_compute_type<Tag, Default> {};
+
+        template <class Tag, class Default>
+        struct tag_compute_type<fuse_computations_detail::promoted_tag<Tag>, Default>
+            : tag_compute_type<Tag, Default> {};
+
+        namespace fuse_computations_detail {
+
+            /**
+             * @brief Applies the metafunction class `F` to all placeholders within `T`.
+             */
+            template <class F, class T>
+            struct transform_plhs {
+                using type = T;
+            };
+
+            template <class F, class Tag, class DataStore, class Location, bool Temporary>
+            struct transform_plhs<F, plh<Tag, DataStore, Location, Temporary>> {
+                using type = typename F::template apply<plh<Tag, DataStore, Location, Temporary>>::type;
+            };
+
+            template <class F, cache_type CacheType, class Arg, cache_io_policy CacheIOPolicy>
+            struct transform_plhs<F, detail::cache_impl<CacheType, Arg, CacheIOPolicy>> {
+                using type = detail::cache_impl<CacheType, typename transform_plhs<F, Arg>::type, CacheIOPolicy>;
+            };
+
+            template <class F, template <class...> class L, class... Ts>
+            struct transform_plhs<F, L<Ts...>> {
+                using type = L<typename transform_plhs<F, Ts>::type...>;
+            };
+
+            /**
+             * @brief Renames the temporaries of the I-th computation and turns the `Promoted` fields into temporaries.
+             */
+            template <size_t I, class Promoted>
+            struct rename_plh_f {
+                template <class Plh, class = void>
+                struct apply {
+                    using type = Plh;
+                };
+
+                template <class Tag, class DataStore, class Location>
+                struct apply<plh<Tag, DataStore, Location, true>> {
+                    using type = plh<fused_tmp_tag<I, Tag>, DataStore, Location, true>;
+                };
+
+                template <class Tag, class DataStore, class Location>
+                struct apply<plh<Tag, DataStore, Location, false>,
+                    enable_if_t<meta::st_contains<Promoted, plh<Tag, DataStore, Location, false>>::value>> {
+                    using type = plh<promoted_tag<Tag>,
+                        typename tmp_data_store<tmp_storage_info_id<Location>::value, DataStore>::type,
+                        Location,
+                        true>;
+                };
+            };
+
+            template <class>
+            struct bound_placeholders;
+
+            template <class... Placeholders, class... DataStores>
+            struct bound_placeholders<std::tuple<arg_storage_pair<Placeholders, DataStores>...>> {
+                using type = meta::list<Placeholders...>;
+            };
+
+            template <class>
+            struct intermediate_traits;
+
+            template <bool IsStateful, class Backend, class Grid, class BoundArgStoragePairs, class Msses>
+            struct intermediate_traits<intermediate<IsStateful, Backend, Grid, BoundArgStoragePairs, Msses>> {
+                static constexpr bool is_stateful = IsStateful;
+                using backend_t = Backend;
+                using grid_t = Grid;
+                using bound_arg_storage_pairs_t = BoundArgStoragePairs;
+                using msses_t = Msses;
+                using placeholders_t = GT_META_CALL(extract_placeholders_from_msses, Msses);
+                using rw_args_t = GT_META_CALL(all_rw_args, Msses);
+                using bound_placeholders_t = typename bound_placeholders<BoundArgStoragePairs>::type;
+            };
+
+            template <class Plh, class... RwArgs>
+            struct count_writers;
+
+            template <class Plh>
+            struct count_writers<Plh> : std::integral_constant<int, 0> {};
+
+            template <class Plh, class RwArgs, class... Rest>
+            struct count_writers<Plh, RwArgs, Rest...>
+                : std::integral_constant<int,
+                      (meta::st_contains<RwArgs, Plh>::value ? 1 : 0) + count_writers<Plh, Rest...>::value> {};
+
+            /**
+             * @brief Checks that the fields of `Intermediate` that are written by another computation are accessed
+             * without horizontal offsets.
+             */
+            template <class Intermediate, class Promoted, class... AllRwArgs>
+            struct is_fusable {
+                using traits_t = intermediate_traits<Intermediate>;
+
+                template <class Plh,
+                    class Extent = decltype(Intermediate::get_arg_extent(Plh())),
+                    int OtherWriters = count_writers<Plh, AllRwArgs...>::value -
+                                       (meta::st_contains<typename traits_t::rw_args_t, Plh>::value ? 1 : 0)>
+                struct is_safe_impl
+                    : bool_constant<is_tmp_arg<Plh>::value || meta::st_contains<Promoted, Plh>::value ||
+                                    OtherWriters == 0 ||
+                                    (Extent::iminus::value == 0 && Extent::iplus::value == 0 &&
+                                        Extent::jminus::value == 0 && Extent::jplus::value == 0)> {};
+
+                template <class Plh>
+                struct is_safe : is_safe_impl<Plh> {};
+
+                static constexpr bool value = meta::all_of<is_safe, typename traits_t::placeholders_t>::value;
+            };
+
+            template <class Promoted,
+                class Intermediates,
+                class Indices = GT_META_CALL(meta::make_indices_for, Intermediates)>
+            struct fused_intermediate;
+
+            template <class Promoted, class... Intermediates, class... Indices>
+            struct fused_intermediate<Promoted, meta::list<Intermediates...>, meta::list<Indices...>> {
+                using traits_t = intermediate_traits<GT_META_CALL(meta::first, meta::list<Intermediates...>)>;
+                using type = intermediate<traits_t::is_stateful,
+                    typename traits_t::backend_t,
+                    typename traits_t::grid_t,
+                    GT_META_CALL(
+                        meta::concat, (typename intermediate_traits<Intermediates>::bound_arg_storage_pairs_t...)),
+                    GT_META_CALL(meta::concat,
+                        (typename transform_plhs<rename_plh_f<Indices::value, Promoted>,
+                            typename intermediate_traits<Intermediates>::msses_t>::type...))>;
+            };
+
+            template <class Grid>
+            void check_same_grid(Grid const &lhs, Grid const &rhs) {
+                if (!(lhs.direction_i() == rhs.direction_i() && lhs.direction_j() == rhs.direction_j() &&
+                        lhs.value_list == rhs.value_list))
+                    throw std::runtime_error("fuse_computations: all computations have to be defined on the same grid");
+            }
+        } // namespace fuse_computations_detail
+    }     // namespace _impl
+
+    /**
+     * @brief Fuses the computations into a single computation that turns the fields `Promoted` into temporaries.
+     */
+    template <class... Promoted, class First, class... Intermediates>
+    typename _impl::fuse_computations_detail::fused_intermediate<meta::list<Promoted...>,
+        meta::list<First, Intermediates...>>::type
+    fuse_computations(fused_temporaries<Promoted...>, First const &first, Intermediates const &... intermediates) {
+        using namespace _impl::fuse_computations_detail;
+        using promoted_t = meta::list<Promoted...>;
+        GT_STATIC_ASSERT(
+            (conjunction<std::is_same<typename intermediate_traits<First>::backend_t,
+                typename intermediate_traits<Intermediates>::backend_t>...>::value),
+            "fused computations should use the same backend");
+        GT_STATIC_ASSERT(
+            (conjunction<std::is_same<typename intermediate_traits<First>::grid_t,
+                typename intermediate_traits<Intermediates>::grid_t>...>::value),
+            "fused computations should use the same grid type");
+        GT_STATIC_ASSERT((conjunction<bool_constant<!is_tmp_arg<Promoted>::value>...>::value),
+            "only non-temporary fields can be turned into temporaries");
+        GT_STATIC_ASSERT(
+            (conjunction<bool_constant<count_writers<Promoted,
+                 typename intermediate_traits<First>::rw_args_t,
+                 typename intermediate_traits<Intermediates>::rw_args_t...>::value != 0>...>::value),
+            "fields that are turned into temporaries should be written by one of the computations");
+        GT_STATIC_ASSERT(
+            (conjunction<bool_constant<count_writers<Promoted,
+                 typename intermediate_traits<First>::bound_placeholders_t,
+                 typename intermediate_traits<Intermediates>::bound_placeholders_t...>::value == 0>...>::value),
+            "fields that are turned into temporaries should not be bound to a data store");
+        GT_STATIC_ASSERT((conjunction<is_fusable<First,
+                                          promoted_t,
+                                          typename intermediate_traits<First>::rw_args_t,
+                                          typename intermediate_traits<Intermediates>::rw_args_t...>,
+                             is_fusable<Intermediates,
+                                 promoted_t,
+                                 typename intermediate_traits<First>::rw_args_t,
+                                 typename intermediate_traits<Intermediates>::rw_args_t...>...>::value),
+            "a field that is written by one of the fused computations is accessed with horizontal offsets by another "
+            "one; turn it into a temporary with as_temporaries or do not fuse the computations");
+
+        (void)(int[]){(check_same_grid(first.grid(), intermediates.grid()), 0)..., 0};
+        return {first.grid(),
+            tuple_util::flatten(
+                std::make_tuple(first.bound_arg_storage_pairs(), intermediates.bound_arg_storage_pairs()...))};
+    }
+
+    /**
+     * @brief Fuses the computations into a single computation.
+     */
+    template <class First,
+        class... Intermediates,
+        enable_if_t<!meta::is_instantiation_of<fused_temporaries, First>::value, int> = 0>
+    auto fuse_computations(First const &first, Intermediates const &... intermediates)
+        GT_AUTO_RETURN(fuse_computations(fused_temporaries<>(), first, intermediates...));
+} // namespace gridtools
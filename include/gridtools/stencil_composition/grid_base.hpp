@@ -9,6 +9,9 @@
  */
 
 #pragma once
+
+#include <type_traits>
+
 #include "../common/array.hpp"
 #include "../common/halo_descriptor.hpp"
 #include "axis.hpp"
@@ -31,10 +34,16 @@ namespace gridtools {
         }
     } // namespace _impl
 
-    template <typename Axis>
+    /**
+     * @tparam Axis the interval that spans the whole axis
+     * @tparam StaticSplitters void, or the static_splitters of a static_axis: the vertical bounds are then compile time
+     * constants, value_list has to hold the same values
+     */
+    template <typename Axis, class StaticSplitters = void>
     struct grid_base {
         GT_STATIC_ASSERT((is_interval<Axis>::value), GT_INTERNAL_ERROR);
         typedef Axis axis_type;
+        typedef StaticSplitters static_splitters_t;
 
         static constexpr int_t size = Axis::ToLevel::splitter - Axis::FromLevel::splitter + 1;
 
@@ -44,6 +53,16 @@ namespace gridtools {
         halo_descriptor m_direction_i;
         halo_descriptor m_direction_j;
 
+        template <uint_t Splitter, class Splitters = StaticSplitters>
+        GT_FUNCTION enable_if_t<std::is_void<Splitters>::value, uint_t> splitter() const {
+            return value_list[Splitter];
+        }
+
+        template <uint_t Splitter, class Splitters = StaticSplitters>
+        GT_FUNCTION enable_if_t<!std::is_void<Splitters>::value, uint_t> splitter() const {
+            return std::integral_constant<uint_t, Splitters::at(Splitter)>::value;
+        }
+
       public:
         /**
          * @brief standard ctor
@@ -72,13 +91,13 @@ namespace gridtools {
         template <class Level, int_t Offset = Level::offset>
         GT_FUNCTION enable_if_t<(Offset > 0), uint_t> value_at() const {
             GT_STATIC_ASSERT((is_level<Level>::value), GT_INTERNAL_ERROR);
-            return value_list[Level::splitter] + Offset - 1;
+            return splitter<Level::splitter>() + Offset - 1;
         }
 
         template <class Level, int_t Offset = Level::offset>
         GT_FUNCTION enable_if_t<(Offset <= 0), uint_t> value_at() const {
             GT_STATIC_ASSERT((is_level<Level>::value), GT_INTERNAL_ERROR);
-            return value_list[Level::splitter] - static_cast<uint_t>(-Offset);
+            return splitter<Level::splitter>() - static_cast<uint_t>(-Offset);
         }
 
         GT_FUNCTION uint_t k_min() const { return value_at<typename Axis::FromLevel>(); }
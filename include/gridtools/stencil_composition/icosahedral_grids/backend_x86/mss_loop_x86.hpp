@@ -107,7 +107,8 @@ namespace gridtools {
             {execution_info.bi, execution_info.bj, 0},
             {extent_t::iminus::value,
                 extent_t::jminus::value,
-                static_cast<int_t>(grid.template value_at<from_t>() - grid.k_min())});
+                static_cast<int_t>(grid.template value_at<from_t>() - grid.k_min())},
+            backend_target);
 
         auto block_size_f = [](uint_t total, uint_t block_size, uint_t block_no) {
             auto n = (total + block_size - 1) / block_size;
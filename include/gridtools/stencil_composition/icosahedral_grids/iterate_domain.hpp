@@ -62,11 +62,12 @@ namespace gridtools {
       public:
         static constexpr bool has_k_caches = false;
 
-        /**@brief method for initializing the index */
-        GT_FUNCTION void initialize(pos3<uint_t> begin, pos3<uint_t> block_no, pos3<int_t> pos_in_block) {
+        /**@brief method for initializing the index, `backend` provides the block size */
+        GT_FUNCTION void initialize(
+            pos3<uint_t> begin, pos3<uint_t> block_no, pos3<int_t> pos_in_block, backend_t const &backend = {}) {
             host_device::for_each_type<typename local_domain_t::strides_kinds_t>(
                 initialize_index<backend_t, local_domain_t>(
-                    m_local_domain.m_strides_map, begin, block_no, pos_in_block, m_index));
+                    m_local_domain.m_strides_map, backend, begin, block_no, pos_in_block, m_index));
         }
 
         template <class Offset = integral_constant<int_t, 1>>
@@ -9,13 +9,18 @@
  */
 #pragma once
 
+#include <future>
 #include <memory>
+#include <stdexcept>
 #include <tuple>
 #include <utility>
 
+#include "../common/thread_pool.hpp"
 #include "../common/timer/timer_traits.hpp"
 #include "../common/tuple_util.hpp"
 #include "../meta.hpp"
+#include "async_executor.hpp"
+#include "caches/automatic_caches.hpp"
 #include "compute_extents_metafunctions.hpp"
 #include "dim.hpp"
 #include "esf.hpp"
@@ -27,6 +32,11 @@
 #include "local_domain.hpp"
 #include "mss_components_metafunctions.hpp"
 
+#ifndef GT_ICOSAHEDRAL_GRIDS
+#include "column_mask.hpp"
+#include "memoization.hpp"
+#endif
+
 /**
  * @file
  * \brief this file contains mainly helper metafunctions which simplify the interface for the application developer
@@ -115,7 +125,14 @@ namespace gridtools {
         GT_STATIC_ASSERT(conjunction<is_mss_descriptor<MssDescriptors>...>::value,
             "make_computation args should be mss descriptors");
 
+#if defined(GT_ICOSAHEDRAL_GRIDS)
         using mss_descriptors_t = std::tuple<MssDescriptors...>;
+#elif defined(GT_ENABLE_AUTOMATIC_CACHES)
+        using mss_descriptors_t = GT_META_CALL(
+            add_automatic_caches, (GT_META_CALL(expand_memoized_stages, std::tuple<MssDescriptors...>)));
+#else
+        using mss_descriptors_t = GT_META_CALL(expand_memoized_stages, std::tuple<MssDescriptors...>);
+#endif
 
         using performance_meter_t = typename timer_traits<Backend>::timer_type;
 
@@ -173,12 +190,18 @@ namespace gridtools {
 
         Grid m_grid;
 
+        /// the backend object, it holds the runtime parameters of the backend (e.g. the tile size of x86)
+        Backend m_backend;
+
         std::unique_ptr<performance_meter_t> m_meter;
 
         /// tuple with temporary storages
         //
         tmp_arg_storage_pair_tuple_t m_tmp_arg_storage_pair_tuple;
 
+        /// the number of threads the temporaries are allocated for, if they hold a slice per thread
+        int m_tmp_threads;
+
         /// tuple with storages that are bound during costruction
         //  Each item holds a storage and its view
         bound_arg_storage_pair_tuple_t m_bound_arg_storage_pair_tuple;
@@ -189,14 +212,32 @@ namespace gridtools {
 
         struct check_grid_against_extents_f {
             Grid const &m_grid;
+            bool &m_res;
 
             template <class Placeholder>
             void operator()() const {
                 using extent_t = decltype(intermediate::get_arg_extent(Placeholder()));
-                assert(-extent_t::iminus::value <= static_cast<int_t>(m_grid.direction_i().minus()));
-                assert(extent_t::iplus::value <= static_cast<int_t>(m_grid.direction_i().plus()));
-                assert(-extent_t::jminus::value <= static_cast<int_t>(m_grid.direction_j().minus()));
-                assert(extent_t::jplus::value <= static_cast<int_t>(m_grid.direction_j().plus()));
+                m_res = m_res && -extent_t::iminus::value <= static_cast<int_t>(m_grid.direction_i().minus()) &&
+                        extent_t::iplus::value <= static_cast<int_t>(m_grid.direction_i().plus()) &&
+                        -extent_t::jminus::value <= static_cast<int_t>(m_grid.direction_j().minus()) &&
+                        extent_t::jplus::value <= static_cast<int_t>(m_grid.direction_j().plus());
+            }
+        };
+
+        // the halos of the grid have to cover the extents of all non-temporary fields
+        static bool grid_covers_extents(Grid const &grid) {
+            bool res = true;
+            for_each_type<non_tmp_placeholders_t>(check_grid_against_extents_f{grid, res});
+            return res;
+        }
+
+        struct check_bound_storage_f {
+            Grid const &m_grid;
+            bool &m_res;
+
+            template <class ArgStoragePair>
+            void operator()(ArgStoragePair const &src) const {
+                m_res = m_res && storage_info_fits_grid<Backend>(m_grid)(*src.m_value.get_storage_info_ptr());
             }
         };
 
@@ -206,16 +247,18 @@ namespace gridtools {
             bool timer_enabled = true)
             // grid just stored to the member
             : m_grid(grid),
+              // the runtime parameters of the backend, e.g. from the environment
+              m_backend(configure_backend(Backend{})),
               // here we create temporary storages.
               m_tmp_arg_storage_pair_tuple(
-                  _impl::make_tmp_arg_storage_pairs<max_extent_for_tmp_t, Backend, tmp_arg_storage_pair_tuple_t>(grid)),
+                  _impl::make_tmp_arg_storage_pairs<max_extent_for_tmp_t, tmp_arg_storage_pair_tuple_t>(
+                      m_backend, grid)),
+              m_tmp_threads(host_max_threads()),
               // stash bound storages
               m_bound_arg_storage_pair_tuple(std::move(arg_storage_pairs)) {
             if (timer_enabled)
                 m_meter.reset(new performance_meter_t{"NoName"});
-#ifndef NDEBUG
-            for_each_type<non_tmp_placeholders_t>(check_grid_against_extents_f{m_grid});
-#endif
+            assert(grid_covers_extents(m_grid));
         }
 
         // TODO(anstaf): introduce overload that takes a tuple of arg_storage_pair's. it will simplify a bit
@@ -228,14 +271,53 @@ namespace gridtools {
                 "some placeholders are not used in mss descriptors");
             GT_STATIC_ASSERT(
                 meta::is_set_fast<meta::list<Args...>>::value, "free placeholders should be all different");
-            static constexpr auto backend_target = Backend{};
             if (m_meter)
                 m_meter->start();
-            fused_mss_loop<mss_components_array_t>(backend_target, local_domains(srcs...), m_grid);
+            fused_mss_loop<mss_components_array_t>(m_backend, local_domains(srcs...), m_grid);
             if (m_meter)
                 m_meter->pause();
         }
 
+#ifndef GT_ICOSAHEDRAL_GRIDS
+        /**
+         * Runs the computation on the active columns of `mask` only (CPU backends). The values of the fields outside
+         * of the active columns are not modified. The mask has to cover the compute domain of the grid.
+         *
+         * This is not an overload of `run`, such that `&intermediate::run<>` keeps naming a single function.
+         */
+        template <class... Args, class... DataStores>
+        enable_if_t<sizeof...(Args) == meta::length<free_placeholders_t>::value> run_masked(
+            column_mask const &mask, arg_storage_pair<Args, DataStores> const &... srcs) {
+            GT_STATIC_ASSERT((conjunction<meta::st_contains<free_placeholders_t, Args>...>::value),
+                "some placeholders are not used in mss descriptors");
+            GT_STATIC_ASSERT(
+                meta::is_set_fast<meta::list<Args...>>::value, "free placeholders should be all different");
+            if (mask.i_size() != m_grid.i_high_bound() - m_grid.i_low_bound() + 1 ||
+                mask.j_size() != m_grid.j_high_bound() - m_grid.j_low_bound() + 1)
+                throw std::runtime_error("column_mask: the mask does not match the compute domain of the grid");
+            if (m_meter)
+                m_meter->start();
+            fused_mss_loop<mss_components_array_t>(m_backend, local_domains(srcs...), m_grid, mask);
+            if (m_meter)
+                m_meter->pause();
+        }
+#endif
+
+        /**
+         * Non-blocking version of `run`, see `async_executor` for the ordering guarantees.
+         */
+        template <class... Args, class... DataStores>
+        enable_if_t<sizeof...(Args) == meta::length<free_placeholders_t>::value, std::future<void>> run_async(
+            arg_storage_pair<Args, DataStores> const &... srcs) {
+            return run_async(async_executor::get_default(), srcs...);
+        }
+
+        template <class... Args, class... DataStores>
+        enable_if_t<sizeof...(Args) == meta::length<free_placeholders_t>::value, std::future<void>> run_async(
+            async_executor &executor, arg_storage_pair<Args, DataStores> const &... srcs) {
+            return executor.submit(*this, srcs...);
+        }
+
         std::string print_meter() const {
             assert(m_meter);
             return m_meter->to_string();
@@ -256,6 +338,58 @@ namespace gridtools {
             m_meter->reset();
         }
 
+        Grid const &grid() const { return m_grid; }
+
+        /**
+         * Rebinds the computation to another grid of the same type, e.g. to a sub-domain of another size. The
+         * temporaries are reused if they are large enough for the new grid and reallocated otherwise, such that
+         * alternating between grids that are not larger than the ones seen before does not allocate.
+         */
+        void rebind_grid(Grid const &grid) {
+            if (!grid_covers_extents(grid))
+                throw std::runtime_error("rebind_grid: the halos of the grid do not cover the extents of the fields");
+            bool bound_storages_fit = true;
+            tuple_util::for_each(check_bound_storage_f{grid, bound_storages_fit}, m_bound_arg_storage_pair_tuple);
+            if (!bound_storages_fit)
+                throw std::runtime_error("rebind_grid: the grid exceeds the bound data stores");
+            tuple_util::for_each(
+                _impl::rebind_tmp_arg_storage_pair_f<max_extent_for_tmp_t, Backend, Grid>{m_backend, grid},
+                m_tmp_arg_storage_pair_tuple);
+            m_grid = grid;
+        }
+
+        /**
+         * Sets the size of the blocks (tiles) along i and j that are executed by one thread at a time, for backends
+         * with a runtime tile size (x86). The temporaries are reallocated only if they are too small for the new tile.
+         */
+        template <class B = Backend>
+        auto set_tile_size(uint_t i, uint_t j)
+            -> decltype(::gridtools::set_tile_size(std::declval<B &>(), i, j), void()) {
+            ::gridtools::set_tile_size(m_backend, i, j);
+            tuple_util::for_each(
+                _impl::rebind_tmp_arg_storage_pair_f<max_extent_for_tmp_t, Backend, Grid>{m_backend, m_grid},
+                m_tmp_arg_storage_pair_tuple);
+        }
+
+        Backend const &backend() const { return m_backend; }
+
+        std::tuple<arg_storage_pair<BoundPlaceholders, BoundDataStores>...> const &bound_arg_storage_pairs() const {
+            return m_bound_arg_storage_pair_tuple;
+        }
+
+        tmp_arg_storage_pair_tuple_t const &tmp_arg_storage_pairs() const { return m_tmp_arg_storage_pair_tuple; }
+
+        /**
+         * Uses the temporary storages of `other` for the temporaries with the same placeholder and size, such that
+         * computations that never run concurrently need to allocate them only once.
+         */
+        template <class Other>
+        void share_temporaries(Other const &other) {
+            using srcs_t = decay_t<decltype(other.tmp_arg_storage_pairs())>;
+            tuple_util::for_each(_impl::share_tmp_arg_storage_pair_f<srcs_t>{other.tmp_arg_storage_pairs()},
+                m_tmp_arg_storage_pair_tuple);
+        }
+
         template <class Placeholder,
             class RwArgs = GT_META_CALL(_impl::all_rw_args, mss_descriptors_t),
             intent Intent = meta::st_contains<RwArgs, Placeholder>::value ? intent::inout : intent::in>
@@ -269,8 +403,22 @@ namespace gridtools {
             return {};
         }
 
+        /**
+         * Reallocates the temporaries if they hold a slice per thread and the computation is run with another number
+         * of threads than they were allocated for, e.g. by a team of a computation_graph or by an async_executor.
+         */
+        void fit_temporaries_to_threads() {
+            if (!GT_META_CALL(tmp_sized_per_thread, Backend)::value || host_max_threads() == m_tmp_threads)
+                return;
+            m_tmp_threads = host_max_threads();
+            m_tmp_arg_storage_pair_tuple =
+                _impl::make_tmp_arg_storage_pairs<max_extent_for_tmp_t, tmp_arg_storage_pair_tuple_t>(
+                    m_backend, m_grid);
+        }
+
         template <class... Args, class... DataStores>
         local_domains_t const &local_domains(arg_storage_pair<Args, DataStores> const &... srcs) {
+            fit_temporaries_to_threads();
             _impl::update_local_domains(
                 tuple_util::flatten(
                     std::make_tuple(m_tmp_arg_storage_pair_tuple, m_bound_arg_storage_pair_tuple, std::tie(srcs...))),
@@ -73,8 +73,7 @@ namespace gridtools {
             template <class ArgStoragePair>
             struct generator {
                 template <class Grid>
-                ArgStoragePair operator()(Grid const &grid) const {
-                    static constexpr auto backend = Backend{};
+                ArgStoragePair operator()(Backend const &backend, Grid const &grid) const {
                     static constexpr auto arg = typename ArgStoragePair::arg_t{};
                     return make_tmp_data_store<MaxExtent>(backend, arg, grid);
                 }
@@ -84,13 +83,49 @@ namespace gridtools {
             GT_META_DEFINE_ALIAS(apply, meta::id, generator<T>);
         };
 
-        template <class MaxExtent, class Backend, class Res, class Grid>
-        Res make_tmp_arg_storage_pairs(Grid const &grid) {
+        template <class MaxExtent, class Res, class Backend, class Grid>
+        Res make_tmp_arg_storage_pairs(Backend const &backend, Grid const &grid) {
             using generators = GT_META_CALL(
                 meta::transform, (get_tmp_arg_storage_pair_generator<MaxExtent, Backend>::template apply, Res));
-            return tuple_util::generate<generators, Res>(grid);
+            return tuple_util::generate<generators, Res>(backend, grid);
         }
 
+        // replaces a temporary by the one of `m_srcs` with the same placeholder, if both have the same size
+        template <class Srcs>
+        struct share_tmp_arg_storage_pair_f {
+            Srcs const &m_srcs;
+
+            template <class ArgStoragePair, class Pos = meta::st_position<Srcs, ArgStoragePair>>
+            enable_if_t<(Pos::value < meta::length<Srcs>::value)> operator()(ArgStoragePair &dst) const {
+                auto const &src = std::get<Pos::value>(m_srcs);
+                if (*src.m_value.get_storage_info_ptr() == *dst.m_value.get_storage_info_ptr())
+                    dst = src;
+            }
+            template <class ArgStoragePair, class Pos = meta::st_position<Srcs, ArgStoragePair>>
+            enable_if_t<(Pos::value == meta::length<Srcs>::value)> operator()(ArgStoragePair &) const {}
+        };
+
+        // reallocates a temporary for `m_grid` only if the existing one is too small in some dimension; the offsets
+        // of the temporaries are computed from the strides of the data store, such that larger ones can be reused
+        template <class MaxExtent, class Backend, class Grid>
+        struct rebind_tmp_arg_storage_pair_f {
+            Backend const &m_backend;
+            Grid const &m_grid;
+
+            template <class ArgStoragePair>
+            void operator()(ArgStoragePair &dst) const {
+                static constexpr auto arg = typename ArgStoragePair::arg_t{};
+                auto info = make_tmp_storage_info<MaxExtent>(m_backend, arg, m_grid);
+                auto const &old_lengths = dst.m_value.get_storage_info_ptr()->total_lengths();
+                for (size_t d = 0; d != old_lengths.size(); ++d) {
+                    if (old_lengths[d] < info.total_lengths()[d]) {
+                        dst = typename ArgStoragePair::data_store_t{info};
+                        return;
+                    }
+                }
+            }
+        };
+
         template <class MssComponentsList,
             class Extents = GT_META_CALL(
                 meta::transform, (get_max_extent_for_tmp_from_mss_components, MssComponentsList))>
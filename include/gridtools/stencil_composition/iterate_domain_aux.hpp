@@ -81,13 +81,12 @@ namespace gridtools {
     template <class StridesKind, class MaxExtent>
     struct get_index_offset_f<StridesKind, MaxExtent, false> {
         template <class Backend, class Stride, class Begin, class BlockNo, class PosInBlock>
-        GT_FUNCTION int_t operator()(Backend const &,
+        GT_FUNCTION int_t operator()(Backend const &backend,
             Stride const &GT_RESTRICT stride,
             Begin const &GT_RESTRICT begin,
             BlockNo const &GT_RESTRICT block_no,
             PosInBlock const &GT_RESTRICT pos_in_block) const {
-            static constexpr auto block_size =
-                make_pos3(block_i_size(Backend{}), block_j_size(Backend{}), block_k_size(Backend{}));
+            const auto block_size = make_pos3(block_i_size(backend), block_j_size(backend), block_k_size(backend));
             return stride.i * (begin.i + block_no.i * block_size.i + pos_in_block.i) +
                    stride.j * (begin.j + block_no.j * block_size.j + pos_in_block.j) +
                    stride.k * (begin.k + block_no.k * block_size.k + pos_in_block.k);
@@ -110,6 +109,7 @@ namespace gridtools {
     struct initialize_index_f {
         GT_STATIC_ASSERT((is_array_of<ArrayIndex, int>::value), GT_INTERNAL_ERROR);
         StridesMap const &m_strides_map;
+        Backend const &m_backend;
         pos3<uint_t> const &m_begin;
         pos3<uint_t> const &m_block_no;
         pos3<int_t> const &m_pos_in_block;
@@ -119,12 +119,11 @@ namespace gridtools {
         GT_FUNCTION void operator()() const {
             static constexpr auto index = _impl::get_index<StridesKind, LocalDomain>::value;
             GT_STATIC_ASSERT(index < ArrayIndex::size(), "Accessing an index out of bound in fusion tuple");
-            static constexpr auto backend = Backend{};
             static constexpr auto is_tmp =
                 meta::st_contains<typename LocalDomain::tmp_strides_kinds_t, StridesKind>::value;
             auto const &strides = host_device::at_key<StridesKind>(m_strides_map);
             m_index_array[index] =
-                get_index_offset_f<StridesKind, typename LocalDomain::max_extent_for_tmp_t, is_tmp>{}(backend,
+                get_index_offset_f<StridesKind, typename LocalDomain::max_extent_for_tmp_t, is_tmp>{}(m_backend,
                     make_pos3<int>(sid::get_stride<dim::i>(strides),
                         sid::get_stride<dim::j>(strides),
                         sid::get_stride<dim::k>(strides)),
@@ -137,11 +136,12 @@ namespace gridtools {
     template <class Backend, class LocalDomain, class StridesMap, class ArrayIndex>
     GT_FUNCTION initialize_index_f<StridesMap, LocalDomain, ArrayIndex, Backend> initialize_index(
         StridesMap const &strides_map,
+        Backend const &backend,
         pos3<uint_t> const &begin,
         pos3<uint_t> const &block_no,
         pos3<int_t> const &pos_in_block,
         ArrayIndex &index_array) {
-        return {strides_map, begin, block_no, pos_in_block, index_array};
+        return {strides_map, backend, begin, block_no, pos_in_block, index_array};
     }
 
     /**
@@ -159,7 +159,5 @@ namespace gridtools {
     struct deref_type : std::add_lvalue_reference<typename Arg::data_store_t::data_t> {};
 
     template <class Arg>
-    struct deref_type<Arg, intent::in> {
-        using type = typename Arg::data_store_t::data_t;
-    };
+    struct deref_type<Arg, intent::in> : compute_type<Arg> {};
 } // namespace gridtools
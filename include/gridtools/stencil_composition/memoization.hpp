@@ -0,0 +1,301 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+
+#include "../common/defs.hpp"
+#include "../common/host_device.hpp"
+#include "../meta.hpp"
+#include "accessor.hpp"
+#include "arg.hpp"
+#include "esf.hpp"
+#include "independent_esf.hpp"
+#include "mss.hpp"
+
+/**
+ * @file
+ * Memoization of stencil functions that are called at several offsets within a stage.
+ *
+ * A stage that calls `call<lap>::at<1, 0, 0>::with(eval, in())`, `call<lap>::with(eval, in())`, ... evaluates
+ * `lap` several times at the same grid point. Wrapping the functor of the stage with `memoized` lets the library
+ * compute these values once per grid point in a stage of their own:
+ *
+ *     make_stage<memoized<flx_function, memoize<lap_function, flx_function::in>>>(p_flx, p_in)
+ *
+ * For every `memoize<Function, Accessors...>`, a temporary and a stage that computes `Function` of the fields bound
+ * to `Accessors` into it are inserted before the stage. The calls `call<Function>` with arguments of the types
+ * `Accessors...` (and without an explicit region) then read the temporary (see `call` in stencil_functions.hpp).
+ * The temporary is cached in the ij-plane on the backends that support caches (see `add_automatic_caches`).
+ *
+ * The stages of an independent group share the memoized values of the same function of the same fields.
+ *
+ * The temporary is read at the offset of the call plus the offset of the argument. Only stencil functions with a
+ * single input and calls at horizontal offsets can be memoized (both are checked at compile time). The extent of the
+ * temporary is derived from the extents of the accessors of the calling stage.
+ */
+namespace gridtools {
+    /**
+     * @brief Memoizes the calls of the stencil function `Function` with the arguments `Accessors` (accessors of the
+     * calling stage).
+     */
+    template <class Function, class... Accessors>
+    struct memoize {};
+
+    /**
+     * @brief Wraps the stage `Functor` such that the stencil functions given by the `memoize` parameters are
+     * evaluated only once per grid point.
+     *
+     * Without the transformation of the multi-stage stencils (e.g. if the stage is called directly), `memoized`
+     * behaves like `Functor`.
+     */
+    template <class Functor, class... Memos>
+    struct memoized {
+        using param_list = typename Functor::param_list;
+
+        template <class Eval, class... Extra>
+        static GT_FUNCTION auto apply(Eval &eval, Extra... extra)
+            GT_AUTO_RETURN(Functor::template apply<Eval &>(eval, extra...));
+    };
+
+    namespace memoization_impl_ {
+        template <size_t MssIndex, size_t EsfIndex, class Function, class Placeholders>
+        struct memo_tag;
+    } // namespace memoization_impl_
+
+    namespace _impl {
+        // the memoized values are stored like the input of the function, they are read in its compute type as well
+        template <size_t MssIndex, size_t EsfIndex, class Function, class Placeholders, class Default>
+        struct tag_compute_type<memoization_impl_::memo_tag<MssIndex, EsfIndex, Function, Placeholders>, Default>
+            : compute_type<GT_META_CALL(meta::first, Placeholders)> {};
+    } // namespace _impl
+
+    namespace memoization_impl_ {
+
+        template <class Entry>
+        struct get_memo_accessor {};
+
+        template <class Key, class Accessor>
+        struct get_memo_accessor<meta::list<Key, Accessor>> {
+            using type = Accessor;
+        };
+
+        /**
+         * @brief Forwards the accesses to `Eval` and provides the accessors to the memoized values.
+         *
+         * @tparam Entries map from `meta::list<Function, Accessors...>` to the accessor of the memoized values
+         */
+        template <class Eval, class Entries>
+        struct memo_evaluator {
+            Eval &m_eval;
+
+            template <class Function, class... Accessors>
+            using memoized_accessor = typename get_memo_accessor<GT_META_CALL(
+                meta::mp_find, (Entries, meta::list<Function, Accessors...>))>::type;
+
+            template <class Arg>
+            GT_FUNCTION auto operator()(Arg &&arg) const GT_AUTO_RETURN(m_eval(std::forward<Arg>(arg)));
+
+            GT_FUNCTION int_t i() const { return m_eval.i(); }
+            GT_FUNCTION int_t j() const { return m_eval.j(); }
+            GT_FUNCTION int_t k() const { return m_eval.k(); }
+        };
+
+        /**
+         * @brief The functor of a memoizing stage: `Functor` with an additional accessor per memoized function.
+         */
+        template <class Functor, class Entries>
+        struct memoizing_functor {
+            using param_list = GT_META_CALL(meta::concat,
+                (typename Functor::param_list,
+                    GT_META_CALL(meta::rename,
+                        (make_param_list, GT_META_CALL(meta::transform, (meta::second, Entries))))));
+
+            template <class Eval, class... Extra, class MemoEval = memo_evaluator<Eval, Entries>>
+            static GT_FUNCTION auto apply(Eval &eval, Extra... extra)
+                -> decltype(Functor::template apply<MemoEval &>(std::declval<MemoEval &>(), extra...)) {
+                MemoEval memo_eval{eval};
+                return Functor::template apply<MemoEval &>(memo_eval, extra...);
+            }
+        };
+
+        template <class Accessor>
+        GT_META_DEFINE_ALIAS(is_in_param, bool_constant, Accessor::intent_v == intent::in);
+
+        template <class Accessor>
+        GT_META_DEFINE_ALIAS(is_out_param, bool_constant, Accessor::intent_v == intent::inout);
+
+        /**
+         * @brief Everything about `memoize<Function, Accessors...>` of the stage `Esf` that memoizes into the accessor
+         * with the index `Index`.
+         */
+        template <size_t MssIndex, size_t EsfIndex, class Esf, size_t Index, class Memo>
+        struct memo_info;
+
+        template <size_t MssIndex,
+            size_t EsfIndex,
+            class Functor,
+            class... Memos,
+            class Args,
+            size_t Index,
+            class Function,
+            class... Accessors>
+        struct memo_info<MssIndex,
+            EsfIndex,
+            esf_descriptor<memoized<Functor, Memos...>, Args>,
+            Index,
+            memoize<Function, Accessors...>> {
+            using params_t = typename Function::param_list;
+            using out_params_t = GT_META_CALL(meta::filter, (is_out_param, params_t));
+            using in_params_t = GT_META_CALL(meta::filter, (is_in_param, params_t));
+
+            GT_STATIC_ASSERT(sizeof...(Accessors) > 0, "memoize requires the accessors the function is called with");
+            GT_STATIC_ASSERT(sizeof...(Accessors) == 1,
+                "only stencil functions with a single input can be memoized, the memoized values are read at the "
+                "offset of that input");
+            GT_STATIC_ASSERT(meta::length<out_params_t>::value == 1 &&
+                                 meta::length<in_params_t>::value == sizeof...(Accessors),
+                "only stencil functions with a single output can be memoized, the accessors passed to memoize have to "
+                "match the inputs of the function");
+            GT_STATIC_ASSERT((conjunction<meta::st_contains<typename Functor::param_list, Accessors>...>::value),
+                "the accessors passed to memoize have to be accessors of the memoizing stage");
+
+            using placeholders_t = meta::list<GT_META_CALL(meta::at_c, (Args, Accessors::index_t::value))...>;
+            using first_placeholder_t = GT_META_CALL(meta::first, placeholders_t);
+            using location_t = typename first_placeholder_t::location_t;
+
+            using placeholder_t = plh<memo_tag<MssIndex, EsfIndex, Function, placeholders_t>,
+                typename _impl::tmp_data_store<_impl::tmp_storage_info_id<location_t>::value,
+                    typename first_placeholder_t::data_store_t>::type,
+                location_t,
+                true>;
+
+            using out_param_t = GT_META_CALL(meta::first, out_params_t);
+            using esf_t = esf_descriptor<Function,
+                GT_META_CALL(meta::rename,
+                    (std::tuple,
+                        GT_META_CALL(
+                            meta::insert_c, (out_param_t::index_t::value, placeholders_t, placeholder_t))))>;
+
+            // the memoized values are read at the offsets at which the first argument can be accessed by the function
+            using caller_extent_t = typename GT_META_CALL(meta::first, meta::list<Accessors...>)::extent_t;
+            using function_extent_t = typename GT_META_CALL(meta::first, in_params_t)::extent_t;
+
+            static constexpr int_t iminus = caller_extent_t::iminus::value - function_extent_t::iminus::value;
+            static constexpr int_t iplus = caller_extent_t::iplus::value - function_extent_t::iplus::value;
+            static constexpr int_t jminus = caller_extent_t::jminus::value - function_extent_t::jminus::value;
+            static constexpr int_t jplus = caller_extent_t::jplus::value - function_extent_t::jplus::value;
+            static constexpr int_t kminus = caller_extent_t::kminus::value - function_extent_t::kminus::value;
+            static constexpr int_t kplus = caller_extent_t::kplus::value - function_extent_t::kplus::value;
+            GT_STATIC_ASSERT(kminus >= 0 && kplus <= 0,
+                "only stencil functions that are called at horizontal offsets can be memoized");
+
+            using extent_t = extent<(iminus < 0 ? iminus : 0),
+                (iplus > 0 ? iplus : 0),
+                (jminus < 0 ? jminus : 0),
+                (jplus > 0 ? jplus : 0)>;
+
+            using entry_t = meta::list<meta::list<Function, Accessors...>, in_accessor<Index, extent_t>>;
+        };
+
+        /**
+         * @brief The stages that compute the memoized values for `Esf` (`memo_esfs_t`) and the transformed `Esf`.
+         */
+        template <size_t MssIndex, size_t EsfIndex, class Esf, class = void>
+        struct expand_esf {
+            using memo_esfs_t = meta::list<>;
+            using type = Esf;
+        };
+
+        template <size_t MssIndex, size_t EsfIndex, class Esf, class Indices>
+        struct expand_memoized_esf;
+
+        template <size_t MssIndex, size_t EsfIndex, class Functor, class... Memos, class Args, size_t... Is>
+        struct expand_memoized_esf<MssIndex,
+            EsfIndex,
+            esf_descriptor<memoized<Functor, Memos...>, Args>,
+            meta::list<std::integral_constant<size_t, Is>...>> {
+            static constexpr size_t first_index = meta::length<typename Functor::param_list>::value;
+
+            template <size_t I, class Memo>
+            using info_t =
+                memo_info<MssIndex, EsfIndex, esf_descriptor<memoized<Functor, Memos...>, Args>, first_index + I, Memo>;
+
+            using memo_esfs_t = meta::list<typename info_t<Is, Memos>::esf_t...>;
+            using type =
+                esf_descriptor<memoizing_functor<Functor, meta::list<typename info_t<Is, Memos>::entry_t...>>,
+                    GT_META_CALL(meta::push_back, (Args, typename info_t<Is, Memos>::placeholder_t...))>;
+        };
+
+        template <size_t MssIndex, size_t EsfIndex, class Functor, class... Memos, class Args>
+        struct expand_esf<MssIndex, EsfIndex, esf_descriptor<memoized<Functor, Memos...>, Args>>
+            : expand_memoized_esf<MssIndex,
+                  EsfIndex,
+                  esf_descriptor<memoized<Functor, Memos...>, Args>,
+                  GT_META_CALL(meta::make_indices_c, sizeof...(Memos))> {};
+
+        template <size_t MssIndex, size_t EsfIndex>
+        struct expand_esf_f {
+            template <class Esf>
+            GT_META_DEFINE_ALIAS(apply, meta::id, (expand_esf<MssIndex, EsfIndex, Esf>));
+        };
+
+        template <class Expanded>
+        GT_META_DEFINE_ALIAS(get_memo_esfs, meta::id, typename Expanded::memo_esfs_t);
+
+        template <class Expanded>
+        GT_META_DEFINE_ALIAS(get_expanded_esf, meta::id, typename Expanded::type);
+
+        // the stages of an independent group share the memoized values
+        template <size_t MssIndex, size_t EsfIndex, class Esfs>
+        struct expand_esf<MssIndex, EsfIndex, independent_esf<Esfs>> {
+            using expanded_t = GT_META_CALL(meta::transform, (expand_esf_f<MssIndex, EsfIndex>::template apply, Esfs));
+            using memo_esfs_t = GT_META_CALL(meta::dedup,
+                (GT_META_CALL(meta::flatten,
+                    (GT_META_CALL(meta::rename,
+                        (meta::list, GT_META_CALL(meta::transform, (get_memo_esfs, expanded_t))))))));
+            using type = independent_esf<GT_META_CALL(meta::transform, (get_expanded_esf, expanded_t))>;
+        };
+
+        template <size_t MssIndex,
+            class Mss,
+            class Indices = GT_META_CALL(meta::make_indices_for, typename Mss::esf_sequence_t)>
+        struct expand_mss;
+
+        template <size_t MssIndex, class ExecutionEngine, class... Esfs, class CacheSequence, class... Is>
+        struct expand_mss<MssIndex,
+            mss_descriptor<ExecutionEngine, std::tuple<Esfs...>, CacheSequence>,
+            meta::list<Is...>> {
+            using type = mss_descriptor<ExecutionEngine,
+                GT_META_CALL(meta::flatten,
+                    (std::tuple<GT_META_CALL(meta::push_back,
+                        (GT_META_CALL(meta::rename,
+                             (std::tuple, typename expand_esf<MssIndex, Is::value, Esfs>::memo_esfs_t)),
+                            typename expand_esf<MssIndex, Is::value, Esfs>::type))...>)),
+                CacheSequence>;
+        };
+
+        template <class Msses, class Indices = GT_META_CALL(meta::make_indices_for, Msses)>
+        struct expand_msses;
+
+        template <class... Msses, class... Is>
+        struct expand_msses<std::tuple<Msses...>, meta::list<Is...>> {
+            using type = std::tuple<typename expand_mss<Is::value, Msses>::type...>;
+        };
+    } // namespace memoization_impl_
+
+    /**
+     * @brief Inserts the stages that compute the memoized values of the `memoized` stages of the multi-stage stencils
+     * `Msses`.
+     */
+    template <class Msses>
+    GT_META_DEFINE_ALIAS(expand_memoized_stages, meta::id, typename memoization_impl_::expand_msses<Msses>::type);
+} // namespace gridtools
@@ -0,0 +1,456 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "../common/defs.hpp"
+#include "../common/thread_pool.hpp"
+#include "../meta.hpp"
+#include "../storage/storage_facility.hpp"
+
+/**
+ * @file
+ * Parallel reductions (sum, min, max, norms) of data stores over the compute domain of a grid.
+ *
+ * `reduce(grid, reduction::sum(a), reduction::norm2(b), ...)` traverses the points of the compute domain (the halo
+ * that is excluded by the grid is not visited) in a single pass over all fields and returns the result of a single
+ * reduction as a value and the results of several reductions as a `std::tuple`. Every line along the dimension with
+ * the smallest stride is reduced into a small array of independent partial results that the compiler keeps in vector
+ * registers, and the lines are distributed over the threads of the CPU runtime (OpenMP or `thread_pool`).
+ *
+ * The order in which the partial results are combined is chosen by `reduction_order`:
+ * - `fast`: every thread combines its lines into a thread-local partial result; the result of a floating point sum
+ *   depends on the number of threads.
+ * - `pairwise`: the partial results of the lines are combined in a balanced tree in a fixed order; the result is
+ *   reproducible bitwise for any number of threads and the rounding error grows logarithmically with the domain size.
+ * - `kahan`: like `pairwise`, with compensated summation within and across the lines, for sums that need close to
+ *   working precision.
+ * The order only affects sum, norm1 and norm2; min, max and norm_inf are exact in any order.
+ *
+ * See `global_reduce` in `communication/global_reductions.hpp` for reductions over all ranks of a distributed domain.
+ */
+namespace gridtools {
+    enum class reduction_order { fast, pairwise, kahan };
+
+    namespace reduction {
+        /**
+         * @brief A reduction operation: `finalize(combine(... combine(identity, map(x0)) ..., map(xn)))`.
+         *
+         * Additive operations (`is_additive`) combine by addition and support compensated summation.
+         */
+        struct sum_op {
+            static constexpr bool is_additive = true;
+            template <class T>
+            static T identity() {
+                return 0;
+            }
+            template <class T>
+            static T map(T x) {
+                return x;
+            }
+            template <class T>
+            static T combine(T a, T b) {
+                return a + b;
+            }
+            template <class T>
+            static T finalize(T x) {
+                return x;
+            }
+        };
+
+        struct norm1_op : sum_op {
+            template <class T>
+            static T map(T x) {
+                return x < 0 ? -x : x;
+            }
+        };
+
+        struct norm2_op : sum_op {
+            template <class T>
+            static T map(T x) {
+                return x * x;
+            }
+            template <class T>
+            static T finalize(T x) {
+                return std::sqrt(x);
+            }
+        };
+
+        struct min_op {
+            static constexpr bool is_additive = false;
+            template <class T>
+            static T identity() {
+                return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                            : std::numeric_limits<T>::max();
+            }
+            template <class T>
+            static T map(T x) {
+                return x;
+            }
+            template <class T>
+            static T combine(T a, T b) {
+                return b < a ? b : a;
+            }
+            template <class T>
+            static T finalize(T x) {
+                return x;
+            }
+        };
+
+        struct max_op : min_op {
+            template <class T>
+            static T identity() {
+                return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                            : std::numeric_limits<T>::lowest();
+            }
+            template <class T>
+            static T combine(T a, T b) {
+                return a < b ? b : a;
+            }
+        };
+
+        struct norm_inf_op : max_op {
+            template <class T>
+            static T identity() {
+                return 0;
+            }
+            template <class T>
+            static T map(T x) {
+                return x < 0 ? -x : x;
+            }
+        };
+
+        /**
+         * @brief The reduction of one data store with the operation `Op`.
+         */
+        template <class Op, class DataStore>
+        struct term {
+            GT_STATIC_ASSERT(is_data_store<DataStore>::value, "reductions are defined on data stores");
+            GT_STATIC_ASSERT(DataStore::storage_info_t::layout_t::masked_length == 3,
+                "reductions are defined on three-dimensional data stores");
+
+            using op_t = Op;
+            using data_store_t = DataStore;
+            using value_t = typename std::remove_const<typename DataStore::data_t>::type;
+
+            DataStore m_data_store;
+        };
+
+        template <class DataStore>
+        term<sum_op, DataStore> sum(DataStore const &data_store) {
+            return {data_store};
+        }
+
+        template <class DataStore>
+        term<min_op, DataStore> min(DataStore const &data_store) {
+            return {data_store};
+        }
+
+        template <class DataStore>
+        term<max_op, DataStore> max(DataStore const &data_store) {
+            return {data_store};
+        }
+
+        /** @brief Sum of the absolute values. */
+        template <class DataStore>
+        term<norm1_op, DataStore> norm1(DataStore const &data_store) {
+            return {data_store};
+        }
+
+        /** @brief Square root of the sum of the squares. */
+        template <class DataStore>
+        term<norm2_op, DataStore> norm2(DataStore const &data_store) {
+            return {data_store};
+        }
+
+        /** @brief Maximum of the absolute values. */
+        template <class DataStore>
+        term<norm_inf_op, DataStore> norm_inf(DataStore const &data_store) {
+            return {data_store};
+        }
+    } // namespace reduction
+
+    namespace _impl {
+        namespace reduction_detail {
+            // number of independent partial results per line
+            constexpr int_t lanes = 8;
+
+            /**
+             * @brief Partial result of a reduction.
+             */
+            template <class Op, class T>
+            struct plain_accumulator {
+                T m_value = Op::template identity<T>();
+
+                void add(T x) { m_value = Op::combine(m_value, x); }
+                void merge(plain_accumulator const &other) { add(other.m_value); }
+                T value() const { return m_value; }
+            };
+
+            /**
+             * @brief Partial result of a sum with a running compensation of the rounding error (Neumaier's variant of
+             * Kahan summation, which is also exact if the added value is larger than the sum).
+             */
+            template <class Op, class T>
+            struct kahan_accumulator {
+                T m_sum = 0;
+                T m_compensation = 0;
+
+                void add(T x) {
+                    T sum = m_sum + x;
+                    if (std::abs(m_sum) >= std::abs(x))
+                        m_compensation += (m_sum - sum) + x;
+                    else
+                        m_compensation += (x - sum) + m_sum;
+                    m_sum = sum;
+                }
+                void merge(kahan_accumulator const &other) {
+                    add(other.m_sum);
+                    m_compensation += other.m_compensation;
+                }
+                T value() const { return m_sum + m_compensation; }
+            };
+
+            template <class Term>
+            using plain_accumulator_t = plain_accumulator<typename Term::op_t, typename Term::value_t>;
+
+            template <class Term>
+            using compensated_accumulator_t = conditional_t<Term::op_t::is_additive,
+                kahan_accumulator<typename Term::op_t, typename Term::value_t>,
+                plain_accumulator<typename Term::op_t, typename Term::value_t>>;
+
+            /**
+             * @brief Combines `n` partial results in a balanced tree, the order only depends on `n`.
+             */
+            template <class Accumulator>
+            Accumulator merge_pairwise(Accumulator const *first, size_t n) {
+                if (n == 0)
+                    return {};
+                if (n == 1)
+                    return *first;
+                Accumulator res = merge_pairwise(first, n / 2);
+                res.merge(merge_pairwise(first + n / 2, n - n / 2));
+                return res;
+            }
+
+            /**
+             * @brief Reduces `n` values with the given stride into `lanes` partial results, which are combined in a
+             * fixed order.
+             */
+            template <class Op, class Accumulator, class T>
+            Accumulator reduce_line(T const *ptr, int_t stride, int_t n) {
+                Accumulator acc[lanes];
+                int_t i = 0;
+                if (stride == 1) {
+                    for (; i + lanes <= n; i += lanes)
+                        for (int_t l = 0; l != lanes; ++l)
+                            acc[l].add(Op::map(ptr[i + l]));
+                } else {
+                    for (; i + lanes <= n; i += lanes)
+                        for (int_t l = 0; l != lanes; ++l)
+                            acc[l].add(Op::map(ptr[(i + l) * stride]));
+                }
+                for (int_t l = 0; i != n; ++i, ++l)
+                    acc[l].add(Op::map(ptr[i * stride]));
+                return merge_pairwise(acc, lanes);
+            }
+
+            /**
+             * @brief Traversal of the compute domain of one data store, line by line.
+             */
+            template <class Term>
+            struct cursor {
+                using value_t = typename Term::value_t;
+
+                value_t const *m_origin;
+                array<int_t, 3> m_strides;
+
+                template <class Grid>
+                cursor(Term const &term, Grid const &grid) {
+                    auto view = make_host_view<access_mode::read_only>(term.m_data_store);
+                    auto const &info = *term.m_data_store.get_storage_info_ptr();
+                    m_origin = &view(grid.i_low_bound(), grid.j_low_bound(), grid.k_min());
+                    m_strides = {static_cast<int_t>(info.template stride<0>()),
+                        static_cast<int_t>(info.template stride<1>()),
+                        static_cast<int_t>(info.template stride<2>())};
+                }
+
+                // reduces the line `line` of the domain, lines run along `dims[0]`
+                template <class Accumulator>
+                Accumulator reduce(array<int_t, 3> const &dims, array<int_t, 3> const &sizes, int_t line) const {
+                    value_t const *ptr = m_origin + line % sizes[dims[1]] * m_strides[dims[1]] +
+                                         line / sizes[dims[1]] * m_strides[dims[2]];
+                    return reduce_line<typename Term::op_t, Accumulator>(ptr, m_strides[dims[0]], sizes[dims[0]]);
+                }
+            };
+
+            template <class Grid>
+            array<int_t, 3> domain_sizes(Grid const &grid) {
+                return {(int_t)(grid.i_high_bound() - grid.i_low_bound() + 1),
+                    (int_t)(grid.j_high_bound() - grid.j_low_bound() + 1),
+                    (int_t)(grid.k_max() - grid.k_min() + 1)};
+            }
+
+            // dimensions ordered by increasing stride of the first data store; masked dimensions last
+            template <class Cursor>
+            array<int_t, 3> traversal_order(Cursor const &cursor) {
+                array<int_t, 3> res = {0, 1, 2};
+                auto key = [&](int_t dim) {
+                    return cursor.m_strides[dim] == 0 ? std::numeric_limits<int_t>::max() : cursor.m_strides[dim];
+                };
+                std::stable_sort(res.begin(), res.end(), [&](int_t a, int_t b) { return key(a) < key(b); });
+                return res;
+            }
+
+            template <class F>
+            void parallel_for_lines(int_t lines, F const &f) {
+#ifdef GT_USE_THREAD_POOL
+                thread_pool::get().parallel_for(lines, [&](std::ptrdiff_t line) { f((int_t)line); });
+#else
+#pragma omp parallel for schedule(static)
+                for (int_t line = 0; line < lines; ++line)
+                    f(line);
+#endif
+            }
+
+            template <class Accumulators, class Cursors, size_t... Is>
+            void reduce_all(Accumulators &accs,
+                Cursors const &cursors,
+                array<int_t, 3> const &dims,
+                array<int_t, 3> const &sizes,
+                int_t line,
+                meta::index_sequence<Is...>) {
+                (void)(int[]){(std::get<Is>(accs).merge(
+                                   std::get<Is>(cursors)
+                                       .template reduce<typename std::tuple_element<Is, Accumulators>::type>(
+                                           dims, sizes, line)),
+                    0)...,
+                    0};
+            }
+
+            template <class Accumulators, size_t... Is>
+            void merge_all(Accumulators &dst, Accumulators const &src, meta::index_sequence<Is...>) {
+                (void)(int[]){(std::get<Is>(dst).merge(std::get<Is>(src)), 0)..., 0};
+            }
+
+            template <class Accumulators, class Indices>
+            Accumulators merge_pairwise_all(Accumulators const *first, size_t n, Indices indices) {
+                if (n == 0)
+                    return {};
+                if (n == 1)
+                    return *first;
+                Accumulators res = merge_pairwise_all(first, n / 2, indices);
+                merge_all(res, merge_pairwise_all(first + n / 2, n - n / 2, indices), indices);
+                return res;
+            }
+
+            // separates the thread-local partial results by a cache line; padding by size instead of alignment
+            // keeps them apart without relying on over-aligned allocation (not supported by std::allocator in C++11)
+            template <class T>
+            struct padded {
+                T m_value;
+                char m_padding[64];
+            };
+
+            /**
+             * @brief Partial results of all terms (before `finalize`).
+             *
+             * If `deterministic` is false, every thread accumulates the lines that it is assigned to and the threads
+             * are combined in order. Otherwise, the partial results of the lines are stored and combined pairwise,
+             * independently of the thread that computed them.
+             */
+            template <class Accumulators, class Grid, class... Terms>
+            Accumulators reduce_partial(bool deterministic, Grid const &grid, Terms const &... terms) {
+                using indices_t = meta::index_sequence_for<Terms...>;
+                const auto sizes = domain_sizes(grid);
+                if (sizes[0] <= 0 || sizes[1] <= 0 || sizes[2] <= 0)
+                    return {};
+                std::tuple<cursor<Terms>...> cursors{cursor<Terms>(terms, grid)...};
+                const auto dims = traversal_order(std::get<0>(cursors));
+                const int_t lines = sizes[dims[1]] * sizes[dims[2]];
+
+                if (!deterministic) {
+                    std::vector<padded<Accumulators>> partials(host_max_threads());
+                    parallel_for_lines(lines, [&](int_t line) {
+                        reduce_all(partials[host_thread_num()].m_value, cursors, dims, sizes, line, indices_t());
+                    });
+                    Accumulators res;
+                    for (auto const &partial : partials)
+                        merge_all(res, partial.m_value, indices_t());
+                    return res;
+                }
+                std::vector<Accumulators> partials(lines);
+                parallel_for_lines(
+                    lines, [&](int_t line) { reduce_all(partials[line], cursors, dims, sizes, line, indices_t()); });
+                return merge_pairwise_all(partials.data(), partials.size(), indices_t());
+            }
+
+            template <class Accumulators, size_t... Is>
+            auto values(Accumulators const &accs, meta::index_sequence<Is...>)
+                GT_AUTO_RETURN(std::make_tuple(std::get<Is>(accs).value()...));
+
+            /**
+             * @brief Values of the partial results of all terms (before `finalize`).
+             */
+            template <class Grid, class... Terms>
+            std::tuple<typename Terms::value_t...> partial_values(
+                reduction_order order, Grid const &grid, Terms const &... terms) {
+                using indices_t = meta::index_sequence_for<Terms...>;
+                switch (order) {
+                case reduction_order::fast:
+                    return values(reduce_partial<std::tuple<plain_accumulator_t<Terms>...>>(false, grid, terms...),
+                        indices_t());
+                case reduction_order::pairwise:
+                    return values(
+                        reduce_partial<std::tuple<plain_accumulator_t<Terms>...>>(true, grid, terms...), indices_t());
+                default:
+                    return values(reduce_partial<std::tuple<compensated_accumulator_t<Terms>...>>(true, grid, terms...),
+                        indices_t());
+                }
+            }
+
+            template <class... Terms, class Values, size_t... Is>
+            std::tuple<typename Terms::value_t...> finalize(Values const &values, meta::index_sequence<Is...>) {
+                return std::tuple<typename Terms::value_t...>{Terms::op_t::finalize(std::get<Is>(values))...};
+            }
+
+            template <class T>
+            T make_result(std::tuple<T> const &values) {
+                return std::get<0>(values);
+            }
+
+            template <class... Ts>
+            enable_if_t<sizeof...(Ts) != 1, std::tuple<Ts...>> make_result(std::tuple<Ts...> const &values) {
+                return values;
+            }
+        } // namespace reduction_detail
+    }     // namespace _impl
+
+    /**
+     * @brief Reduces the data stores of the given reduction terms over the compute domain of `grid` in one pass.
+     *
+     * @return the result of a single term, a `std::tuple` with the results of several terms
+     */
+    template <class Grid, class... Ops, class... DataStores>
+    auto reduce(reduction_order order, Grid const &grid, reduction::term<Ops, DataStores> const &... terms)
+        GT_AUTO_RETURN(_impl::reduction_detail::make_result(
+            _impl::reduction_detail::finalize<reduction::term<Ops, DataStores>...>(
+                _impl::reduction_detail::partial_values(order, grid, terms...),
+                meta::index_sequence_for<DataStores...>())));
+
+    template <class Grid, class... Ops, class... DataStores>
+    auto reduce(Grid const &grid, reduction::term<Ops, DataStores> const &... terms)
+        GT_AUTO_RETURN(reduce(reduction_order::fast, grid, terms...));
+} // namespace gridtools
@@ -24,8 +24,15 @@
 #include "caches/define_caches.hpp"
 #include "computation.hpp"
 #include "esf.hpp"
+#include "fuse_computations.hpp"
 #include "global_parameter.hpp"
 #include "grid.hpp"
 #include "make_computation.hpp"
 #include "make_stage.hpp"
 #include "make_stencils.hpp"
+#include "reductions.hpp"
+
+#ifndef GT_ICOSAHEDRAL_GRIDS
+#include "column_mask.hpp"
+#include "memoization.hpp"
+#endif
@@ -180,6 +180,36 @@ namespace gridtools {
 
         template <class Accessor>
         GT_META_DEFINE_ALIAS(is_out_param, bool_constant, Accessor::intent_v == intent::inout);
+
+        /**
+         * @brief The accessor to the memoized results of `Functor` for the arguments `Args`, if `Eval` provides one
+         * (see `memoized` in memoization.hpp).
+         */
+        template <class Eval, class Functor, class Args, class = void>
+        struct memoized_accessor {};
+
+        template <class Eval, class Functor, class... Args>
+        struct memoized_accessor<Eval,
+            Functor,
+            meta::list<Args...>,
+            void_t<typename Eval::template memoized_accessor<Functor, Args...>>> {
+            using type = typename Eval::template memoized_accessor<Functor, Args...>;
+        };
+
+        template <class Eval, class Functor, class Region, class Args, class = void>
+        struct is_memoized : std::false_type {};
+
+        template <class Eval, class Functor, class Args>
+        struct is_memoized<Eval, Functor, void, Args, void_t<typename memoized_accessor<Eval, Functor, Args>::type>>
+            : std::true_type {};
+
+        template <class Res, int_t I, int_t J, int_t K, class Accessor>
+        GT_FUNCTION Res shift_accessor(Accessor &&acc) {
+            static constexpr hymap::keys<dim::i, dim::j, dim::k>::
+                values<integral_constant<int_t, I>, integral_constant<int_t, J>, integral_constant<int_t, K>>
+                    offset = {};
+            return sum_offsets<Res>(std::forward<Accessor>(acc), offset);
+        }
     } // namespace call_interfaces_impl_
 
     /** Main interface for calling stencil operators as functions.
@@ -233,13 +263,32 @@ namespace gridtools {
         template <class Eval,
             class... Args,
             class Res = typename call_interfaces_impl_::get_result_type<Eval, ReturnType, decay_t<Args>...>::type,
-            enable_if_t<sizeof...(Args) + 1 == meta::length<params_t>::value, int> = 0>
+            enable_if_t<sizeof...(Args) + 1 == meta::length<params_t>::value &&
+                            !call_interfaces_impl_::
+                                is_memoized<Eval, Functor, Region, meta::list<decay_t<Args>...>>::value,
+                int> = 0>
         GT_FUNCTION static Res with(Eval &eval, Args &&... args) {
             Res res;
             call_interfaces_impl_::evaluate_bound_functor<Functor, Region, OffI, OffJ, OffK>(eval,
                 tuple_util::host_device::insert<out_param_index>(res, tuple<Args &&...>{std::forward<Args>(args)...}));
             return res;
         }
+
+        /**
+         * If the calling stage memoizes the results of the stencil function for this argument, the result is read from
+         * the memoized values at the offset of the call and the argument.
+         */
+        template <class Eval,
+            class Arg,
+            class Res = typename call_interfaces_impl_::get_result_type<Eval, ReturnType, decay_t<Arg>>::type,
+            enable_if_t<meta::length<params_t>::value == 2 &&
+                            call_interfaces_impl_::is_memoized<Eval, Functor, Region, meta::list<decay_t<Arg>>>::value,
+                int> = 0>
+        GT_FUNCTION static Res with(Eval &eval, Arg &&arg) {
+            using accessor_t =
+                typename call_interfaces_impl_::memoized_accessor<Eval, Functor, meta::list<decay_t<Arg>>>::type;
+            return eval(call_interfaces_impl_::shift_accessor<accessor_t, OffI, OffJ, OffK>(std::forward<Arg>(arg)));
+        }
     };
 
     /**
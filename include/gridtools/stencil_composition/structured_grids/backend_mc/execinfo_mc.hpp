@@ -10,8 +10,13 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "../../../common/defs.hpp"
 #include "../../../common/host_device.hpp"
+#include "../../../common/thread_placement.hpp"
+#include "../../../common/thread_pool.hpp"
 
 namespace gridtools {
 
@@ -51,7 +56,7 @@ namespace gridtools {
             : m_i_grid_size(grid.i_high_bound() - grid.i_low_bound() + 1),
               m_j_grid_size(grid.j_high_bound() - grid.j_low_bound() + 1), m_i_low_bound(grid.i_low_bound()),
               m_j_low_bound(grid.j_low_bound()) {
-            const int_t threads = omp_get_max_threads();
+            const int_t threads = host_max_threads();
 
             // if domain is large enough (relative to the number of threads),
             // we split only along j-axis (for prefetching reasons)
@@ -62,18 +67,29 @@ namespace gridtools {
             m_i_block_size = (m_i_grid_size + max_i_blocks - 1) / max_i_blocks;
             m_i_blocks = (m_i_grid_size + m_i_block_size - 1) / m_i_block_size;
 
+            // with a thread placement, the blocks are permuted such that neighboring threads get adjacent blocks
+            m_order = _impl::thread_placement_detail::current_block_order(m_i_blocks * m_j_blocks);
+
             assert(m_i_block_size > 0 && m_j_block_size > 0);
         }
 
         /**
          * @brief Computes the effective (clamped) block size and position for k-serial stencils.
          *
+         * The block indices are the loop indices of the (statically scheduled) loop over all blocks; with a thread
+         * placement they are mapped to the block of the thread that executes the iteration.
+         *
          * @param i_block_index Block index along i-axis.
          * @param j_block_index Block index along j-axis.
          *
          * @return An execution info instance with the computed properties.
          */
         GT_FUNCTION block_kserial_t block(int_t i_block_index, int_t j_block_index) const {
+            if (m_order) {
+                const int_t index = (*m_order)[j_block_index * m_i_blocks + i_block_index];
+                i_block_index = index % m_i_blocks;
+                j_block_index = index / m_i_blocks;
+            }
             return block_kserial_t{block_start(i_block_index, m_i_block_size, m_i_low_bound),
                 block_start(j_block_index, m_j_block_size, m_j_low_bound),
                 clamped_block_size(m_i_grid_size, i_block_index, m_i_block_size, m_i_blocks),
@@ -121,6 +137,7 @@ namespace gridtools {
         int_t m_i_low_bound, m_j_low_bound;
         int_t m_i_block_size, m_j_block_size;
         int_t m_i_blocks, m_j_blocks;
+        std::shared_ptr<const std::vector<int_t>> m_order;
     };
 
 } // namespace gridtools
@@ -19,6 +19,7 @@
 #include "../../../common/generic_metafunctions/for_each.hpp"
 #include "../../../common/gt_assert.hpp"
 #include "../../../common/hymap.hpp"
+#include "../../../common/thread_pool.hpp"
 #include "../../../meta.hpp"
 #include "../../accessor_base.hpp"
 #include "../../caches/cache_metafunctions.hpp"
@@ -32,14 +33,26 @@ namespace gridtools {
 
     namespace iterate_domain_mc_impl_ {
         /**
-         * @brief Per-thread global value of omp_get_thread_num() / omp_get_max_threads().
+         * @brief Per-thread global value of host_thread_num() / host_max_threads().
+         *
+         * The value is cached per thread and recomputed only if the thread number or the team size change, e.g. if
+         * a thread executes a nested parallel region.
          */
         inline float thread_factor() {
+            struct cache_t {
+                int num;
+                int max_threads;
+                float value;
+            };
 #if !defined(__APPLE_CC__) || __APPLE_CC__ > 8000
             thread_local static
 #endif
-                const float value = (float)omp_get_thread_num() / omp_get_max_threads();
-            return value;
+                cache_t cache = {-1, -1, 0};
+            const int num = host_thread_num();
+            const int max_threads = host_max_threads();
+            if (num != cache.num || max_threads != cache.max_threads)
+                cache = {num, max_threads, (float)num / max_threads};
+            return cache.value;
         }
 
         /**
@@ -57,7 +70,7 @@ namespace gridtools {
 
                 auto length = at_key<strides_kind_t>(m_local_domain.m_total_length_map);
                 int_t offset = std::lround(length * thread_factor());
-                assert(offset == ((long long)length * omp_get_thread_num()) / omp_get_max_threads());
+                assert(offset == ((long long)length * host_thread_num()) / host_max_threads());
                 at_key<Arg>(m_dst) += offset;
             }
         };
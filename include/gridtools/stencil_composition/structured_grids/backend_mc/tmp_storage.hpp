@@ -11,9 +11,12 @@
 
 #include "../../../common/defs.hpp"
 #include "../../../common/host_device.hpp"
+#include "../../../common/thread_pool.hpp"
 
 namespace gridtools {
     namespace tmp_storage {
+        constexpr std::true_type sized_per_thread(backend::mc const &) { return {}; }
+
         template <class StorageInfo, class /*MaxExtent*/>
         uint_t get_i_size(backend::mc const &, uint_t block_size, uint_t /*total_size*/) {
             static constexpr auto halo = StorageInfo::halo_t::template at<0>();
@@ -29,7 +32,7 @@ namespace gridtools {
         template <class StorageInfo, class /*MaxExtent*/>
         uint_t get_j_size(backend::mc const &, uint_t block_size, uint_t /*total_size*/) {
             static constexpr auto halo = StorageInfo::halo_t::template at<1>();
-            return (block_size + 2 * halo) * omp_get_max_threads();
+            return (block_size + 2 * halo) * host_max_threads();
         }
 
         template <class /*StorageInfo*/, class /*MaxExtent*/>
@@ -16,6 +16,7 @@
 
 #include "../../../common/hugepage_alloc.hpp"
 #include "../../../common/hymap.hpp"
+#include "../../../common/thread_pool.hpp"
 #include "../../dim.hpp"
 #include "../../pos3.hpp"
 #include "../../sid/concept.hpp"
@@ -62,7 +63,7 @@ namespace gridtools {
             // allocate one extra cache line to allow for offsetting the initial allocation
             // to guarantee alignment of first element inside domain
             constexpr std::size_t extra = (byte_alignment::value + sizeof(T) - 1) / sizeof(T);
-            return bs.i * bs.j * bs.k * omp_get_max_threads() + extra;
+            return bs.i * bs.j * bs.k * host_max_threads() + extra;
         }
 
         template <std::size_t, class>
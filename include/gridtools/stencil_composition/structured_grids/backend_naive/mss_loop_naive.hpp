@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../../backend_naive/basic_token_execution_naive.hpp"
+#include "../../column_mask.hpp"
 #include "../../iteration_policy.hpp"
 #include "../../pos3.hpp"
 #include "../positional_iterate_domain.hpp"
@@ -20,14 +21,31 @@
  * @brief mss loop implementations for the naive backend
  */
 namespace gridtools {
+    namespace _impl_mss_loop_naive {
+        template <class Grid, class ExecutionInfo>
+        column_segment get_segment(Grid const &grid, ExecutionInfo const &) {
+            return {0,
+                0,
+                (int_t)(grid.i_high_bound() - grid.i_low_bound() + 1),
+                (int_t)(grid.j_high_bound() - grid.j_low_bound() + 1)};
+        }
+
+        template <class Grid>
+        column_segment get_segment(Grid const &, column_segment const &segment) {
+            return segment;
+        }
+    } // namespace _impl_mss_loop_naive
+
     /**
      * @brief main execution of a mss. Defines the IJ loop bounds of this particular block
      * and sequentially executes all the functors in the mss
      * @tparam RunFunctorArgs run functor arguments
      */
     template <class RunFunctorArgs, class LocalDomain, class Grid, class ExecutionInfo>
-    GT_FORCE_INLINE static void mss_loop(
-        backend::naive const &, LocalDomain const &local_domain, Grid const &grid, const ExecutionInfo &) {
+    GT_FORCE_INLINE static void mss_loop(backend::naive const &,
+        LocalDomain const &local_domain,
+        Grid const &grid,
+        const ExecutionInfo &execution_info) {
         GT_STATIC_ASSERT((is_run_functor_arguments<RunFunctorArgs>::value), GT_INTERNAL_ERROR);
         GT_STATIC_ASSERT((is_local_domain<LocalDomain>::value), GT_INTERNAL_ERROR);
         GT_STATIC_ASSERT((is_grid<Grid>::value), GT_INTERNAL_ERROR);
@@ -47,17 +65,17 @@ namespace gridtools {
         using extent_t = GT_META_CALL(get_extent_from_loop_intervals, typename RunFunctorArgs::loop_intervals_t);
         using interval_t = GT_META_CALL(meta::first, typename RunFunctorArgs::loop_intervals_t);
         using from_t = GT_META_CALL(meta::first, interval_t);
-        it_domain.initialize({grid.i_low_bound(), grid.j_low_bound(), grid.k_min()},
+        const column_segment segment = _impl_mss_loop_naive::get_segment(grid, execution_info);
+        it_domain.initialize(
+            {(uint_t)(grid.i_low_bound() + segment.i), (uint_t)(grid.j_low_bound() + segment.j), grid.k_min()},
             {0, 0, 0},
             {extent_t::iminus::value,
                 extent_t::jminus::value,
                 static_cast<int_t>(grid.template value_at<from_t>() - grid.k_min())});
 
         // run the nested ij loop
-        const uint_t size_i =
-            grid.i_high_bound() - grid.i_low_bound() + 1 + extent_t::iplus::value - extent_t::iminus::value;
-        const uint_t size_j =
-            grid.j_high_bound() - grid.j_low_bound() + 1 + extent_t::jplus::value - extent_t::jminus::value;
+        const uint_t size_i = segment.i_size + extent_t::iplus::value - extent_t::iminus::value;
+        const uint_t size_j = segment.j_size + extent_t::jplus::value - extent_t::jminus::value;
         for (uint_t i = 0; i != size_i; ++i) {
             auto irestore_index = it_domain.index();
             for (uint_t j = 0; j != size_j; ++j) {
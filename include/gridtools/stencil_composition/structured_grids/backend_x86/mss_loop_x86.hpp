@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../../backend_x86/basic_token_execution_x86.hpp"
+#include "../../column_mask.hpp"
 #include "../../iteration_policy.hpp"
 #include "../../pos3.hpp"
 #include "../positional_iterate_domain.hpp"
@@ -20,6 +21,41 @@
  * @brief mss loop implementations for the x86 backend
  */
 namespace gridtools {
+    namespace _impl_mss_loop_x86 {
+        /**
+         * @brief Origin, block number and size of the region that is executed by one call to `mss_loop`.
+         */
+        struct block_bounds {
+            pos3<uint_t> begin;
+            pos3<uint_t> block_no;
+            uint_t size_i;
+            uint_t size_j;
+        };
+
+        template <class Grid, class ExecutionInfo>
+        block_bounds get_block_bounds(
+            backend::x86 const &backend_target, Grid const &grid, ExecutionInfo const &execution_info) {
+            auto block_size_f = [](uint_t total, uint_t block_size, uint_t block_no) {
+                auto n = (total + block_size - 1) / block_size;
+                return block_no == n - 1 ? total - block_no * block_size : block_size;
+            };
+            auto total_i = grid.i_high_bound() - grid.i_low_bound() + 1;
+            auto total_j = grid.j_high_bound() - grid.j_low_bound() + 1;
+            return {{grid.i_low_bound(), grid.j_low_bound(), grid.k_min()},
+                {execution_info.bi, execution_info.bj, 0},
+                block_size_f(total_i, block_i_size(backend_target), execution_info.bi),
+                block_size_f(total_j, block_j_size(backend_target), execution_info.bj)};
+        }
+
+        template <class Grid>
+        block_bounds get_block_bounds(backend::x86 const &, Grid const &grid, column_segment const &segment) {
+            return {{(uint_t)(grid.i_low_bound() + segment.i), (uint_t)(grid.j_low_bound() + segment.j), grid.k_min()},
+                {0, 0, 0},
+                (uint_t)segment.i_size,
+                (uint_t)segment.j_size};
+        }
+    } // namespace _impl_mss_loop_x86
+
     /**
      * @brief main execution of a mss. Defines the IJ loop bounds of this particular block
      * and sequentially executes all the functors in the mss
@@ -48,22 +84,16 @@ namespace gridtools {
         using extent_t = GT_META_CALL(get_extent_from_loop_intervals, typename RunFunctorArgs::loop_intervals_t);
         using interval_t = GT_META_CALL(meta::first, typename RunFunctorArgs::loop_intervals_t);
         using from_t = GT_META_CALL(meta::first, interval_t);
-        it_domain.initialize({grid.i_low_bound(), grid.j_low_bound(), grid.k_min()},
-            {execution_info.bi, execution_info.bj, 0},
+        const auto bounds = _impl_mss_loop_x86::get_block_bounds(backend_target, grid, execution_info);
+        it_domain.initialize(bounds.begin,
+            bounds.block_no,
             {extent_t::iminus::value,
                 extent_t::jminus::value,
-                static_cast<int_t>(grid.template value_at<from_t>() - grid.k_min())});
+                static_cast<int_t>(grid.template value_at<from_t>() - grid.k_min())},
+            backend_target);
 
-        auto block_size_f = [](uint_t total, uint_t block_size, uint_t block_no) {
-            auto n = (total + block_size - 1) / block_size;
-            return block_no == n - 1 ? total - block_no * block_size : block_size;
-        };
-        auto total_i = grid.i_high_bound() - grid.i_low_bound() + 1;
-        auto total_j = grid.j_high_bound() - grid.j_low_bound() + 1;
-        const uint_t size_i = block_size_f(total_i, block_i_size(backend_target), execution_info.bi) +
-                              extent_t::iplus::value - extent_t::iminus::value;
-        const uint_t size_j = block_size_f(total_j, block_j_size(backend_target), execution_info.bj) +
-                              extent_t::jplus::value - extent_t::jminus::value;
+        const uint_t size_i = bounds.size_i + extent_t::iplus::value - extent_t::iminus::value;
+        const uint_t size_j = bounds.size_j + extent_t::jplus::value - extent_t::jminus::value;
 
         // run the nested ij loop
         for (uint_t i = 0; i != size_i; ++i) {
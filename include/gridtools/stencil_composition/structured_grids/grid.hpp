@@ -14,9 +14,9 @@
 
 namespace gridtools {
 
-    template <typename Axis>
-    struct grid : grid_base<Axis> {
-        using base_type = grid_base<Axis>;
+    template <typename Axis, class StaticSplitters = void>
+    struct grid : grid_base<Axis, StaticSplitters> {
+        using base_type = grid_base<Axis, StaticSplitters>;
 
         GT_FUNCTION
         explicit grid(halo_descriptor const &direction_i,
@@ -46,4 +46,23 @@ namespace gridtools {
         halo_descriptor const &direction_i, halo_descriptor const &direction_j, uint_t dk) {
         return make_grid(direction_i, direction_j, axis<1>(dk));
     }
+
+    template <class StaticAxis>
+    using static_grid_t = grid<typename StaticAxis::axis_interval_t, typename StaticAxis::static_splitters_t>;
+
+    /**
+     * Makes a grid with compile time vertical bounds, see static_axis.
+     */
+    template <typename Axis, uint_t... IntervalSizes>
+    GT_FUNCTION_HOST static_grid_t<static_axis<Axis, IntervalSizes...>> make_grid(halo_descriptor const &direction_i,
+        halo_descriptor const &direction_j,
+        static_axis<Axis, IntervalSizes...> const &axis) {
+        return static_grid_t<static_axis<Axis, IntervalSizes...>>(
+            direction_i, direction_j, _impl::intervals_to_indices(axis.interval_sizes()));
+    }
+    template <typename Axis, uint_t... IntervalSizes>
+    GT_FUNCTION_HOST static_grid_t<static_axis<Axis, IntervalSizes...>> make_grid(
+        uint_t di, uint_t dj, static_axis<Axis, IntervalSizes...> const &axis) {
+        return make_grid(halo_descriptor(di), halo_descriptor(dj), axis);
+    }
 } // namespace gridtools
@@ -97,12 +97,15 @@ namespace gridtools {
             increment<dim::k>(offset);
         }
 
-        /**@brief method for initializing the index */
-        GT_FUNCTION void initialize(pos3<uint_t> begin, pos3<uint_t> block_no, pos3<int_t> pos_in_block) {
+        /**@brief method for initializing the index, `backend` provides the block size */
+        GT_FUNCTION void initialize(pos3<uint_t> begin,
+            pos3<uint_t> block_no,
+            pos3<int_t> pos_in_block,
+            typename IterateDomainArguments::backend_t const &backend = {}) {
             using backend_t = typename IterateDomainArguments::backend_t;
             host_device::for_each_type<typename local_domain_t::strides_kinds_t>(
                 initialize_index<backend_t, local_domain_t>(
-                    local_domain.m_strides_map, begin, block_no, pos_in_block, m_index));
+                    local_domain.m_strides_map, backend, begin, block_no, pos_in_block, m_index));
         }
 
         template <class Arg, class DataStore = typename Arg::data_store_t, class Data = typename DataStore::data_t>
@@ -47,14 +47,15 @@ namespace gridtools {
             Base::template increment_k(offset);
         }
 
-        GT_FUNCTION void initialize(pos3<uint_t> begin, pos3<uint_t> block_no, pos3<int_t> pos_in_block) {
-            static constexpr auto backend = typename Base::iterate_domain_arguments_t::backend_t{};
-            static constexpr auto block_size =
-                make_pos3(block_i_size(backend), block_j_size(backend), block_k_size(backend));
+        using backend_t = typename Base::iterate_domain_arguments_t::backend_t;
+
+        GT_FUNCTION void initialize(
+            pos3<uint_t> begin, pos3<uint_t> block_no, pos3<int_t> pos_in_block, backend_t const &backend = {}) {
+            const auto block_size = make_pos3(block_i_size(backend), block_j_size(backend), block_k_size(backend));
             m_pos.i = begin.i + block_no.i * block_size.i + pos_in_block.i;
             m_pos.j = begin.j + block_no.j * block_size.j + pos_in_block.j;
             m_pos.k = begin.k + block_no.k * block_size.k + pos_in_block.k;
-            Base::initialize(begin, block_no, pos_in_block);
+            Base::initialize(begin, block_no, pos_in_block, backend);
         }
 
         GT_FUNCTION array_index_t index() const { return {Base::index(), m_pos}; }
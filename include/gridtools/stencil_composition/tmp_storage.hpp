@@ -15,6 +15,7 @@
  *
  *  Facade API:
  *    1. DataStore make_tmp_data_store<MaxExtent>(Backend, Arg, Grid);
+ *       StorageInfo make_tmp_storage_info<MaxExtent>(Backend, Arg, Grid);
  *    2. int_t get_tmp_storage_offset<StorageInfo, MaxExtent>(Backend, Strides, BlockIds, PositionsInBlock);
  *  where:
  *    MaxExtent - integral_constant with maximal absolute extent in I direction.
@@ -74,20 +75,30 @@ namespace gridtools {
         constexpr std::true_type needs_allocate_cached_tmp(Backend const &) {
             return {};
         }
+
+        template <class Backend>
+        constexpr std::false_type sized_per_thread(Backend const &) {
+            return {};
+        }
     } // namespace tmp_storage
 
     template <class MaxExtent, class ArgTag, class DataStore, int_t I, uint_t NColors, class Backend, class Grid>
-    DataStore make_tmp_data_store(
+    typename DataStore::storage_info_t make_tmp_storage_info(
         Backend const &backend, plh<ArgTag, DataStore, location_type<I, NColors>, true> const &, Grid const &grid) {
         GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
         using namespace tmp_storage;
         using storage_info_t = typename DataStore::storage_info_t;
-        return {make_storage_info<storage_info_t, NColors>(backend,
+        return make_storage_info<storage_info_t, NColors>(backend,
             get_i_size<storage_info_t, MaxExtent>(
                 backend, block_i_size(backend, grid), grid.i_high_bound() - grid.i_low_bound() + 1),
             get_j_size<storage_info_t, MaxExtent>(
                 backend, block_j_size(backend, grid), grid.j_high_bound() - grid.j_low_bound() + 1),
-            get_k_size<storage_info_t, MaxExtent>(backend, block_k_size(backend, grid), grid.k_total_length()))};
+            get_k_size<storage_info_t, MaxExtent>(backend, block_k_size(backend, grid), grid.k_total_length()));
+    }
+
+    template <class MaxExtent, class Arg, class Backend, class Grid>
+    typename Arg::data_store_t make_tmp_data_store(Backend const &backend, Arg const &arg, Grid const &grid) {
+        return {make_tmp_storage_info<MaxExtent>(backend, arg, grid)};
     }
 
     template <class StorageInfo, class MaxExtent, class Backend, class Stride, class BlockNo, class PosInBlock>
@@ -96,8 +107,7 @@ namespace gridtools {
         BlockNo const &GT_RESTRICT block_no,
         PosInBlock const &GT_RESTRICT pos_in_block) {
         using namespace tmp_storage;
-        static constexpr auto block_size =
-            make_pos3(block_i_size(Backend{}), block_j_size(Backend{}), block_k_size(Backend{}));
+        const auto block_size = make_pos3(block_i_size(backend), block_j_size(backend), block_k_size(backend));
         return stride.i *
                    (get_i_block_offset<StorageInfo, MaxExtent>(backend, block_size.i, block_no.i) + pos_in_block.i) +
                stride.j *
@@ -110,4 +120,11 @@ namespace gridtools {
     GT_META_DEFINE_ALIAS(
         needs_allocate_cached_tmp, meta::id, decltype(::gridtools::tmp_storage::needs_allocate_cached_tmp(Backend{})));
 
+    /**
+     * True if the temporaries of the backend hold one slice per thread, i.e. their size depends on host_max_threads().
+     */
+    template <class Backend>
+    GT_META_DEFINE_ALIAS(
+        tmp_sized_per_thread, meta::id, decltype(::gridtools::tmp_storage::sized_per_thread(Backend{})));
+
 } // namespace gridtools
@@ -0,0 +1,96 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <string>
+
+#include "../../common/defs.hpp"
+#include "../../common/layout_map.hpp"
+#include "../../meta/utility.hpp"
+
+namespace gridtools {
+
+    /** \ingroup storage
+     * @{
+     */
+
+    /**
+     * @brief The order of the i, j and k dimensions in memory. `I`, `J` and `K` are the ranks of the dimensions, the
+     * dimension with rank 2 is contiguous. Dimensions beyond the third are placed outside of the three.
+     */
+    template <int I, int J, int K>
+    struct dimension_order {
+        GT_STATIC_ASSERT(I != J && I != K && J != K && I >= 0 && J >= 0 && K >= 0 && I < 3 && J < 3 && K < 3,
+            "The ranks of a dimension order should be a permutation of 0, 1, 2.");
+    };
+
+    /**
+     * @brief The six orders of the i, j and k dimensions, named from the outermost to the contiguous dimension.
+     */
+    namespace dimension_orders {
+        using ijk = dimension_order<0, 1, 2>;
+        using ikj = dimension_order<0, 2, 1>;
+        using jik = dimension_order<1, 0, 2>;
+        using jki = dimension_order<2, 0, 1>;
+        using kij = dimension_order<1, 2, 0>;
+        using kji = dimension_order<2, 1, 0>;
+    } // namespace dimension_orders
+
+    /**
+     * @brief The name of a dimension order, e.g. "jki".
+     */
+    template <int I, int J, int K>
+    std::string to_string(dimension_order<I, J, K>) {
+        std::string res(3, ' ');
+        res[I] = 'i';
+        res[J] = 'j';
+        res[K] = 'k';
+        return res;
+    }
+
+    namespace _impl {
+        template <class Order, class Indices>
+        struct dimension_order_layout;
+
+        template <int I, int J, int K, std::size_t... Is>
+        struct dimension_order_layout<dimension_order<I, J, K>, meta::index_sequence<Is...>> {
+            static constexpr int ndims = sizeof...(Is);
+            static constexpr int first = ndims < 3 ? ndims : 3;
+            static constexpr int ranks[3] = {I, J, K};
+
+            // the number of dimensions among the first three that are placed outside of dimension `dim`
+            static constexpr int outer(int dim, int other = 0) {
+                return other == first ? 0 : (ranks[other] < ranks[dim]) + outer(dim, other + 1);
+            }
+
+            static constexpr int value(int dim) { return dim < 3 ? ndims - first + outer(dim) : ndims - 1 - dim; }
+
+            using type = layout_map<value(Is)...>;
+        };
+
+        template <int I, int J, int K, std::size_t... Is>
+        constexpr int dimension_order_layout<dimension_order<I, J, K>, meta::index_sequence<Is...>>::ranks[3];
+    } // namespace _impl
+
+    /**
+     * @brief The layout map with `Dims` dimensions in which the first three dimensions are ordered as given by
+     * `Order`. Masked dimensions can be removed with `get_special_layout`.
+     *
+     * E.g., `dimension_order_layout_t<dimension_orders::jki, 4>` is `layout_map<3, 1, 2, 0>`.
+     */
+    template <class Order, uint_t Dims>
+    using dimension_order_layout_t =
+        typename _impl::dimension_order_layout<Order, meta::make_index_sequence<Dims>>::type;
+
+    /**
+     * @}
+     */
+} // namespace gridtools
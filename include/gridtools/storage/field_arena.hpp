@@ -0,0 +1,241 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../common/defs.hpp"
+#include "../common/hugepage_alloc.hpp"
+#include "./common/definitions.hpp"
+#include "./data_store.hpp"
+
+namespace gridtools {
+
+    /** \ingroup storage
+     * @{
+     */
+
+    /**
+     * @brief Allocates the fields of a model in large huge-page backed regions, at offsets that avoid cache set
+     * conflicts between fields that are accessed together.
+     *
+     * Separately allocated fields with the same padded sizes start at addresses that differ by multiples of the page
+     * size, such that the same point of different fields maps to the same L1 cache set (4K aliasing). The arena
+     * places every field such that the address of its first inner point, modulo `period` bytes, is as far as possible
+     * from those of the other fields of its group, including the neighbouring rows and planes of the other fields
+     * (given by the strides). A group consists of `fields_per_group` consecutively made fields, or ends early with
+     * `next_group()`.
+     *
+     * Note that hugepage_alloc already shifts consecutive allocations by 64 to 4096 bytes. The arena only pays off
+     * if a stencil accesses more rows at once than the L1 cache has ways (e.g. 8-way L1 caches); see the benchmark in
+     * test_field_arena.cpp.
+     *
+     * The data_stores made by the arena alias its memory (ownership::external_cpu): the memory is released when the
+     * arena is destroyed, and the data_stores must not be used afterwards. Only CPU storages are supported.
+     */
+    class field_arena {
+      public:
+        /** @brief Where a field was placed. */
+        struct placement {
+            std::string name;
+            std::size_t region;
+            std::size_t offset;     // bytes from the beginning of the region to the first element
+            std::size_t bytes;      // size of the field including padding
+            std::size_t set_offset; // address of the first inner point modulo the period
+            std::size_t group;
+        };
+
+      private:
+        struct region {
+            std::unique_ptr<void, std::integral_constant<decltype(&hugepage_free), &hugepage_free>> m_holder;
+            std::size_t m_size;
+            std::size_t m_used;
+        };
+
+        static constexpr std::size_t cache_line() { return 64; }
+
+        std::size_t m_fields_per_group;
+        std::size_t m_region_bytes;
+        std::size_t m_period;
+        std::vector<region> m_regions;
+        std::vector<placement> m_placements;
+        std::size_t m_group = 0;
+        // the set offsets and the strides (modulo the period) of the fields in the current group
+        std::vector<std::size_t> m_group_offsets;
+        std::vector<std::vector<std::size_t>> m_group_strides;
+
+        std::size_t distance(std::size_t a, std::size_t b) const {
+            std::size_t d = (a + m_period - b) % m_period;
+            return std::min(d, m_period - d);
+        }
+
+        // the distance of the given set offset to the closest point (or neighbour row) of the group
+        std::size_t conflict_distance(std::size_t offset, std::vector<std::size_t> const &strides) const {
+            std::size_t res = m_period;
+            for (std::size_t f = 0; f < m_group_offsets.size(); ++f) {
+                std::vector<std::size_t> shifts = {0};
+                for (auto const *s : {&strides, &m_group_strides[f]})
+                    for (auto stride : *s) {
+                        shifts.push_back(stride);
+                        shifts.push_back(m_period - stride);
+                    }
+                for (auto shift : shifts)
+                    res = std::min(res, distance((offset + shift) % m_period, m_group_offsets[f]));
+            }
+            return res;
+        }
+
+        std::size_t choose_set_offset(std::vector<std::size_t> const &strides, std::size_t granularity) const {
+            std::size_t best = 0, best_distance = 0;
+            for (std::size_t offset = 0; offset < m_period; offset += granularity) {
+                std::size_t d = conflict_distance(offset, strides);
+                if (d > best_distance) {
+                    best = offset;
+                    best_distance = d;
+                }
+            }
+            return best;
+        }
+
+        // returns the address of the first element of a field of `bytes` bytes whose first inner point is `origin`
+        // bytes after the first element and has the given set offset
+        char *allocate(std::string const &name,
+            std::size_t bytes,
+            std::size_t origin,
+            std::size_t set_offset,
+            std::vector<std::size_t> const &strides) {
+            auto place = [&](region const &r) {
+                auto free = reinterpret_cast<std::uintptr_t>(r.m_holder.get()) + r.m_used;
+                return r.m_used + (set_offset + 2 * m_period - (free + origin) % m_period) % m_period;
+            };
+            if (m_regions.empty() || place(m_regions.back()) + bytes > m_regions.back().m_size) {
+                std::size_t size = std::max(m_region_bytes, bytes + m_period);
+                m_regions.push_back({decltype(region::m_holder)(hugepage_alloc(size)), size, 0});
+            }
+            region &r = m_regions.back();
+            std::size_t offset = place(r);
+            r.m_used = (offset + bytes + cache_line() - 1) / cache_line() * cache_line();
+
+            m_placements.push_back({name, m_regions.size() - 1, offset, bytes, set_offset, m_group});
+            m_group_offsets.push_back(set_offset);
+            m_group_strides.push_back(strides);
+            if (m_group_offsets.size() == m_fields_per_group)
+                next_group();
+            return static_cast<char *>(r.m_holder.get()) + offset;
+        }
+
+        template <class DataStore>
+        DataStore make_data_store(typename DataStore::storage_info_t const &info, std::string const &name) {
+            using data_t = typename DataStore::data_t;
+            using storage_info_t = typename DataStore::storage_info_t;
+            std::size_t align_bytes = storage_info_t::alignment_t::value * sizeof(data_t);
+            std::size_t granularity = std::max(cache_line(), align_bytes);
+            if (m_period % granularity)
+                throw std::runtime_error("field_arena: the period should be a multiple of the alignment");
+
+            std::vector<std::size_t> strides;
+            for (auto stride : info.strides())
+                if (stride > 1)
+                    strides.push_back(stride * sizeof(data_t) % m_period);
+            std::size_t set_offset = choose_set_offset(strides, granularity);
+            char *ptr = allocate(name,
+                info.padded_total_length() * sizeof(data_t),
+                info.first_index_of_inner_region() * sizeof(data_t),
+                set_offset,
+                strides);
+            return DataStore(info, reinterpret_cast<data_t *>(ptr), ownership::external_cpu, name);
+        }
+
+      public:
+        /**
+         * @param fields_per_group The number of consecutively made fields that are accessed together.
+         * @param region_bytes The size of the regions that are allocated at once.
+         * @param period The period of the cache set mapping in bytes, the size of a way of the L1 cache.
+         */
+        explicit field_arena(
+            std::size_t fields_per_group = 8, std::size_t region_bytes = 64 << 20, std::size_t period = 4096)
+            : m_fields_per_group(fields_per_group), m_region_bytes(region_bytes), m_period(period) {
+            if (fields_per_group == 0 || period == 0 || period % cache_line())
+                throw std::runtime_error("field_arena: invalid group size or period");
+        }
+
+        field_arena(field_arena const &) = delete;
+        field_arena &operator=(field_arena const &) = delete;
+
+        /**
+         * @brief Makes an uninitialized data_store in the arena.
+         */
+        template <class DataStore>
+        DataStore make(typename DataStore::storage_info_t const &info, std::string const &name = "") {
+            GT_STATIC_ASSERT(is_data_store<DataStore>::value, "Given type is not a data_store type.");
+            return make_data_store<DataStore>(info, name);
+        }
+
+        /**
+         * @brief Makes a data_store in the arena and initializes it with `value`.
+         */
+        template <class DataStore>
+        DataStore make(typename DataStore::storage_info_t const &info,
+            typename DataStore::data_t value,
+            std::string const &name = "") {
+            GT_STATIC_ASSERT(is_data_store<DataStore>::value, "Given type is not a data_store type.");
+            auto res = make_data_store<DataStore>(info, name);
+            auto *ptr = res.get_storage_ptr()->get_cpu_ptr();
+            std::fill(ptr, ptr + info.padded_total_length(), value);
+            return res;
+        }
+
+        /**
+         * @brief Starts a new group, the following fields are placed independently of the previous ones.
+         */
+        void next_group() {
+            if (m_group_offsets.empty())
+                return;
+            ++m_group;
+            m_group_offsets.clear();
+            m_group_strides.clear();
+        }
+
+        std::vector<placement> const &placements() const { return m_placements; }
+
+        std::size_t allocated_bytes() const {
+            std::size_t res = 0;
+            for (auto const &r : m_regions)
+                res += r.m_size;
+            return res;
+        }
+
+        /**
+         * @brief A table with the placement of all fields.
+         */
+        std::string report() const {
+            std::ostringstream out;
+            out << "field arena: " << m_placements.size() << " fields in " << m_regions.size() << " regions, "
+                << allocated_bytes() << " bytes\n";
+            for (auto const &p : m_placements)
+                out << "  " << (p.name.empty() ? "<unnamed>" : p.name) << ": group " << p.group << ", region "
+                    << p.region << ", offset " << p.offset << ", " << p.bytes << " bytes, set offset " << p.set_offset
+                    << "\n";
+            return out.str();
+        }
+    };
+
+    /**
+     * @}
+     */
+} // namespace gridtools
@@ -0,0 +1,195 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+#include "../common/array.hpp"
+#include "../common/defs.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "../common/layout_map.hpp"
+#include "../meta/utility.hpp"
+#include "./common/halo.hpp"
+#include "./common/storage_info.hpp"
+#include "./data_store.hpp"
+
+namespace gridtools {
+
+    /** \ingroup storage
+     * @{
+     */
+
+    namespace interleaved_data_store_impl_ {
+        // the component dimension is placed right outside of the contiguous dimension
+        template <class Layout>
+        struct group_layout;
+
+        template <int... Args>
+        struct group_layout<layout_map<Args...>> {
+            static constexpr int max = layout_map<Args...>::max();
+            using type = layout_map<(Args == max ? max + 1 : Args)..., max>;
+        };
+
+        template <uint_t ComponentId, class StorageInfo>
+        struct component_storage_info;
+
+        template <uint_t ComponentId, uint_t Id, class Layout, class Halo, class Alignment>
+        struct component_storage_info<ComponentId, storage_info<Id, Layout, Halo, Alignment>> {
+            using type = storage_info<ComponentId, Layout, Halo, Alignment>;
+        };
+
+        template <class StorageInfo>
+        struct group_storage_info;
+
+        template <uint_t Id, class Layout, uint_t... Halos, class Alignment>
+        struct group_storage_info<storage_info<Id, Layout, halo<Halos...>, Alignment>> {
+            using type = storage_info<Id, typename group_layout<Layout>::type, halo<Halos..., 0>, Alignment>;
+        };
+
+        template <class StorageInfo, class Lengths, std::size_t... Is>
+        StorageInfo make_storage_info(Lengths const &lengths, uint_t n, meta::index_sequence<Is...>) {
+            return StorageInfo(lengths[Is]..., n);
+        }
+    } // namespace interleaved_data_store_impl_
+
+    /**
+     * @brief N fields of the same type and size that share one allocation, interleaved row by row.
+     *
+     * Fields that are always accessed together at the same offsets (e.g. the components of the wind or a set of
+     * tracers) are stored in one block of memory, the rows along the contiguous dimension of the N fields follow each
+     * other. With the default mc layout, the i-rows of all fields at a given (j, k) are adjacent in memory. A stencil
+     * that reads all components at the same point touches one contiguous block instead of N separate arrays, which
+     * reduces the number of concurrent memory streams and TLB entries by a factor of N. The rows stay contiguous and
+     * aligned, such that the vectorization along i is not affected.
+     *
+     * Every component is a regular data_store (`component_t`) that aliases the memory of the group: it can be bound to
+     * its own placeholder, viewed, passed to `interface::transform` with its `strides()` and exchanged with
+     * `distributed_boundaries` (see `comm_halos`). The group has to outlive the components.
+     *
+     * The strides of the components differ from those of an ordinary `DataStore` with the same sizes. Because a
+     * computation keeps one set of strides per storage info type, the components get their own storage info type,
+     * which is the one of `DataStore` with the id `ComponentId`. As for any storage info type, all storages with the
+     * id `ComponentId` that are bound to one computation need the same sizes (here: the same sizes and the same N).
+     * Only CPU storages are supported.
+     *
+     * @tparam DataStore the data_store type of an ordinary field with the data type, layout, halo and alignment of the
+     * components
+     * @tparam N the number of components
+     * @tparam ComponentId the storage info id of the components, different from the ids of the ordinary fields
+     */
+    template <class DataStore, uint_t N, uint_t ComponentId>
+    class interleaved_data_store {
+        GT_STATIC_ASSERT(is_data_store<DataStore>::value, "Given type is not a data_store type.");
+        GT_STATIC_ASSERT(N > 0, "An interleaved data store needs at least one component.");
+        GT_STATIC_ASSERT(ComponentId != DataStore::storage_info_t::id,
+            "The components need a storage info id different from the one of the given data_store type.");
+
+      public:
+        using data_t = typename DataStore::data_t;
+        using storage_info_t = typename DataStore::storage_info_t;
+        using component_storage_info_t =
+            typename interleaved_data_store_impl_::component_storage_info<ComponentId, storage_info_t>::type;
+        using component_t = data_store<typename DataStore::storage_t, component_storage_info_t>;
+        using group_storage_info_t =
+            typename interleaved_data_store_impl_::group_storage_info<component_storage_info_t>::type;
+        using group_t = data_store<typename DataStore::storage_t, group_storage_info_t>;
+
+      private:
+        static constexpr uint_t ndims = storage_info_t::ndims;
+
+        group_t m_group;
+        std::array<component_t, N> m_components;
+
+        void make_components(storage_info_t const &info, std::string const &name) {
+            auto const &group_info = *m_group.get_storage_info_ptr();
+            array<uint_t, ndims> strides;
+            for (uint_t d = 0; d < ndims; ++d)
+                strides[d] = group_info.strides()[d];
+            component_storage_info_t component_info(info.total_lengths(), strides);
+            data_t *ptr = m_group.get_storage_ptr()->get_cpu_ptr();
+            for (uint_t c = 0; c < N; ++c)
+                m_components[c] = component_t(component_info,
+                    ptr + c * group_info.strides()[ndims],
+                    ownership::external_cpu,
+                    name + "_" + std::to_string(c));
+        }
+
+        static group_storage_info_t make_group_info(storage_info_t const &info) {
+            return interleaved_data_store_impl_::make_storage_info<group_storage_info_t>(
+                info.total_lengths(), N, meta::make_index_sequence<ndims>{});
+        }
+
+      public:
+        /**
+         * @brief Allocates the memory of N fields with the sizes of `info`.
+         */
+        interleaved_data_store(storage_info_t const &info, std::string const &name = "")
+            : m_group(make_group_info(info), name) {
+            make_components(info, name);
+        }
+
+        /**
+         * @brief Allocates the memory of N fields with the sizes of `info` and initializes all of them with `value`.
+         */
+        interleaved_data_store(storage_info_t const &info, data_t value, std::string const &name = "")
+            : m_group(make_group_info(info), value, name) {
+            make_components(info, name);
+        }
+
+        interleaved_data_store(interleaved_data_store const &) = delete;
+        interleaved_data_store &operator=(interleaved_data_store const &) = delete;
+
+        static constexpr uint_t size() { return N; }
+
+        /**
+         * @brief The `c`-th field of the group.
+         */
+        component_t const &operator[](uint_t c) const { return m_components[c]; }
+
+        std::array<component_t, N> const &components() const { return m_components; }
+
+        /**
+         * @brief The memory of all fields as one data_store, the component is the last dimension.
+         */
+        group_t const &group() const { return m_group; }
+
+        /**
+         * @brief The halo descriptors for a halo exchange of the components of this group.
+         *
+         * The communication library addresses a field through the total lengths of the halo descriptors; for the
+         * components, the length of every dimension but the outermost one is replaced by the distance to the next
+         * dimension in memory, which includes the padding and the rows of the other components.
+         */
+        array<halo_descriptor, 3> comm_halos(array<halo_descriptor, 3> const &halos) const {
+            GT_STATIC_ASSERT(ndims == 3, "Only three dimensional fields can be exchanged.");
+            using layout_t = typename storage_info_t::layout_t;
+            auto const &strides = m_components[0].strides();
+            array<halo_descriptor, 3> res = halos;
+            for (uint_t d = 0; d < 3; ++d) {
+                int rank = layout_t::at(d);
+                if (rank <= 0)
+                    continue;
+                uint_t outer = strides[layout_t::find(rank - 1)];
+                if (outer % strides[d])
+                    throw std::runtime_error("interleaved_data_store: the strides are not nested");
+                res[d] = halo_descriptor(
+                    halos[d].minus(), halos[d].plus(), halos[d].begin(), halos[d].end(), outer / strides[d]);
+            }
+            return res;
+        }
+    };
+
+    /**
+     * @}
+     */
+} // namespace gridtools
@@ -13,6 +13,7 @@
 #include "../common/defs.hpp"
 #include "../common/layout_map.hpp"
 #include "../common/selector.hpp"
+#include "./common/dimension_order.hpp"
 #include "./common/halo.hpp"
 #include "./common/storage_traits_metafunctions.hpp"
 #include "./storage_mc/mc_storage.hpp"
@@ -102,5 +103,27 @@ namespace gridtools {
 #endif
             using type = storage_info<Id, typename get_special_layout<layout, Selector>::type, Halo, Align>;
         };
+
+        template <uint_t Id, typename Order, typename Selector, typename Halo>
+        struct select_ordered_storage_info {
+            GT_STATIC_ASSERT(is_halo<Halo>::value, "Given type is not a halo type.");
+            GT_STATIC_ASSERT(is_selector<Selector>::value, "Given type is not a selector type.");
+            using layout = dimension_order_layout_t<Order, Selector::size()>;
+            using type = mc_storage_info<Id, typename get_special_layout<layout, Selector>::type, Halo>;
+        };
+
+        /**
+         * @brief Storage info of a field family (all fields with the same `Id`) with the i, j and k dimensions
+         * ordered in memory as given by `Order`, e.g. `dimension_orders::ijk` for contiguous columns. The default
+         * layout of the mc backend is `dimension_orders::jki`.
+         *
+         * Different families of a computation can use different orders, `tools/layout_benchmark.hpp` measures which
+         * order fits a computation best.
+         */
+        template <uint_t Id, typename Order, uint_t Dims = 3, typename Halo = zero_halo<Dims>>
+        using ordered_storage_info_t = mc_storage_info<Id, dimension_order_layout_t<Order, Dims>, Halo>;
+
+        template <uint_t Id, typename Order, typename Selector, typename Halo = zero_halo<Selector::size()>>
+        using ordered_special_storage_info_t = typename select_ordered_storage_info<Id, Order, Selector, Halo>::type;
     };
 } // namespace gridtools
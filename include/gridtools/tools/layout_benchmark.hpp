@@ -0,0 +1,136 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../common/defs.hpp"
+#include "../common/generic_metafunctions/for_each.hpp"
+#include "../meta/list.hpp"
+#include "../storage/common/dimension_order.hpp"
+
+/**
+ * @file
+ * Benchmark of the dimension order of the storages of a computation.
+ *
+ * The best order of the i, j and k dimensions in memory depends on the stencils: horizontal stencils prefer
+ * i-contiguous planes, vertical solvers prefer contiguous columns. `benchmark_layouts` runs a computation with all
+ * given orders on a set of representative domain sizes and reports the fastest order per size. The result can be
+ * applied per field family with `storage_traits<backend::mc>::ordered_storage_info_t`.
+ *
+ * The computation is built by a user-provided factory, a functor with a template call operator taking the order (as a
+ * value of type `dimension_order<...>`) and the domain size. The factory allocates and initializes the storages with
+ * the given order and returns an object with a `run()` member function:
+ *
+ * \code
+ * struct make_solver {
+ *     template <class Order>
+ *     computation<> operator()(Order, std::array<uint_t, 3> const &size) const {
+ *         using storage_info_t = storage_traits<backend::mc>::ordered_storage_info_t<0, Order>;
+ *         ...
+ *     }
+ * };
+ * auto timings = benchmark_layouts<dimension_orders::jki, dimension_orders::ijk>(make_solver{}, {{{128, 128, 80}}});
+ * std::cout << layout_report(timings);
+ * \endcode
+ */
+namespace gridtools {
+
+    /** @brief The time per run of a computation with the given dimension order and domain size. */
+    struct layout_timing {
+        std::string order;
+        std::array<uint_t, 3> size;
+        double seconds;
+    };
+
+    namespace layout_benchmark_impl_ {
+        template <class Factory>
+        struct measure_f {
+            Factory const &m_factory;
+            std::array<uint_t, 3> const &m_size;
+            int m_repetitions;
+            std::vector<layout_timing> &m_timings;
+
+            template <class Order>
+            void operator()(Order order) const {
+                auto comp = m_factory(order, m_size);
+                // the first run is a warm-up, it touches the memory of the storages for the first time
+                comp.run();
+                double best = std::numeric_limits<double>::max();
+                for (int r = 0; r < m_repetitions; ++r) {
+                    auto start = std::chrono::steady_clock::now();
+                    comp.run();
+                    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                    best = std::min(best, elapsed.count());
+                }
+                m_timings.push_back({to_string(order), m_size, best});
+            }
+        };
+    } // namespace layout_benchmark_impl_
+
+    /**
+     * @brief Runs the computations made by `factory` with all `Orders` on all `sizes`.
+     *
+     * @return The minimum time of `repetitions` runs for every size and order, grouped by size.
+     */
+    template <class... Orders, class Factory>
+    std::vector<layout_timing> benchmark_layouts(
+        Factory const &factory, std::vector<std::array<uint_t, 3>> const &sizes, int repetitions = 5) {
+        if (repetitions <= 0)
+            throw std::runtime_error("benchmark_layouts: the number of repetitions should be positive");
+        std::vector<layout_timing> res;
+        for (auto const &size : sizes)
+            host::for_each<meta::list<Orders...>>(
+                layout_benchmark_impl_::measure_f<Factory>{factory, size, repetitions, res});
+        return res;
+    }
+
+    /**
+     * @brief The fastest timing for every domain size, in the order of the first appearance of the size.
+     */
+    inline std::vector<layout_timing> best_layouts(std::vector<layout_timing> const &timings) {
+        std::vector<layout_timing> res;
+        for (auto const &timing : timings) {
+            auto it = std::find_if(
+                res.begin(), res.end(), [&](layout_timing const &other) { return other.size == timing.size; });
+            if (it == res.end())
+                res.push_back(timing);
+            else if (timing.seconds < it->seconds)
+                *it = timing;
+        }
+        return res;
+    }
+
+    /**
+     * @brief A table with all timings, the fastest order of each size is marked with a star.
+     */
+    inline std::string layout_report(std::vector<layout_timing> const &timings) {
+        auto best = best_layouts(timings);
+        std::ostringstream out;
+        for (auto const &timing : timings) {
+            bool is_best = std::find_if(best.begin(), best.end(), [&](layout_timing const &other) {
+                return other.size == timing.size && other.order == timing.order;
+            }) != best.end();
+            out << timing.size[0] << "x" << timing.size[1] << "x" << timing.size[2] << " " << timing.order << ": "
+                << std::fixed << std::setprecision(3) << timing.seconds * 1e3 << " ms" << (is_best ? " *" : "")
+                << "\n";
+        }
+        return out.str();
+    }
+} // namespace gridtools
@@ -54,6 +54,22 @@ def run(args):
     perftest.result.save(args.output, result)
 
 
+def tilesweep(args):
+    import perftest.config
+    import perftest.tilesweep
+
+    config = perftest.config.get(args.config)
+    rt = config.runtime('gridtools')
+    tiles = [perftest.tilesweep.parse_tile(t) for t in args.tiles]
+
+    result = perftest.tilesweep.run(rt, args.domain, tiles, args.runs,
+                                    args.max_parallel_jobs)
+    print(perftest.tilesweep.report(result))
+
+    if args.output:
+        perftest.tilesweep.save(args.output, result)
+
+
 if __name__ == '__main__':
     parser = argparse.ArgumentParser()
     parser.add_argument('--verbose', '-v', action='count', default=0,
@@ -83,6 +99,31 @@ if __name__ == '__main__':
     run_parser.add_argument('--config', '-c',
                             help='config name, default is machine config')
 
+    # command line arguments for `tilesweep` action
+    tilesweep_parser = subparsers.add_parser('tilesweep',
+                                             help='find the best x86 tile '
+                                                  'size per stencil')
+    tilesweep_parser.set_defaults(func=tilesweep)
+    tilesweep_parser.add_argument('--domain', '-d', required=True, type=int,
+                                  nargs=3, metavar=('ISIZE', 'JSIZE', 'KSIZE'),
+                                  help='domain size (excluding halo)')
+    tilesweep_parser.add_argument('--tiles', '-t', nargs='+',
+                                  default=['4x4', '8x8', '16x4', '16x16',
+                                           '32x4', '32x8', '64x2', '64x8',
+                                           '128x1', '128x4'],
+                                  help='tile sizes to try, given as IxJ')
+    tilesweep_parser.add_argument('--runs', default=5, type=int,
+                                  help='number of runs for each stencil and '
+                                       'tile size')
+    tilesweep_parser.add_argument('--max-parallel-jobs', default=50, type=int,
+                                  help='max number of jobs that are submitted '
+                                       'to SLURM in parallel')
+    tilesweep_parser.add_argument('--output', '-o',
+                                  help='optional JSON output file with all '
+                                       'measured times')
+    tilesweep_parser.add_argument('--config', '-c',
+                                  help='config name, default is machine config')
+
     # command line arguments for `validate` action
     validate_parser = subparsers.add_parser('validate',
                                             help='statistically validate '
@@ -0,0 +1,83 @@
+# -*- coding: utf-8 -*-
+
+import json
+
+import numpy as np
+
+from perftest import ArgumentError, logger, runtools
+
+
+def parse_tile(tile):
+    """Parses a tile size given as 'IxJ'.
+
+    Example:
+        >>> parse_tile('16x4')
+        (16, 4)
+    """
+    try:
+        ti, tj = (int(t) for t in tile.lower().split('x'))
+    except ValueError:
+        raise ArgumentError(f'Invalid tile size "{tile}", expected IxJ')
+    if ti <= 0 or tj <= 0:
+        raise ArgumentError(f'Invalid tile size "{tile}", must be positive')
+    return ti, tj
+
+
+def run(runtime, domain, tiles, runs, job_limit=None):
+    """Runs all stencils of `runtime` with all given tile sizes.
+
+    The tile size is passed to the x86 backend through the environment
+    variables GT_TILE_I and GT_TILE_J.
+
+    Args:
+        runtime: A `perftest.runtime.GridtoolsRuntime` with the x86 backend.
+        domain: Domain size as a tuple or list.
+        tiles: List of (i, j) tile sizes.
+        runs: Number of runs per stencil and tile size.
+
+    Returns:
+        A dict mapping stencil names to lists of (tile, median time) pairs.
+    """
+    if runtime.backend != 'x86':
+        raise ArgumentError('Tile sizes can only be tuned for the x86 backend')
+
+    cases = [(s, t) for s in runtime.stencils for t in tiles]
+    commands = [f'env GT_TILE_I={ti} GT_TILE_J={tj} '
+                f'{runtime.command(s, domain)}'
+                for s, (ti, tj) in cases for _ in range(runs)]
+
+    logger.info(f'Running {len(cases)} stencil/tile combinations')
+    outputs = runtools.run(commands, runtime.config, job_limit)
+    times = [runtime._parse_time(o) for o in outputs]
+
+    result = dict()
+    for index, (stencil, tile) in enumerate(cases):
+        measurements = times[index * runs:(index + 1) * runs]
+        result.setdefault(stencil.name, []).append(
+            (tile, float(np.median(measurements))))
+    return result
+
+
+def best(result):
+    """The fastest tile size and its time per stencil."""
+    return {stencil: min(times, key=lambda t: t[1])
+            for stencil, times in result.items()}
+
+
+def report(result):
+    """Human-readable table with the best tile size per stencil."""
+    lines = []
+    for stencil, ((ti, tj), time) in best(result).items():
+        default = dict(result[stencil]).get((8, 8))
+        speedup = f'{default / time:.2f}x vs 8x8' if default else ''
+        lines.append(f'{stencil:40} {ti:>4}x{tj:<4} {time:.6f}s {speedup}')
+    return '\n'.join(lines)
+
+
+def save(filename, result):
+    """Saves all measured times as JSON."""
+    data = {stencil: [dict(tile=list(tile), time=time)
+                      for tile, time in times]
+            for stencil, times in result.items()}
+    with open(filename, 'w') as f:
+        json.dump(data, f, indent=4)
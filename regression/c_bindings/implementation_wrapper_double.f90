@@ -33,13 +33,39 @@ contains
       descriptor0%type = 6
       descriptor0%dims = reshape(shape(arg0), &
         shape(descriptor0%dims), (/0/))
+      descriptor0%lbounds = reshape(lbound(arg0), &
+        shape(descriptor0%lbounds), (/0/))
       descriptor0%data = c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2),lbound(arg0, 3)))
+      descriptor0%is_acc_present = .false.
+      descriptor0%strides = 0
+      if (size(arg0, 1) > 1) &
+        descriptor0%strides(1) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1) + 1,lbound(arg0, 2),lbound(arg0, 3))), 8)
+      if (size(arg0, 2) > 1) &
+        descriptor0%strides(2) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2) + 1,lbound(arg0, 3))), 8)
+      if (size(arg0, 3) > 1) &
+        descriptor0%strides(3) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2),lbound(arg0, 3) + 1)), 8)
 
       descriptor1%rank = 3
       descriptor1%type = 6
       descriptor1%dims = reshape(shape(arg1), &
         shape(descriptor1%dims), (/0/))
+      descriptor1%lbounds = reshape(lbound(arg1), &
+        shape(descriptor1%lbounds), (/0/))
       descriptor1%data = c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2),lbound(arg1, 3)))
+      descriptor1%is_acc_present = .false.
+      descriptor1%strides = 0
+      if (size(arg1, 1) > 1) &
+        descriptor1%strides(1) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1) + 1,lbound(arg1, 2),lbound(arg1, 3))), 8)
+      if (size(arg1, 2) > 1) &
+        descriptor1%strides(2) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2) + 1,lbound(arg1, 3))), 8)
+      if (size(arg1, 3) > 1) &
+        descriptor1%strides(3) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2),lbound(arg1, 3) + 1)), 8)
 
       create_copy_stencil = create_copy_stencil_impl(descriptor0, descriptor1)
     end function
@@ -59,7 +85,20 @@ contains
       descriptor0%type = 6
       descriptor0%dims = reshape(shape(arg0), &
         shape(descriptor0%dims), (/0/))
+      descriptor0%lbounds = reshape(lbound(arg0), &
+        shape(descriptor0%lbounds), (/0/))
       descriptor0%data = c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2),lbound(arg0, 3)))
+      descriptor0%is_acc_present = .false.
+      descriptor0%strides = 0
+      if (size(arg0, 1) > 1) &
+        descriptor0%strides(1) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1) + 1,lbound(arg0, 2),lbound(arg0, 3))), 8)
+      if (size(arg0, 2) > 1) &
+        descriptor0%strides(2) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2) + 1,lbound(arg0, 3))), 8)
+      if (size(arg0, 3) > 1) &
+        descriptor0%strides(3) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2),lbound(arg0, 3) + 1)), 8)
 
       call sync_data_store_impl(descriptor0)
     end subroutine
@@ -176,7 +176,7 @@ struct horizontal_diffusion_functions : regression_fixture<2> {
     arg<2> p_in;
     arg<3> p_out;
 
-    template <variation Variation>
+    template <variation Variation, class Flx = flx_function<Variation>, class Fly = fly_function<Variation>>
     void do_test() {
         auto out = make_storage();
 
@@ -187,13 +187,21 @@ struct horizontal_diffusion_functions : regression_fixture<2> {
             p_coeff = make_storage(repo.coeff),
             make_multistage(execute::forward(),
                 define_caches(cache<cache_type::ij, cache_io_policy::local>(p_flx, p_fly)),
-                make_independent(
-                    make_stage<flx_function<Variation>>(p_flx, p_in), make_stage<fly_function<Variation>>(p_fly, p_in)),
+                make_independent(make_stage<Flx>(p_flx, p_in), make_stage<Fly>(p_fly, p_in)),
                 make_stage<out_function>(p_out, p_in, p_flx, p_fly, p_coeff)))
             .run();
 
         verify(make_storage(repo.out), out);
     }
+
+    template <variation Variation>
+    void do_memoized_test() {
+        using flx_t = flx_function<Variation>;
+        using fly_t = fly_function<Variation>;
+        do_test<Variation,
+            memoized<flx_t, memoize<lap_function, typename flx_t::in>>,
+            memoized<fly_t, memoize<lap_function, typename fly_t::in>>>();
+    }
 };
 
 TEST_F(horizontal_diffusion_functions, monolithic) { do_test<variation::monolithic>(); }
@@ -202,6 +210,10 @@ TEST_F(horizontal_diffusion_functions, call) { do_test<variation::call>(); }
 
 TEST_F(horizontal_diffusion_functions, call_offsets) { do_test<variation::call_offsets>(); }
 
+TEST_F(horizontal_diffusion_functions, call_memoized) { do_memoized_test<variation::call>(); }
+
+TEST_F(horizontal_diffusion_functions, call_offsets_memoized) { do_memoized_test<variation::call_offsets>(); }
+
 TEST_F(horizontal_diffusion_functions, procedures) { do_test<variation::procedures>(); }
 
 TEST_F(horizontal_diffusion_functions, procedures_offsets) { do_test<variation::procedures_offsets>(); }
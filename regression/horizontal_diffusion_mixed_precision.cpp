@@ -0,0 +1,137 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+#include "horizontal_diffusion_repository.hpp"
+
+using namespace gridtools;
+
+struct lap_function {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) =
+            float_type{4} * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+    }
+};
+
+struct flx_function {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<0, 1, 0, 0>>;
+    using lap = in_accessor<2, extent<0, 1, 0, 0>>;
+
+    using param_list = make_param_list<out, in, lap>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        auto res = eval(lap(1, 0)) - eval(lap(0, 0));
+        eval(out()) = res * (eval(in(1, 0, 0)) - eval(in(0, 0))) > 0 ? 0 : res;
+    }
+};
+
+struct fly_function {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<0, 0, 0, 1>>;
+    using lap = in_accessor<2, extent<0, 0, 0, 1>>;
+
+    using param_list = make_param_list<out, in, lap>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        auto res = eval(lap(0, 1)) - eval(lap(0, 0));
+        eval(out()) = res * (eval(in(0, 1)) - eval(in(0, 0))) > 0 ? 0 : res;
+    }
+};
+
+struct out_function {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1>;
+    using flx = in_accessor<2, extent<-1, 0, 0, 0>>;
+    using fly = in_accessor<3, extent<0, 0, -1, 0>>;
+    using coeff = in_accessor<4>;
+
+    using param_list = make_param_list<out, in, flx, fly, coeff>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in()) - eval(coeff()) * (eval(flx()) - eval(flx(-1, 0)) + eval(fly()) - eval(fly(0, -1)));
+    }
+};
+
+struct horizontal_diffusion_mixed_precision : regression_fixture<2> {
+    horizontal_diffusion_repository repo = {d1(), d2(), d3()};
+
+    template <class Lap, class Flx, class Fly>
+    auto make_horizontal_diffusion(Lap p_lap, Flx p_flx, Fly p_fly, storage_type out)
+        GT_AUTO_RETURN(make_computation(p_4 = make_storage(repo.in),
+            p_5 = out,
+            p_3 = make_storage(repo.coeff),
+            make_multistage(execute::parallel(),
+                define_caches(cache<cache_type::ij, cache_io_policy::local>(p_lap, p_flx, p_fly)),
+                make_stage<lap_function>(p_lap, p_4),
+                make_independent(
+                    make_stage<flx_function>(p_flx, p_4, p_lap), make_stage<fly_function>(p_fly, p_4, p_lap)),
+                make_stage<out_function>(p_5, p_4, p_flx, p_fly, p_3))));
+
+    // the largest absolute and relative differences on the compute domain
+    std::pair<double, double> max_error(storage_type const &expected, storage_type const &actual) const {
+        expected.sync();
+        actual.sync();
+        auto expected_view = make_host_view<access_mode::read_only>(expected);
+        auto actual_view = make_host_view<access_mode::read_only>(actual);
+        double abs = 0, rel = 0;
+        for (int i = halo_size; i != (int)(d1() - halo_size); ++i)
+            for (int j = halo_size; j != (int)(d2() - halo_size); ++j)
+                for (int k = 0; k != (int)d3(); ++k) {
+                    double diff = std::abs((double)expected_view(i, j, k) - (double)actual_view(i, j, k));
+                    abs = std::max(abs, diff);
+                    if (expected_view(i, j, k) != 0)
+                        rel = std::max(rel, diff / std::abs((double)expected_view(i, j, k)));
+                }
+        return {abs, rel};
+    }
+};
+
+/**
+ * Horizontal diffusion with single-precision temporaries, compared to the same stencil with temporaries of
+ * `float_type`. The temporaries are stored and cached in `float`, all arithmetic is done in `float_type`.
+ */
+TEST_F(horizontal_diffusion_mixed_precision, test) {
+    using float_storage_type = storage_tr::data_store_t<float, storage_info_t>;
+
+    auto baseline = make_storage();
+    auto baseline_comp = make_horizontal_diffusion(tmp_arg<0>(), tmp_arg<1>(), tmp_arg<2>(), baseline);
+    baseline_comp.run();
+    verify(make_storage(repo.out), baseline);
+
+    auto out = make_storage();
+    auto comp = make_horizontal_diffusion(mixed_precision_tmp_arg<0, float_type, float_storage_type>(),
+        mixed_precision_tmp_arg<1, float_type, float_storage_type>(),
+        mixed_precision_tmp_arg<2, float_type, float_storage_type>(),
+        out);
+    comp.run();
+
+    auto error = max_error(baseline, out);
+    std::cout << "single-precision temporaries: max. absolute error " << error.first << ", max. relative error "
+              << error.second << std::endl;
+    verify(baseline, out, 1e-6);
+    benchmark(comp);
+}
@@ -0,0 +1,73 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+#include "vertical_advection_dycore.hpp"
+#include "vertical_advection_repository.hpp"
+
+/*
+  The "vertical advection" stencil on columns with a number of levels that is fixed at compile time, compared to the
+  same columns with a runtime number of levels. The vertical size given on the command line is ignored.
+  */
+
+constexpr uint_t levels = 60;
+
+struct vertical_advection_dycore_static : regression_fixture<3, axis_t> {
+    arg<0> p_utens_stage;
+    arg<1> p_u_stage;
+    arg<2> p_wcon;
+    arg<3> p_u_pos;
+    arg<4> p_utens;
+    arg<5, scalar_storage_type> p_dtr_stage;
+    tmp_arg<0> p_acol;
+    tmp_arg<1> p_bcol;
+    tmp_arg<2> p_ccol;
+    tmp_arg<3> p_dcol;
+    tmp_arg<4> p_data_col;
+
+    vertical_advection_dycore_static() { d3() = levels; }
+
+    template <class Grid>
+    void test(Grid const &grid) {
+        vertical_advection_repository repo{d1(), d2(), d3()};
+        storage_type utens_stage = make_storage(repo.utens_stage_in);
+        auto comp = gridtools::make_computation<backend_t>(grid,
+            p_utens_stage = utens_stage,
+            p_u_stage = make_storage(repo.u_stage),
+            p_wcon = make_storage(repo.wcon),
+            p_u_pos = make_storage(repo.u_pos),
+            p_utens = make_storage(repo.utens),
+            p_dtr_stage = make_storage<scalar_storage_type>(repo.dtr_stage),
+            make_multistage(execute::forward(),
+                define_caches(cache<cache_type::k, cache_io_policy::local>(p_acol),
+                    cache<cache_type::k, cache_io_policy::local>(p_bcol),
+                    cache<cache_type::k, cache_io_policy::flush>(p_ccol),
+                    cache<cache_type::k, cache_io_policy::flush>(p_dcol),
+                    cache<cache_type::k, cache_io_policy::fill>(p_u_stage)),
+                make_stage<u_forward_function>(
+                    p_utens_stage, p_wcon, p_u_stage, p_u_pos, p_utens, p_dtr_stage, p_acol, p_bcol, p_ccol, p_dcol)),
+            make_multistage(execute::backward(),
+                define_caches(cache<cache_type::k, cache_io_policy::local>(p_data_col)),
+                make_stage<u_backward_function>(p_utens_stage, p_u_pos, p_dtr_stage, p_ccol, p_dcol, p_data_col)));
+        comp.run();
+        verify(make_storage(repo.utens_stage_out), utens_stage);
+        benchmark(comp);
+    }
+};
+
+TEST_F(vertical_advection_dycore_static, runtime_axis) { test(make_grid()); }
+
+TEST_F(vertical_advection_dycore_static, static_axis) {
+    test(gridtools::make_grid(i_halo_descriptor(), j_halo_descriptor(), static_axis<axis_t, levels>{}));
+}
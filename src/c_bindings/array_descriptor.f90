@@ -15,6 +15,18 @@ module array_descriptor
         integer(c_int) :: rank
         integer(c_int), dimension(7) :: dims
         type(c_ptr) :: data
-        ! TODO: add support for strides, bounds end type gt_fortran_array_descriptor
+        logical(c_bool) :: is_acc_present
+        ! ptrdiff_t in C, c_ptrdiff_t is only available since Fortran 2018
+        integer(c_intptr_t), dimension(7) :: strides
+        integer(c_int), dimension(7) :: lbounds
     end type gt_fortran_array_descriptor
+
+contains
+    ! distance in elements between two elements of an array
+    integer(c_intptr_t) function gt_array_stride(first, next, element_size)
+        type(c_ptr), intent(in), value :: first, next
+        integer, intent(in), value :: element_size
+
+        gt_array_stride = (transfer(next, 0_c_intptr_t) - transfer(first, 0_c_intptr_t)) / element_size
+    end function gt_array_stride
 end module
@@ -107,6 +107,32 @@ namespace gridtools {
                     return {};
                 }
             }
+
+            int fortran_array_element_size(gt_fortran_array_kind kind) {
+                switch (kind) {
+                case gt_fk_Bool:
+                    return sizeof(bool);
+                case gt_fk_Int:
+                    return sizeof(int);
+                case gt_fk_Short:
+                    return sizeof(short);
+                case gt_fk_Long:
+                    return sizeof(long);
+                case gt_fk_LongLong:
+                    return sizeof(long long);
+                case gt_fk_Float:
+                    return sizeof(float);
+                case gt_fk_Double:
+                    return sizeof(double);
+                case gt_fk_LongDouble:
+                    return sizeof(long double);
+                case gt_fk_SignedChar:
+                    return sizeof(signed char);
+                default:
+                    assert(false && "Invalid element kind");
+                    return 0;
+                }
+            }
         } // namespace _impl
 
         std::string wrap_line(const std::string &line, const std::string &prefix) {
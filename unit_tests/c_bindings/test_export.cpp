@@ -198,7 +198,17 @@ contains
       descriptor0%type = 1
       descriptor0%dims = reshape(shape(arg0), &
         shape(descriptor0%dims), (/0/))
+      descriptor0%lbounds = reshape(lbound(arg0), &
+        shape(descriptor0%lbounds), (/0/))
       descriptor0%data = c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2)))
+      descriptor0%is_acc_present = .false.
+      descriptor0%strides = 0
+      if (size(arg0, 1) > 1) &
+        descriptor0%strides(1) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1) + 1,lbound(arg0, 2))), 4)
+      if (size(arg0, 2) > 1) &
+        descriptor0%strides(2) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2) + 1)), 4)
 
       call my_assign0_impl(descriptor0, arg1)
     end subroutine
@@ -213,7 +223,17 @@ contains
       descriptor0%type = 6
       descriptor0%dims = reshape(shape(arg0), &
         shape(descriptor0%dims), (/0/))
+      descriptor0%lbounds = reshape(lbound(arg0), &
+        shape(descriptor0%lbounds), (/0/))
       descriptor0%data = c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2)))
+      descriptor0%is_acc_present = .false.
+      descriptor0%strides = 0
+      if (size(arg0, 1) > 1) &
+        descriptor0%strides(1) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1) + 1,lbound(arg0, 2))), 8)
+      if (size(arg0, 2) > 1) &
+        descriptor0%strides(2) = gt_array_stride(descriptor0%data, &
+          c_loc(arg0(lbound(arg0, 1),lbound(arg0, 2) + 1)), 8)
 
       call my_assign1_impl(descriptor0, arg1)
     end subroutine
@@ -228,7 +248,17 @@ contains
       descriptor1%type = 1
       descriptor1%dims = reshape(shape(arg1), &
         shape(descriptor1%dims), (/0/))
+      descriptor1%lbounds = reshape(lbound(arg1), &
+        shape(descriptor1%lbounds), (/0/))
       descriptor1%data = c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2)))
+      descriptor1%is_acc_present = .false.
+      descriptor1%strides = 0
+      if (size(arg1, 1) > 1) &
+        descriptor1%strides(1) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1) + 1,lbound(arg1, 2))), 4)
+      if (size(arg1, 2) > 1) &
+        descriptor1%strides(2) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2) + 1)), 4)
 
       call test_c_bindings_and_wrapper_compatible_type_b_impl(arg0, descriptor1)
     end subroutine
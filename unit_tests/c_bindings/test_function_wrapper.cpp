@@ -128,7 +128,7 @@ namespace gridtools {
 
             TEST(wrap, array_descriptor) {
                 int array[2][3] = {{1, 2, 3}, {4, 5, 6}};
-                gt_fortran_array_descriptor descriptor;
+                gt_fortran_array_descriptor descriptor{};
                 descriptor.data = array;
                 descriptor.type = gt_fk_Int;
                 descriptor.rank = 2;
@@ -0,0 +1,119 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/common/thread_placement.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gridtools;
+using _impl::thread_placement_detail::cpu_info;
+
+namespace {
+    // 2 packages with 2 cores each and 2 hardware threads per core, numbered like Linux does on x86:
+    // the second hardware thread of the core with cpu `c` is `c + 4`
+    std::vector<cpu_info> test_topology() {
+        std::vector<cpu_info> cpus;
+        for (int cpu = 0; cpu < 8; ++cpu)
+            cpus.push_back({cpu, cpu % 4 / 2, cpu % 2, 0});
+        return _impl::thread_placement_detail::make_topology(cpus);
+    }
+} // namespace
+
+TEST(thread_placement, parse) {
+    EXPECT_EQ(thread_placement::parse("none").get_kind(), thread_placement::kind::none);
+    EXPECT_EQ(thread_placement::parse("").get_kind(), thread_placement::kind::none);
+    EXPECT_EQ(thread_placement::parse("compact").get_kind(), thread_placement::kind::compact);
+    EXPECT_TRUE(thread_placement::parse("compact").use_smt());
+    EXPECT_EQ(thread_placement::parse("scatter-nosmt").get_kind(), thread_placement::kind::scatter);
+    EXPECT_FALSE(thread_placement::parse("scatter-nosmt").use_smt());
+
+    auto cpus = thread_placement::parse("0-3,8,10-11");
+    EXPECT_EQ(cpus.get_kind(), thread_placement::kind::explicit_cpus);
+    EXPECT_EQ(cpus.cpus(test_topology()), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+
+    for (auto name : {"none", "compact", "compact-nosmt", "scatter", "scatter-nosmt", "1,2,5"})
+        EXPECT_EQ(thread_placement::parse(name).name(), name);
+
+    for (auto invalid : {"foo", "3-1", "1,,2", "-1", "1-", "2x", ","})
+        EXPECT_THROW(thread_placement::parse(invalid), std::runtime_error) << invalid;
+}
+
+TEST(thread_placement, cpus) {
+    auto topology = test_topology();
+    EXPECT_EQ(thread_placement().cpus(topology), std::vector<int>{});
+    EXPECT_EQ(thread_placement::compact().cpus(topology), (std::vector<int>{0, 4, 1, 5, 2, 6, 3, 7}));
+    EXPECT_EQ(thread_placement::compact(false).cpus(topology), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(thread_placement::scatter().cpus(topology), (std::vector<int>{0, 2, 1, 3, 4, 6, 5, 7}));
+    EXPECT_EQ(thread_placement::scatter(false).cpus(topology), (std::vector<int>{0, 2, 1, 3}));
+}
+
+TEST(thread_placement, owner) {
+    using _impl::thread_placement_detail::owner;
+    // OpenMP static schedule with chunks of ceil(n / threads) iterations
+    for (int n : {3, 8, 13, 16, 100}) {
+        const int chunk = (n + 7) / 8;
+        for (int i = 0; i < n; ++i)
+            EXPECT_EQ(i / chunk, owner(i, n, 8, false));
+    }
+    EXPECT_EQ(6, owner(12, 13, 8, false));
+    EXPECT_EQ(7, owner(12, 13, 8, true));
+}
+
+TEST(thread_placement, block_order) {
+    using _impl::thread_placement_detail::block_order;
+    auto topology = test_topology();
+
+    // compact placement: the natural order already keeps siblings together
+    auto compact = thread_placement::compact().cpus(topology);
+    EXPECT_EQ(block_order(8, 8, compact, topology, false), (std::vector<int_t>{0, 1, 2, 3, 4, 5, 6, 7}));
+    EXPECT_EQ(block_order(4, 8, compact, topology, true), (std::vector<int_t>{0, 1, 2, 3}));
+
+    // scatter placement: threads 0 and 4 are siblings, so they get the adjacent blocks 0 and 1
+    auto scatter = thread_placement::scatter().cpus(topology);
+    EXPECT_EQ(block_order(8, 8, scatter, topology, false), (std::vector<int_t>{0, 4, 2, 6, 1, 5, 3, 7}));
+
+    // the thread pool executes the 4 iterations on threads 1, 3, 5 and 7, i.e. on cpus 2, 3, 6 and 7
+    EXPECT_EQ(block_order(4, 8, scatter, topology, true), (std::vector<int_t>{0, 2, 1, 3}));
+
+    // more blocks than threads: OpenMP executes the chunks {0, 1}, {2, 3}, ... on threads 0, 1, ...
+    EXPECT_EQ(block_order(16, 8, scatter, topology, false),
+        (std::vector<int_t>{0, 1, 8, 9, 4, 5, 12, 13, 2, 3, 10, 11, 6, 7, 14, 15}));
+
+    // always a permutation, also for cpus that are not part of the topology
+    for (int blocks = 1; blocks <= 8; ++blocks) {
+        auto order = block_order(blocks, 8, {9, 3, 0, 12}, topology, true);
+        std::sort(order.begin(), order.end());
+        for (int b = 0; b < blocks; ++b)
+            EXPECT_EQ(order[b], b);
+    }
+}
+
+TEST(thread_placement, set_thread_placement) {
+    set_thread_placement(thread_placement::compact());
+    EXPECT_EQ(get_thread_placement().name(), "compact");
+    EXPECT_NE(_impl::thread_placement_detail::current_block_order(1), nullptr);
+    set_thread_placement(thread_placement());
+    EXPECT_EQ(get_thread_placement().get_kind(), thread_placement::kind::none);
+    EXPECT_EQ(_impl::thread_placement_detail::current_block_order(1), nullptr);
+}
+
+TEST(thread_placement, block_order_outlives_placement) {
+    set_thread_placement(thread_placement::compact());
+    auto order = _impl::thread_placement_detail::current_block_order(4);
+    ASSERT_NE(order, nullptr);
+    set_thread_placement(thread_placement());
+    auto sorted = *order;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(sorted, (std::vector<int_t>{0, 1, 2, 3}));
+}
@@ -0,0 +1,105 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/common/thread_pool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gridtools;
+
+TEST(thread_pool, parallel) {
+    thread_pool testee(4);
+    EXPECT_EQ(testee.size(), 4);
+    for (int run = 0; run < 100; ++run) {
+        std::vector<int> visits(4, 0);
+        testee.parallel([&](int num, int size) {
+            EXPECT_EQ(size, 4);
+            EXPECT_EQ(thread_pool::thread_num(), num);
+            ++visits[num];
+        });
+        EXPECT_EQ(visits, std::vector<int>(4, 1));
+    }
+    EXPECT_EQ(thread_pool::thread_num(), 0);
+}
+
+TEST(thread_pool, parallel_for) {
+    thread_pool testee(3);
+    std::vector<std::atomic<int>> visits(7 * 5 * 4);
+    for (auto &v : visits)
+        v = 0;
+
+    testee.parallel_for(visits.size(), [&](std::ptrdiff_t i) { ++visits[i]; });
+    testee.parallel_for(7, 20, [&](std::ptrdiff_t i, std::ptrdiff_t j) { ++visits[i * 20 + j]; });
+    testee.parallel_for(
+        7, 5, 4, [&](std::ptrdiff_t i, std::ptrdiff_t j, std::ptrdiff_t k) { ++visits[(i * 5 + j) * 4 + k]; });
+    for (auto const &v : visits)
+        EXPECT_EQ(v, 3);
+}
+
+TEST(thread_pool, static_schedule) {
+    thread_pool testee(4);
+    std::vector<int> owner(100, -1);
+    testee.parallel_for(owner.size(), [&](std::ptrdiff_t i) { owner[i] = thread_pool::thread_num(); });
+    for (int run = 0; run < 10; ++run)
+        testee.parallel_for(owner.size(), [&](std::ptrdiff_t i) { EXPECT_EQ(owner[i], thread_pool::thread_num()); });
+    EXPECT_EQ(owner.front(), 0);
+    EXPECT_EQ(owner.back(), 3);
+}
+
+TEST(thread_pool, barrier) {
+    thread_pool testee(4);
+    std::atomic<int> counter(0);
+    testee.parallel([&](int, int size) {
+        for (int round = 1; round <= 10; ++round) {
+            ++counter;
+            testee.barrier();
+            EXPECT_EQ(counter, round * size);
+            testee.barrier();
+        }
+    });
+}
+
+TEST(thread_pool, nested_regions_are_serial) {
+    thread_pool testee(4);
+    std::atomic<int> inner(0);
+    testee.parallel([&](int, int) {
+        testee.parallel([&](int num, int size) {
+            EXPECT_EQ(size, 1);
+            EXPECT_EQ(num, 0);
+            ++inner;
+        });
+    });
+    EXPECT_EQ(inner, 4);
+}
+
+TEST(thread_pool, exceptions) {
+    thread_pool testee(4);
+    EXPECT_THROW(testee.parallel([](int num, int) {
+        if (num == 2)
+            throw std::runtime_error("error");
+    }),
+        std::runtime_error);
+    std::atomic<int> visits(0);
+    testee.parallel([&](int, int) { ++visits; });
+    EXPECT_EQ(visits, 4);
+}
+
+TEST(thread_pool, pinning) {
+    auto cpus = _impl::thread_pool_detail::allowed_cpus();
+    thread_pool testee(2, cpus);
+    std::atomic<int> visits(0);
+    testee.parallel([&](int, int) { ++visits; });
+    EXPECT_EQ(visits, 2);
+}
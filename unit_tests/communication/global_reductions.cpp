@@ -0,0 +1,77 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/communication/global_reductions.hpp>
+
+#include <cmath>
+#include <tuple>
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3, halo<1, 1, 0>>;
+        using storage_t = storage_traits<backend_t>::data_store_t<double, storage_info_t>;
+
+        const uint_t d1 = 13, d2 = 9, d3 = 5;
+
+        auto make_local_grid() GT_AUTO_RETURN(
+            make_grid(halo_descriptor(1, 1, 1, d1 - 2, d1), halo_descriptor(1, 1, 1, d2 - 2, d2), d3));
+
+        int rank() {
+            int res;
+            MPI_Comm_rank(GCL_WORLD, &res);
+            return res;
+        }
+
+        int ranks() {
+            int res;
+            MPI_Comm_size(GCL_WORLD, &res);
+            return res;
+        }
+
+        // values in the halo belong to the neighbours and must not be counted
+        storage_t make_storage(double inner) {
+            return {{d1, d2, d3}, [=](int i, int j, int) {
+                        return i == 0 || j == 0 || i == (int)d1 - 1 || j == (int)d2 - 1 ? 1e6 : inner;
+                    }};
+        }
+
+        TEST(global_reductions, sum_min_max) {
+            auto data = make_storage(rank() + 1);
+            const double points = (d1 - 2) * (d2 - 2) * d3;
+            const int n = ranks();
+
+            double sum, min, max;
+            std::tie(sum, min, max) =
+                global_reduce(make_local_grid(), reduction::sum(data), reduction::min(data), reduction::max(data));
+            EXPECT_EQ(points * n * (n + 1) / 2, sum);
+            EXPECT_EQ(1, min);
+            EXPECT_EQ(n, max);
+            EXPECT_EQ(std::sqrt(points * n * (n + 1) * (2 * n + 1) / 6),
+                global_reduce(reduction_order::kahan, make_local_grid(), reduction::norm2(data)));
+        }
+
+        TEST(global_reductions, same_result_on_all_ranks) {
+            auto data = make_storage(std::sin(rank() * 1.7 + .3) * 1e-3);
+            for (auto order : {reduction_order::fast, reduction_order::pairwise, reduction_order::kahan}) {
+                double res = global_reduce(order, make_local_grid(), reduction::sum(data));
+                double min, max;
+                MPI_Allreduce(&res, &min, 1, MPI_DOUBLE, MPI_MIN, GCL_WORLD);
+                MPI_Allreduce(&res, &max, 1, MPI_DOUBLE, MPI_MAX, GCL_WORLD);
+                EXPECT_EQ(min, max);
+            }
+        }
+    } // namespace
+} // namespace gridtools
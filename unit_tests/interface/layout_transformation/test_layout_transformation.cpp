@@ -9,6 +9,7 @@
  */
 
 #include <gridtools/common/array.hpp>
+#include <gridtools/common/hypercube_iterator.hpp>
 #include <gridtools/interface/layout_transformation/layout_transformation.hpp>
 #include <gtest/gtest.h>
 
@@ -181,6 +182,30 @@ TEST(layout_transformation, 1D_layout_with_stride2) {
     delete[] dst;
 }
 
+TEST(layout_transformation, 3D_common_layouts) {
+    // not a multiple of the tile size of the transposing transformations
+    std::vector<uint_t> dims{70, 45, 33};
+    const uint_t size = dims[0] * dims[1] * dims[2];
+    const std::vector<uint_t> ijk{1, dims[0], dims[0] * dims[1]};
+    const std::vector<uint_t> kji{dims[1] * dims[2], dims[2], 1};
+    const std::vector<uint_t> jik{dims[1], 1, dims[0] * dims[1]};
+    const std::vector<std::vector<uint_t>> layouts = {ijk, kji, jik};
+
+    std::vector<double> src(size);
+    std::vector<double> dst(size);
+    for (auto const &src_strides : layouts)
+        for (auto const &dst_strides : layouts) {
+            Index src_index(dims, src_strides);
+            Index dst_index(dims, dst_strides);
+            init<3>(src.data(), src_index, [](const array<size_t, 3> &a) { return a[0] * 10000 + a[1] * 100 + a[2]; });
+            std::fill(dst.begin(), dst.end(), -1);
+
+            gridtools::interface::transform(dst.data(), src.data(), dims, dst_strides, src_strides);
+
+            verify<3>(src.data(), src_index, dst.data(), dst_index);
+        }
+}
+
 TEST(layout_transformation, one_dimension_too_many) {
     std::vector<uint_t> dims(GT_TRANSFORM_MAX_DIM + 1);
     std::vector<uint_t> src_strides(GT_TRANSFORM_MAX_DIM + 1);
@@ -47,7 +47,17 @@ contains
       descriptor1%type = 6
       descriptor1%dims = reshape(shape(arg1), &
         shape(descriptor1%dims), (/0/))
+      descriptor1%lbounds = reshape(lbound(arg1), &
+        shape(descriptor1%lbounds), (/0/))
       descriptor1%data = c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2)))
+      descriptor1%is_acc_present = .true.
+      descriptor1%strides = 0
+      if (size(arg1, 1) > 1) &
+        descriptor1%strides(1) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1) + 1,lbound(arg1, 2))), 8)
+      if (size(arg1, 2) > 1) &
+        descriptor1%strides(2) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2) + 1)), 8)
       !$acc end host_data
       !$acc end data
 
@@ -66,7 +76,20 @@ contains
       descriptor1%type = 6
       descriptor1%dims = reshape(shape(arg1), &
         shape(descriptor1%dims), (/0/))
+      descriptor1%lbounds = reshape(lbound(arg1), &
+        shape(descriptor1%lbounds), (/0/))
       descriptor1%data = c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2),lbound(arg1, 3)))
+      descriptor1%is_acc_present = .true.
+      descriptor1%strides = 0
+      if (size(arg1, 1) > 1) &
+        descriptor1%strides(1) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1) + 1,lbound(arg1, 2),lbound(arg1, 3))), 8)
+      if (size(arg1, 2) > 1) &
+        descriptor1%strides(2) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2) + 1,lbound(arg1, 3))), 8)
+      if (size(arg1, 3) > 1) &
+        descriptor1%strides(3) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2),lbound(arg1, 3) + 1)), 8)
       !$acc end host_data
       !$acc end data
 
@@ -85,7 +108,17 @@ contains
       descriptor1%type = 6
       descriptor1%dims = reshape(shape(arg1), &
         shape(descriptor1%dims), (/0/))
+      descriptor1%lbounds = reshape(lbound(arg1), &
+        shape(descriptor1%lbounds), (/0/))
       descriptor1%data = c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2)))
+      descriptor1%is_acc_present = .true.
+      descriptor1%strides = 0
+      if (size(arg1, 1) > 1) &
+        descriptor1%strides(1) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1) + 1,lbound(arg1, 2))), 8)
+      if (size(arg1, 2) > 1) &
+        descriptor1%strides(2) = gt_array_stride(descriptor1%data, &
+          c_loc(arg1(lbound(arg1, 1),lbound(arg1, 2) + 1)), 8)
       !$acc end host_data
       !$acc end data
 
@@ -0,0 +1,222 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/interface/checkpoint/checkpoint.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+using namespace gridtools;
+
+using storage_traits_t = storage_traits<backend::x86>;
+using halo_t = halo<2, 2, 0>;
+using IJKStorageInfo = storage_traits_t::storage_info_t<0, 3, halo_t>;
+using IJKDataStore = storage_traits_t::data_store_t<float_type, IJKStorageInfo>;
+using KJIStorageInfo =
+    storage_traits_t::custom_layout_storage_info_align_t<1, layout_map<2, 1, 0>, halo_t, alignment<8>>;
+using KJIDataStore = storage_traits_t::data_store_t<float_type, KJIStorageInfo>;
+using IntDataStore = storage_traits_t::data_store_t<int, IJKStorageInfo>;
+
+namespace {
+    constexpr uint_t d1 = 13, d2 = 9, d3 = 7;
+
+    std::string tmp_path(std::string const &name) { return "gt_test_checkpoint_" + name + ".gtckpt"; }
+
+    template <class DataStore>
+    void fill(DataStore &ds, int seed) {
+        auto view = make_host_view(ds);
+        for (uint_t i = 0; i < d1; ++i)
+            for (uint_t j = 0; j < d2; ++j)
+                for (uint_t k = 0; k < d3; ++k)
+                    view(i, j, k) = seed + 100 * i + 10 * j + k;
+    }
+
+    template <class DataStore>
+    void verify(DataStore &ds, int seed) {
+        auto view = make_host_view(ds);
+        for (uint_t i = 0; i < d1; ++i)
+            for (uint_t j = 0; j < d2; ++j)
+                for (uint_t k = 0; k < d3; ++k)
+                    EXPECT_EQ(view(i, j, k), seed + 100 * i + 10 * j + k);
+    }
+} // namespace
+
+TEST(checkpoint, round_trip) {
+    IJKStorageInfo si(d1, d2, d3);
+    IJKDataStore u(si, "u"), v(si, "v");
+    IntDataStore flags(si, "flags");
+    fill(u, 1);
+    fill(v, 2);
+    fill(flags, 3);
+
+    auto path = tmp_path("round_trip");
+    write_checkpoint(path, u, v, flags);
+
+    IJKDataStore u2(si, 0., "u"), v2(si, 0., "v");
+    IntDataStore flags2(si, 0, "flags");
+    read_checkpoint(path, v2, flags2, u2);
+    verify(u2, 1);
+    verify(v2, 2);
+    verify(flags2, 3);
+
+    checkpoint_reader reader(path);
+    ASSERT_EQ(reader.fields().size(), 3);
+    auto const &info = reader.field("v");
+    EXPECT_EQ(info.kind, checkpoint_value_kind::floating_point);
+    EXPECT_EQ(info.value_size, sizeof(float_type));
+    EXPECT_EQ(info.halo, (std::vector<std::uint32_t>{2, 2, 0}));
+    EXPECT_EQ(info.total_lengths, (std::vector<std::uint32_t>{d1, d2, d3}));
+    EXPECT_EQ(info.payload_offset % 4096, 0);
+    EXPECT_FALSE(reader.has_field("w"));
+
+    std::remove(path.c_str());
+}
+
+TEST(checkpoint, restart_into_different_layout) {
+    IJKDataStore u(IJKStorageInfo(d1, d2, d3), "u");
+    fill(u, 5);
+    auto path = tmp_path("layout");
+    write_checkpoint(path, u);
+
+    KJIDataStore u2(KJIStorageInfo(d1, d2, d3), 0., "u");
+    read_checkpoint(path, u2);
+    verify(u2, 5);
+
+    std::remove(path.c_str());
+}
+
+TEST(checkpoint, async_writer) {
+    IJKStorageInfo si(d1, d2, d3);
+    IJKDataStore u(si, "u");
+    auto path0 = tmp_path("async0");
+    auto path1 = tmp_path("async1");
+    auto path2 = tmp_path("async2");
+    {
+        async_checkpoint_writer writer(2);
+        fill(u, 0);
+        writer.write(path0, u);
+        fill(u, 1);
+        writer.write(path1, u);
+        fill(u, 2);
+        writer.write(path2, u);
+        // modifications after the snapshot must not end up in the file
+        fill(u, 3);
+        writer.wait();
+    }
+    IJKDataStore res(si, 0., "u");
+    read_checkpoint(path0, res);
+    verify(res, 0);
+    read_checkpoint(path1, res);
+    verify(res, 1);
+    read_checkpoint(path2, res);
+    verify(res, 2);
+
+    std::remove(path0.c_str());
+    std::remove(path1.c_str());
+    std::remove(path2.c_str());
+}
+
+TEST(checkpoint, errors) {
+    IJKStorageInfo si(d1, d2, d3);
+    IJKDataStore u(si, "u"), other_u(si, "u"), unnamed(si);
+    auto path = tmp_path("errors");
+
+    EXPECT_THROW(write_checkpoint(path, u, other_u), std::runtime_error);
+    EXPECT_THROW(write_checkpoint(path, unnamed), std::runtime_error);
+    EXPECT_THROW(checkpoint_reader(tmp_path("does_not_exist")), std::runtime_error);
+
+    write_checkpoint(path, u);
+
+    IJKDataStore w(si, "w");
+    EXPECT_THROW(read_checkpoint(path, w), std::runtime_error);
+
+    IJKDataStore smaller(IJKStorageInfo(d1, d2, d3 - 1), "u");
+    EXPECT_THROW(read_checkpoint(path, smaller), std::runtime_error);
+
+    IntDataStore wrong_type(si, "u");
+    EXPECT_THROW(read_checkpoint(path, wrong_type), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+using MCStorageInfo = storage_traits<backend::mc>::storage_info_t<0, 3, halo<2, 2, 1>>;
+using MCDataStore = storage_traits<backend::mc>::data_store_t<double, MCStorageInfo>;
+
+TEST(checkpoint, compressed_lossless) {
+    MCStorageInfo si(d1, d2, d3);
+    MCDataStore u(si, "u"), v(si, 1.5, "v");
+    {
+        auto view = make_host_view(u);
+        for (uint_t i = 0; i < d1; ++i)
+            for (uint_t j = 0; j < d2; ++j)
+                for (uint_t k = 0; k < d3; ++k)
+                    view(i, j, k) = std::sin(0.1 * i + 0.2 * j) * (k + 1);
+    }
+    auto path = tmp_path("lossless");
+    auto stats = write_compressed_checkpoint(path, checkpoint_compression::lossless(), u, v);
+    ASSERT_EQ(stats.size(), 2);
+    EXPECT_EQ(stats[1].name, "v");
+    EXPECT_EQ(stats[1].raw_bytes, (d1 - 4) * (d2 - 4) * (d3 - 2) * sizeof(double));
+    EXPECT_GT(stats[1].ratio(), 10);
+
+    MCDataStore u2(si, -1., "u"), v2(si, -1., "v");
+    read_checkpoint(path, u2, v2);
+    auto u_view = make_host_view(u);
+    auto u2_view = make_host_view(u2);
+    auto v2_view = make_host_view(v2);
+    for (uint_t i = 0; i < d1; ++i)
+        for (uint_t j = 0; j < d2; ++j)
+            for (uint_t k = 0; k < d3; ++k) {
+                bool inner = i >= 2 && i < d1 - 2 && j >= 2 && j < d2 - 2 && k >= 1 && k < d3 - 1;
+                EXPECT_EQ(u2_view(i, j, k), inner ? u_view(i, j, k) : -1.);
+                EXPECT_EQ(v2_view(i, j, k), inner ? 1.5 : -1.);
+            }
+
+    std::remove(path.c_str());
+}
+
+TEST(checkpoint, compressed_error_bounded) {
+    MCStorageInfo si(d1, d2, d3);
+    MCDataStore u(si, "u");
+    auto u_view = make_host_view(u);
+    for (uint_t i = 0; i < d1; ++i)
+        for (uint_t j = 0; j < d2; ++j)
+            for (uint_t k = 0; k < d3; ++k)
+                u_view(i, j, k) = std::exp(0.05 * i) - std::cos(0.3 * j) + k;
+    u_view(5, 5, 3) = std::numeric_limits<double>::infinity();
+
+    const double error_bound = 1e-3;
+    auto path = tmp_path("lossy");
+    write_compressed_checkpoint(path, checkpoint_compression::error_bounded(error_bound), u);
+
+    MCDataStore u2(si, 0., "u");
+    read_checkpoint(path, u2);
+    auto u2_view = make_host_view(u2);
+    for (uint_t i = 2; i < d1 - 2; ++i)
+        for (uint_t j = 2; j < d2 - 2; ++j)
+            for (uint_t k = 1; k < d3 - 1; ++k)
+                if (i == 5 && j == 5 && k == 3)
+                    EXPECT_EQ(u2_view(i, j, k), u_view(i, j, k));
+                else
+                    EXPECT_LE(std::abs(u2_view(i, j, k) - u_view(i, j, k)), error_bound);
+
+    IntDataStore flags(IJKStorageInfo(d1, d2, d3), "flags");
+    EXPECT_THROW(write_compressed_checkpoint(path, checkpoint_compression::error_bounded(error_bound), flags),
+        std::runtime_error);
+
+    std::remove(path.c_str());
+}
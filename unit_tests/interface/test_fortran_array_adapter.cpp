@@ -25,7 +25,7 @@ TEST(FortranArrayAdapter, TransformAdapterIntoDataStore) {
     constexpr size_t z_size = 4;
     float_type fortran_array[z_size][y_size][x_size];
 
-    gt_fortran_array_descriptor descriptor;
+    gt_fortran_array_descriptor descriptor{};
     descriptor.rank = 3;
     descriptor.dims[0] = x_size;
     descriptor.dims[1] = y_size;
@@ -60,7 +60,7 @@ TEST(FortranArrayAdapter, TransformDataStoreIntoAdapter) {
     constexpr size_t z_size = 4;
     float_type fortran_array[z_size][y_size][x_size];
 
-    gt_fortran_array_descriptor descriptor;
+    gt_fortran_array_descriptor descriptor{};
     descriptor.rank = 3;
     descriptor.dims[0] = x_size;
     descriptor.dims[1] = y_size;
@@ -88,3 +88,106 @@ TEST(FortranArrayAdapter, TransformDataStoreIntoAdapter) {
             for (size_t x = 0; x < x_size; ++x, ++i)
                 EXPECT_EQ(fortran_array[z][y][x], i);
 }
+
+using IJKFortranStorageInfo = typename gridtools::storage_traits<gridtools::backend::x86>::
+    custom_layout_storage_info_t<1, gridtools::layout_map<2, 1, 0>>;
+using IJKFortranDataStore =
+    typename gridtools::storage_traits<gridtools::backend::x86>::data_store_t<float_type, IJKFortranStorageInfo>;
+
+TEST(FortranArrayAdapter, AdoptFortranArray) {
+    constexpr size_t x_size = 6;
+    constexpr size_t y_size = 5;
+    constexpr size_t z_size = 4;
+    float_type fortran_array[z_size][y_size][x_size];
+
+    gt_fortran_array_descriptor descriptor{};
+    descriptor.rank = 3;
+    descriptor.dims[0] = x_size;
+    descriptor.dims[1] = y_size;
+    descriptor.dims[2] = z_size;
+    descriptor.type = std::is_same<float_type, float>::value ? gt_fk_Float : gt_fk_Double;
+    descriptor.data = fortran_array;
+    descriptor.is_acc_present = false;
+
+    gridtools::fortran_array_adapter<IJKFortranDataStore> fortran_array_adapter{descriptor};
+    ASSERT_TRUE(fortran_array_adapter.is_adoptable());
+    IJKFortranDataStore data_store = fortran_array_adapter.adopt("adopted");
+    EXPECT_EQ(data_store.name(), "adopted");
+    auto data_store_view = make_host_view(data_store);
+    EXPECT_EQ(&data_store_view(0, 0, 0), &fortran_array[0][0][0]);
+
+    int i = 0;
+    for (size_t z = 0; z < z_size; ++z)
+        for (size_t y = 0; y < y_size; ++y)
+            for (size_t x = 0; x < x_size; ++x, ++i)
+                fortran_array[z][y][x] = i;
+
+    // transform is a no-op for an adopted data_store
+    transform(data_store, fortran_array_adapter);
+
+    i = 0;
+    for (size_t z = 0; z < z_size; ++z)
+        for (size_t y = 0; y < y_size; ++y)
+            for (size_t x = 0; x < x_size; ++x, ++i)
+                EXPECT_EQ(data_store_view(x, y, z), i);
+}
+
+TEST(FortranArrayAdapter, AdoptWithMismatchingLayout) {
+    float_type fortran_array[4][5][6];
+    gt_fortran_array_descriptor descriptor{};
+    descriptor.rank = 3;
+    descriptor.dims[0] = 6;
+    descriptor.dims[1] = 5;
+    descriptor.dims[2] = 4;
+    descriptor.type = std::is_same<float_type, float>::value ? gt_fk_Float : gt_fk_Double;
+    descriptor.data = fortran_array;
+    descriptor.is_acc_present = false;
+
+    gridtools::fortran_array_adapter<IJKDataStore> fortran_array_adapter{descriptor};
+    EXPECT_FALSE(fortran_array_adapter.is_adoptable());
+    EXPECT_THROW(fortran_array_adapter.adopt(), std::runtime_error);
+}
+
+TEST(FortranArrayAdapter, StridedArraySection) {
+    // inner region of a fortran array with a halo of 2 in x and y, e.g. arr(3:8, 3:7, :)
+    constexpr size_t x_size = 6;
+    constexpr size_t y_size = 5;
+    constexpr size_t z_size = 4;
+    constexpr size_t halo = 2;
+    float_type fortran_array[z_size][y_size + 2 * halo][x_size + 2 * halo];
+
+    gt_fortran_array_descriptor descriptor{};
+    descriptor.rank = 3;
+    descriptor.dims[0] = x_size;
+    descriptor.dims[1] = y_size;
+    descriptor.dims[2] = z_size;
+    descriptor.strides[0] = 1;
+    descriptor.strides[1] = x_size + 2 * halo;
+    descriptor.strides[2] = (x_size + 2 * halo) * (y_size + 2 * halo);
+    descriptor.type = std::is_same<float_type, float>::value ? gt_fk_Float : gt_fk_Double;
+    descriptor.data = &fortran_array[0][halo][halo];
+    descriptor.is_acc_present = false;
+
+    for (size_t z = 0; z < z_size; ++z)
+        for (size_t y = 0; y < y_size + 2 * halo; ++y)
+            for (size_t x = 0; x < x_size + 2 * halo; ++x)
+                fortran_array[z][y][x] = 100 * x + 10 * y + z;
+
+    gridtools::fortran_array_adapter<IJKDataStore> fortran_array_adapter{descriptor};
+    IJKDataStore data_store{IJKStorageInfo{x_size, y_size, z_size}};
+    transform(data_store, fortran_array_adapter);
+    auto data_store_view = make_host_view(data_store);
+    for (size_t z = 0; z < z_size; ++z)
+        for (size_t y = 0; y < y_size; ++y)
+            for (size_t x = 0; x < x_size; ++x)
+                EXPECT_EQ(data_store_view(x, y, z), 100 * (x + halo) + 10 * (y + halo) + z);
+
+    gridtools::fortran_array_adapter<IJKFortranDataStore> fortran_adopter{descriptor};
+    ASSERT_TRUE(fortran_adopter.is_adoptable());
+    IJKFortranDataStore adopted = fortran_adopter.adopt();
+    auto adopted_view = make_host_view(adopted);
+    for (size_t z = 0; z < z_size; ++z)
+        for (size_t y = 0; y < y_size; ++y)
+            for (size_t x = 0; x < x_size; ++x)
+                EXPECT_EQ(&adopted_view(x, y, z), &fortran_array[z][y + halo][x + halo]);
+}
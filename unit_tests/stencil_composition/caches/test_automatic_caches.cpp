@@ -0,0 +1,182 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/caches/automatic_caches.hpp>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        struct lap_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0)) -
+                              4 * eval(in());
+            }
+        };
+
+        struct flx_functor {
+            using lap = in_accessor<0, extent<0, 1, 0, 0>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<lap, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(lap(1, 0, 0)) - eval(lap());
+            }
+        };
+
+        struct fly_functor {
+            using lap = in_accessor<0, extent<0, 0, 0, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<lap, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(lap(0, 1, 0)) - eval(lap());
+            }
+        };
+
+        struct out_functor {
+            using in = in_accessor<0>;
+            using flx = in_accessor<1, extent<-1, 0, 0, 0>>;
+            using fly = in_accessor<2, extent<0, 0, -1, 0>>;
+            using out = inout_accessor<3>;
+            using param_list = make_param_list<in, flx, fly, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in()) - (float_type).1 * (eval(flx()) - eval(flx(-1, 0, 0)) + eval(fly()) -
+                                                                eval(fly(0, -1, 0)));
+            }
+        };
+
+        struct sum_below_functor {
+            using in = in_accessor<0>;
+            using acc = inout_accessor<1, extent<0, 0, 0, 0, -1, 0>>;
+            using param_list = make_param_list<in, acc>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::first_level) {
+                eval(acc()) = eval(in());
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::modify<1, 0>) {
+                eval(acc()) = eval(acc(0, 0, -1)) + eval(in());
+            }
+        };
+
+        struct automatic_caches_test : computation_fixture<2> {
+            automatic_caches_test() : computation_fixture<2>(14, 12, 6) {}
+
+            static float_type in(int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17; }
+            static float_type lap(int i, int j, int k) {
+                return in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k) - 4 * in(i, j, k);
+            }
+            static float_type flx(int i, int j, int k) { return lap(i + 1, j, k) - lap(i, j, k); }
+            static float_type fly(int i, int j, int k) { return lap(i, j + 1, k) - lap(i, j, k); }
+            static float_type hdiff(int i, int j, int k) {
+                return in(i, j, k) -
+                       (float_type).1 * (flx(i, j, k) - flx(i - 1, j, k) + fly(i, j, k) - fly(i, j - 1, k));
+            }
+
+            auto hdiff_mss() const GT_AUTO_RETURN(make_multistage(execute::parallel(),
+                make_stage<copy_functor>(p_0, p_tmp_0),
+                make_stage<lap_functor>(p_tmp_0, p_tmp_1),
+                make_independent(make_stage<flx_functor>(p_tmp_1, p_tmp_2), make_stage<fly_functor>(p_tmp_1, p_tmp_3)),
+                make_stage<out_functor>(p_tmp_0, p_tmp_2, p_tmp_3, p_1)));
+
+            auto sum_mss() const GT_AUTO_RETURN(make_multistage(execute::forward(),
+                make_stage<copy_functor>(p_1, p_tmp_4),
+                make_stage<sum_below_functor>(p_tmp_4, p_tmp_5),
+                make_stage<copy_functor>(p_tmp_5, p_2)));
+        };
+
+        TEST_F(automatic_caches_test, classification) {
+            using hdiff_t = decltype(hdiff_mss());
+            using sum_t = decltype(sum_mss());
+            using testee_t = GT_META_CALL(add_automatic_caches, (std::tuple<hdiff_t, sum_t>));
+
+            // zero offsets in a parallel mss and horizontal offsets: ij-caches
+            using expected_hdiff_caches_t =
+                std::tuple<detail::cache_impl<cache_type::ij, tmp_arg<0>, cache_io_policy::local>,
+                    detail::cache_impl<cache_type::ij, tmp_arg<1>, cache_io_policy::local>,
+                    detail::cache_impl<cache_type::ij, tmp_arg<2>, cache_io_policy::local>,
+                    detail::cache_impl<cache_type::ij, tmp_arg<3>, cache_io_policy::local>>;
+            // zero offsets or vertical offsets only in a serial mss: k-caches
+            using expected_sum_caches_t =
+                std::tuple<detail::cache_impl<cache_type::k, tmp_arg<4>, cache_io_policy::local>,
+                    detail::cache_impl<cache_type::k, tmp_arg<5>, cache_io_policy::local>>;
+
+            static_assert(std::is_same<typename std::tuple_element<0, testee_t>::type::cache_sequence_t,
+                              expected_hdiff_caches_t>::value,
+                "");
+            static_assert(std::is_same<typename std::tuple_element<1, testee_t>::type::cache_sequence_t,
+                              expected_sum_caches_t>::value,
+                "");
+        }
+
+        TEST_F(automatic_caches_test, shared_and_user_cached_temporaries_are_kept) {
+            // p_tmp_0 is used in two multi-stage stencils, p_tmp_1 has a user defined cache
+            using first_t = decltype(make_multistage(execute::parallel(),
+                define_caches(cache<cache_type::ij, cache_io_policy::local>(p_tmp_1)),
+                make_stage<copy_functor>(p_0, p_tmp_0),
+                make_stage<copy_functor>(p_tmp_0, p_tmp_1),
+                make_stage<copy_functor>(p_tmp_1, p_1)));
+            using second_t = decltype(
+                make_multistage(execute::parallel(), make_stage<lap_functor>(p_tmp_0, p_2)));
+            using testee_t = GT_META_CALL(add_automatic_caches, (std::tuple<first_t, second_t>));
+
+            static_assert(std::is_same<typename std::tuple_element<0, testee_t>::type::cache_sequence_t,
+                              typename first_t::cache_sequence_t>::value,
+                "");
+            static_assert(std::is_same<typename std::tuple_element<1, testee_t>::type::cache_sequence_t,
+                              std::tuple<>>::value,
+                "");
+        }
+
+        TEST_F(automatic_caches_test, horizontal_diffusion) {
+            auto out = make_storage(-1.);
+            make_computation(hdiff_mss()).run(p_0 = make_storage(in), p_1 = out);
+            verify(make_storage(hdiff), out);
+        }
+
+        TEST_F(automatic_caches_test, vertical_sum) {
+            auto out = make_storage(-1.);
+            make_computation(hdiff_mss(), sum_mss()).run(p_0 = make_storage(in), p_1 = make_storage(-1.), p_2 = out);
+            verify(make_storage([](int i, int j, int k) {
+                float_type res = 0;
+                for (int kk = 0; kk <= k; ++kk)
+                    res += hdiff(i, j, kk);
+                return res;
+            }),
+                out);
+        }
+    } // namespace
+} // namespace gridtools
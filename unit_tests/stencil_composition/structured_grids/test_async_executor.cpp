@@ -0,0 +1,189 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/async_executor.hpp>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+
+        struct event_log {
+            std::mutex m_mutex;
+            std::vector<int> m_events;
+
+            void push(int event) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_events.push_back(event);
+            }
+        };
+
+        // mock computation that reads `p_in` and writes `p_out`; logs `id` on start and `-id` on completion
+        struct mock_computation {
+            event_log &m_log;
+            int m_id;
+            int m_sleep_ms;
+
+            template <class... Args, class... DataStores>
+            void run(arg_storage_pair<Args, DataStores> const &...) {
+                m_log.push(m_id);
+                if (m_sleep_ms < 0)
+                    throw std::runtime_error("mock");
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_sleep_ms));
+                m_log.push(-m_id);
+            }
+
+            intent get_arg_intent(p_in) const { return intent::in; }
+            intent get_arg_intent(p_out) const { return intent::inout; }
+        };
+
+        data_store_t make_data_store() { return {storage_info_t(4, 4, 4), 0.}; }
+
+        TEST(async_executor, dependent_runs_are_ordered) {
+            event_log log;
+            mock_computation slow{log, 1, 50}, fast{log, 2, 0};
+            auto a = make_data_store(), b = make_data_store(), c = make_data_store();
+
+            async_executor testee(4, 1);
+            auto first = testee.submit(slow, p_in() = a, p_out() = b);
+            auto second = testee.submit(fast, p_in() = b, p_out() = c);
+            second.get();
+            first.get();
+            EXPECT_EQ(log.m_events, (std::vector<int>{1, -1, 2, -2}));
+        }
+
+        TEST(async_executor, independent_runs_overlap) {
+            event_log log;
+            mock_computation slow{log, 1, 50}, fast{log, 2, 0};
+            auto a = make_data_store(), b = make_data_store(), c = make_data_store();
+
+            async_executor testee(2, 1);
+            auto first = testee.submit(slow, p_in() = a, p_out() = b);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            auto second = testee.submit(fast, p_in() = a, p_out() = c);
+            second.get();
+            first.get();
+            EXPECT_EQ(log.m_events, (std::vector<int>{1, 2, -2, -1}));
+        }
+
+        TEST(async_executor, exceptions) {
+            event_log log;
+            mock_computation failing{log, 1, -1};
+            auto a = make_data_store(), b = make_data_store();
+
+            async_executor testee;
+            auto res = testee.submit(failing, p_in() = a, p_out() = b);
+            EXPECT_THROW(res.get(), std::runtime_error);
+            testee.wait();
+        }
+
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        struct scale_functor {
+            using inout = inout_accessor<0>;
+            using param_list = make_param_list<inout>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(inout()) = 2 * eval(inout());
+            }
+        };
+
+        struct async_stencils : computation_fixture<> {
+            async_stencils() : computation_fixture<>(13, 9, 7) {}
+        };
+
+        TEST_F(async_stencils, run_async) {
+            auto copy = make_computation(make_multistage(execute::parallel(), make_stage<copy_functor>(p_0, p_1)));
+            computation<arg<0>> scale =
+                make_computation(make_multistage(execute::parallel(), make_stage<scale_functor>(p_0)));
+
+            auto in = make_storage([](int i, int j, int k) { return i + j + k; });
+            auto out = make_storage();
+
+            copy.run_async(p_0 = in, p_1 = out);
+            for (int i = 0; i < 3; ++i)
+                scale.run_async(p_0 = out);
+            scale.run_async(p_0 = in).get();
+            async_executor::get_default().wait();
+
+            verify(make_storage([](int i, int j, int k) { return 8 * (i + j + k); }), out);
+            verify(make_storage([](int i, int j, int k) { return 2 * (i + j + k); }), in);
+        }
+
+        struct lap_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = 4 * eval(in()) - (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) +
+                                                   eval(in(0, 1, 0)));
+            }
+        };
+
+        struct async_temporaries : computation_fixture<1> {
+            async_temporaries() : computation_fixture<1>(34, 6, 3) {}
+        };
+
+        // the worker runs the computation with less threads than it was made for
+        TEST_F(async_temporaries, threads_per_worker) {
+            // as on a node with 8 cores, independently of the number of threads the tests are run with
+            const int max_threads = omp_get_max_threads();
+            omp_set_num_threads(8);
+            auto comp = make_computation(make_multistage(execute::forward(),
+                make_stage<copy_functor>(p_0, p_tmp_0),
+                make_stage<lap_functor>(p_tmp_0, p_1)));
+
+            auto in_f = [](int i, int j, int k) -> float_type { return i * i + 10 * j * j + 100 * k; };
+            auto in = make_storage(in_f);
+            auto expected = make_storage([&](int i, int j, int k) {
+                return 4 * in_f(i, j, k) -
+                       (in_f(i - 1, j, k) + in_f(i + 1, j, k) + in_f(i, j - 1, k) + in_f(i, j + 1, k));
+            });
+            {
+                async_executor executor(1, 3);
+                auto out = make_storage();
+                executor.submit(comp, p_0 = in, p_1 = out).get();
+                verify(expected, out);
+            }
+            // and again with all threads
+            auto out = make_storage();
+            comp.run(p_0 = in, p_1 = out);
+            verify(expected, out);
+            omp_set_num_threads(max_threads);
+        }
+    } // namespace
+} // namespace gridtools
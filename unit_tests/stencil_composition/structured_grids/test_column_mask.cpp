@@ -0,0 +1,172 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/column_mask.hpp>
+
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        struct lap_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = 4 * eval(in()) - (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) +
+                                                   eval(in(0, 1, 0)));
+            }
+        };
+
+        struct smooth_functor {
+            using in = in_accessor<0>;
+            using lap = in_accessor<1, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<2>;
+            using param_list = make_param_list<in, lap, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in()) - (float_type).25 * (4 * eval(lap()) - (eval(lap(-1, 0, 0)) +
+                                                                                    eval(lap(1, 0, 0)) +
+                                                                                    eval(lap(0, -1, 0)) +
+                                                                                    eval(lap(0, 1, 0))));
+            }
+        };
+
+        struct sum_below_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1, extent<0, 0, 0, 0, -1, 0>>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::first_level) {
+                eval(out()) = eval(in());
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::modify<1, 0>) {
+                eval(out()) = eval(out(0, 0, -1)) + eval(in());
+            }
+        };
+
+        struct column_mask_test : computation_fixture<2> {
+            column_mask_test() : computation_fixture<2>(29, 23, 7) {}
+
+            static float_type in(int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17; }
+            static float_type lap(int i, int j, int k) {
+                return 4 * in(i, j, k) - (in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k));
+            }
+            static float_type smooth(int i, int j, int k) {
+                return in(i, j, k) - (float_type).25 * (4 * lap(i, j, k) - (lap(i - 1, j, k) + lap(i + 1, j, k) +
+                                                                               lap(i, j - 1, k) + lap(i, j + 1, k)));
+            }
+
+            // active columns in compute domain coordinates
+            static bool is_active(int i, int j) { return (i * 5 + j * 3) % 7 < 2 || (i > 10 && i < 16); }
+
+            column_mask make_mask() const {
+                return {d1() - 2 * halo_size, d2() - 2 * halo_size, [](int_t i, int_t j) { return is_active(i, j); }};
+            }
+
+            // expected values on the active columns, the initial value elsewhere
+            template <class F>
+            static std::function<float_type(int, int, int)> masked(F f) {
+                return [f](int i, int j, int k) {
+                    bool inner = i >= (int)halo_size && j >= (int)halo_size;
+                    return inner && is_active(i - halo_size, j - halo_size) ? f(i, j, k) : -1;
+                };
+            }
+        };
+
+        TEST_F(column_mask_test, segments) {
+            column_mask testee(6,
+                3,
+                std::vector<array<int_t, 2>>{{{0, 0}}, {{1, 0}}, {{2, 0}}, {{5, 0}}, {{1, 1}}, {{1, 2}}, {{2, 2}},
+                    {{2, 0}}});
+            EXPECT_EQ(7, testee.size());
+            EXPECT_TRUE(testee.active(5, 0));
+            EXPECT_FALSE(testee.active(3, 0));
+
+            std::vector<std::vector<int_t>> segments;
+            auto collect = [&](column_segment const &s) { segments.push_back({s.i, s.j, s.i_size, s.j_size}); };
+
+            // runs along i, limited to two columns
+            testee.for_each_segment<0>(0, 1, 2, collect);
+            EXPECT_EQ((std::vector<std::vector<int_t>>{
+                          {0, 0, 2, 1}, {2, 0, 1, 1}, {5, 0, 1, 1}, {1, 1, 1, 1}, {1, 2, 2, 1}}),
+                segments);
+
+            // runs along j, split into two chunks of three and four columns
+            segments.clear();
+            testee.for_each_segment<1>(0, 2, 3, collect);
+            EXPECT_EQ((std::vector<std::vector<int_t>>{{0, 0, 1, 1}, {1, 0, 1, 2}}), segments);
+            segments.clear();
+            testee.for_each_segment<1>(1, 2, 3, collect);
+            EXPECT_EQ((std::vector<std::vector<int_t>>{{1, 2, 1, 1}, {2, 0, 1, 1}, {2, 2, 1, 1}, {5, 0, 1, 1}}),
+                segments);
+
+            EXPECT_THROW(column_mask(2, 2, std::vector<array<int_t, 2>>{{{2, 0}}}), std::runtime_error);
+        }
+
+        TEST_F(column_mask_test, temporaries_with_extents) {
+            auto out = make_storage(-1.);
+            auto comp = make_computation(p_0 = make_storage(in),
+                p_1 = out,
+                make_multistage(execute::parallel(),
+                    make_stage<lap_functor>(p_0, p_tmp_0),
+                    make_stage<smooth_functor>(p_0, p_tmp_0, p_1)));
+            comp.run_masked(make_mask());
+            verify(make_storage(masked(smooth)), out);
+        }
+
+        TEST_F(column_mask_test, vertical_dependency) {
+            auto out = make_storage(-1.);
+            auto comp = make_computation(p_0 = make_storage(in),
+                p_1 = out,
+                make_multistage(execute::forward(),
+                    make_stage<lap_functor>(p_0, p_tmp_0),
+                    make_stage<sum_below_functor>(p_tmp_0, p_1)));
+            comp.run_masked(make_mask());
+            verify(make_storage(masked([](int i, int j, int k) {
+                float_type res = 0;
+                for (int kk = 0; kk <= k; ++kk)
+                    res += lap(i, j, kk);
+                return res;
+            })),
+                out);
+        }
+
+        TEST_F(column_mask_test, empty_and_full) {
+            auto out = make_storage(-1.);
+            auto comp = make_computation(p_0 = make_storage(in),
+                p_1 = out,
+                make_multistage(execute::parallel(),
+                    make_stage<lap_functor>(p_0, p_tmp_0),
+                    make_stage<smooth_functor>(p_0, p_tmp_0, p_1)));
+            comp.run_masked(
+                column_mask(d1() - 2 * halo_size, d2() - 2 * halo_size, [](int_t, int_t) { return false; }));
+            verify(make_storage(-1.), out);
+            comp.run_masked(
+                column_mask(d1() - 2 * halo_size, d2() - 2 * halo_size, [](int_t, int_t) { return true; }));
+            verify(make_storage(smooth), out);
+
+            EXPECT_THROW(
+                comp.run_masked(column_mask(d1(), d2(), [](int_t, int_t) { return true; })), std::runtime_error);
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,272 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/computation_graph.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+
+        // mock computation that reads `p_in` and writes `p_out`
+        struct mock_computation {
+            std::vector<int> &m_log;
+            int m_id;
+            int m_threads = 0;
+            bool m_throw = false;
+
+            mock_computation(std::vector<int> &log, int id) : m_log(log), m_id(id) {}
+
+            template <class... Args, class... DataStores>
+            void run(arg_storage_pair<Args, DataStores> const &...) {
+                if (m_throw)
+                    throw std::runtime_error("mock");
+                m_threads = omp_get_max_threads();
+#pragma omp critical(test_computation_graph_log)
+                m_log.push_back(m_id);
+            }
+
+            intent get_arg_intent(p_in) const { return intent::in; }
+            intent get_arg_intent(p_out) const { return intent::inout; }
+        };
+
+        data_store_t make_data_store() { return {storage_info_t(4, 4, 4), 0.}; }
+
+        TEST(computation_graph, dependencies) {
+            std::vector<int> log;
+            mock_computation c0{log, 0}, c1{log, 1}, c2{log, 2}, c3{log, 3};
+            auto a = make_data_store(), b = make_data_store(), c = make_data_store(), d = make_data_store();
+
+            computation_graph testee(4);
+            testee.add(c0, p_in() = a, p_out() = b);
+            testee.add(c1, p_in() = a, p_out() = c);
+            testee.add(c2, p_in() = b, p_out() = d); // read after write of b
+            testee.add(c3, p_in() = d, p_out() = a); // read after write of d, write after read of a
+
+            EXPECT_TRUE(testee.predecessors(0).empty());
+            EXPECT_TRUE(testee.predecessors(1).empty());
+            EXPECT_EQ(testee.predecessors(2), std::vector<std::size_t>{0});
+            EXPECT_EQ(testee.predecessors(3), (std::vector<std::size_t>{0, 1, 2}));
+            ASSERT_EQ(testee.waves().size(), 3);
+            EXPECT_EQ(testee.waves()[0], (std::vector<std::size_t>{0, 1}));
+
+            testee.run();
+            ASSERT_EQ(log.size(), 4);
+            EXPECT_EQ(log[2], 2);
+            EXPECT_EQ(log[3], 3);
+        }
+
+        TEST(computation_graph, same_computation_is_serialized) {
+            std::vector<int> log;
+            mock_computation comp{log, 0};
+            auto a = make_data_store(), b = make_data_store(), c = make_data_store();
+
+            computation_graph testee(4);
+            testee.add(comp, p_in() = a, p_out() = b);
+            testee.add(comp, p_in() = a, p_out() = c);
+            EXPECT_EQ(testee.predecessors(1), std::vector<std::size_t>{0});
+        }
+
+        TEST(computation_graph, team_sizes) {
+            std::vector<int> log;
+            mock_computation cheap{log, 0}, expensive{log, 1};
+            auto a = make_data_store(), b = make_data_store(), c = make_data_store();
+
+            computation_graph testee(4);
+            auto cheap_id = testee.add(cheap, p_in() = a, p_out() = b);
+            auto expensive_id = testee.add(expensive, p_in() = a, p_out() = c);
+            testee.set_cost_hint(cheap_id, 1);
+            testee.set_cost_hint(expensive_id, 3);
+            testee.run();
+#ifdef _OPENMP
+            EXPECT_EQ(cheap.m_threads, 1);
+            EXPECT_EQ(expensive.m_threads, 3);
+#endif
+            EXPECT_GE(testee.cost(cheap_id), 0);
+        }
+
+        TEST(computation_graph, plan_teams) {
+            auto teams = _impl::computation_graph_detail::plan_teams({10, 11, 12}, {4, 2, 2}, 8);
+            ASSERT_EQ(teams.size(), 3);
+            EXPECT_EQ(teams[0].m_nodes, std::vector<std::size_t>{10});
+            EXPECT_EQ(teams[0].m_threads, 4);
+            EXPECT_EQ(teams[1].m_threads, 2);
+            EXPECT_EQ(teams[2].m_threads, 2);
+
+            // more nodes than threads: teams process several nodes
+            teams = _impl::computation_graph_detail::plan_teams({0, 1, 2, 3, 4}, {5, 1, 1, 1, 1}, 2);
+            ASSERT_EQ(teams.size(), 2);
+            EXPECT_EQ(teams[0].m_nodes, std::vector<std::size_t>{0});
+            EXPECT_EQ(teams[1].m_nodes, (std::vector<std::size_t>{1, 2, 3, 4}));
+        }
+
+        TEST(computation_graph, exceptions) {
+            std::vector<int> log;
+            mock_computation ok{log, 0}, failing{log, 1};
+            failing.m_throw = true;
+            auto a = make_data_store(), b = make_data_store(), c = make_data_store();
+
+            computation_graph testee(2);
+            testee.add(ok, p_in() = a, p_out() = b);
+            testee.add(failing, p_in() = a, p_out() = c);
+            EXPECT_THROW(testee.run(), std::runtime_error);
+
+            EXPECT_THROW(testee.add(ok, p_in() = data_store_t(), p_out() = b), std::runtime_error);
+        }
+
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        struct sum_functor {
+            using in1 = in_accessor<0>;
+            using in2 = in_accessor<1>;
+            using out = inout_accessor<2>;
+            using param_list = make_param_list<in1, in2, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in1()) + eval(in2());
+            }
+        };
+
+        struct computation_graph_stencils : computation_fixture<> {
+            computation_graph_stencils() : computation_fixture<>(13, 9, 7) {}
+        };
+
+        TEST_F(computation_graph_stencils, run) {
+            auto copy = make_computation(make_multistage(execute::parallel(), make_stage<copy_functor>(p_0, p_1)));
+            auto sum = make_computation(make_multistage(execute::parallel(), make_stage<sum_functor>(p_0, p_1, p_2)));
+
+            auto a = make_storage([](int i, int j, int k) { return i + j + k; });
+            auto b = make_storage([](int i, int j, int k) { return i * j * k; });
+            auto a_copy = make_storage(), b_copy = make_storage(), res = make_storage();
+
+            computation_graph testee;
+            testee.add(copy, p_0 = a, p_1 = a_copy);
+            testee.add(copy, p_0 = b, p_1 = b_copy);
+            testee.add(sum, p_0 = a_copy, p_1 = b_copy, p_2 = res);
+            ASSERT_EQ(testee.waves().size(), 3);
+
+            for (int i = 0; i < 3; ++i)
+                testee.run();
+            verify(make_storage([](int i, int j, int k) { return i + j + k + i * j * k; }), res);
+        }
+
+        TEST_F(computation_graph_stencils, independent) {
+            auto copy1 = make_computation(make_multistage(execute::parallel(), make_stage<copy_functor>(p_0, p_1)));
+            auto copy2 = make_computation(make_multistage(execute::parallel(), make_stage<copy_functor>(p_0, p_1)));
+
+            auto a = make_storage([](int i, int j, int k) { return i - j + k; });
+            auto b = make_storage(), c = make_storage();
+
+            computation_graph testee;
+            testee.add(copy1, p_0 = a, p_1 = b);
+            testee.add(copy2, p_0 = a, p_1 = c);
+            ASSERT_EQ(testee.waves().size(), 1);
+
+            testee.run();
+            verify(a, b);
+            verify(a, c);
+        }
+
+        struct scale_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = 2 * eval(in());
+            }
+        };
+
+        // sums the neighbours of `in` along k
+        struct neighbour_sum_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1, extent<0, 0, 0, 0, -1, 0>>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static float_type neighbours(Evaluation &eval) {
+                return eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0));
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::first_level) {
+                eval(out()) = neighbours(eval);
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::modify<1, 0>) {
+                eval(out()) = eval(out(0, 0, -1)) + neighbours(eval);
+            }
+        };
+
+        struct computation_graph_temporaries : computation_fixture<1> {
+            computation_graph_temporaries() : computation_fixture<1>(34, 6, 3) {}
+        };
+
+        // the computations of a wave run on teams with less threads than the computations were made for
+        TEST_F(computation_graph_temporaries, teams) {
+            // as on a node with 8 cores, independently of the number of threads the tests are run with
+            const int max_threads = omp_get_max_threads();
+            omp_set_num_threads(8);
+            auto make = [&] {
+                return make_computation(make_multistage(execute::forward(),
+                    make_stage<scale_functor>(p_0, p_tmp_0),
+                    make_stage<neighbour_sum_functor>(p_tmp_0, p_1)));
+            };
+            auto comp1 = make();
+            auto comp2 = make();
+
+            auto in = [](int i, int j, int k) { return i + 10 * j + 100 * k; };
+            auto expected = [&](int i, int j, int k) {
+                float_type res = 0;
+                for (int kk = 0; kk <= k; ++kk)
+                    res += 2 * (in(i - 1, j, kk) + in(i + 1, j, kk) + in(i, j - 1, kk) + in(i, j + 1, kk));
+                return res;
+            };
+            auto a = make_storage(in);
+            auto b = make_storage(), c = make_storage();
+
+            computation_graph testee;
+            testee.add(comp1, p_0 = a, p_1 = b);
+            testee.add(comp2, p_0 = a, p_1 = c);
+            ASSERT_EQ(testee.waves().size(), 1);
+
+            for (int i = 0; i < 3; ++i) {
+                testee.run();
+                verify(make_storage(expected), b);
+                verify(make_storage(expected), c);
+            }
+            omp_set_num_threads(max_threads);
+        }
+    } // namespace
+} // namespace gridtools
@@ -160,3 +160,78 @@ TEST_F(expandable_parameters, caches) {
             make_stage<copy_functor>(p_out, p_tmp)));
     verify({in, in, in, in, in}, out);
 }
+
+struct lap_functor {
+    typedef accessor<0, intent::inout> out;
+    typedef accessor<1, intent::in, extent<-1, 1, -1, 1>> in;
+
+    typedef make_param_list<out, in> param_list;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation &eval) {
+        eval(out()) = 4 * eval(in()) - eval(in(-1, 0, 0)) - eval(in(1, 0, 0)) - eval(in(0, -1, 0)) - eval(in(0, 1, 0));
+    }
+};
+
+struct expandable_parameters_lap : computation_fixture<2> {
+    expandable_parameters_lap() : computation_fixture<2>(13, 9, 7) {}
+    using storages_t = std::vector<storage_type>;
+
+    static float_type in(int i, int j, int k, int n) { return (i * 7 + j * 13 + k * 3 + n * 5) % 17; }
+    static float_type lap(int i, int j, int k, int n) {
+        return 4 * in(i, j, k, n) - in(i - 1, j, k, n) - in(i + 1, j, k, n) - in(i, j - 1, k, n) -
+               in(i, j + 1, k, n);
+    }
+    static float_type lap_lap(int i, int j, int k, int n) {
+        return 4 * lap(i, j, k, n) - lap(i - 1, j, k, n) - lap(i + 1, j, k, n) - lap(i, j - 1, k, n) -
+               lap(i, j + 1, k, n);
+    }
+
+    template <class ExpandFactor>
+    void run_lap_lap(ExpandFactor factor, int n) {
+        storages_t ins, outs, expected;
+        for (int t = 0; t != n; ++t) {
+            ins.push_back(make_storage([=](int i, int j, int k) { return in(i, j, k, t); }));
+            outs.push_back(make_storage(-1.));
+            expected.push_back(make_storage([=](int i, int j, int k) { return lap_lap(i, j, k, t); }));
+        }
+        arg<0, storages_t> p_out;
+        arg<1, storages_t> p_in;
+        tmp_arg<2, storages_t> p_tmp;
+        auto comp = gridtools::make_expandable_computation<backend_t>(factor,
+            make_grid(),
+            p_in = ins,
+            p_out = outs,
+            make_multistage(
+                execute::parallel(), make_stage<lap_functor>(p_tmp, p_in), make_stage<lap_functor>(p_out, p_tmp)));
+        comp.run();
+        for (int t = 0; t != n; ++t)
+            verify(expected[t], outs[t]);
+    }
+};
+
+TEST_F(expandable_parameters_lap, remainder_decomposition) {
+    using factors_t = _impl::expand_detail::remainder_factors<8>::type;
+    static_assert(std::is_same<factors_t,
+                      meta::list<std::integral_constant<size_t, 4>,
+                          std::integral_constant<size_t, 2>,
+                          std::integral_constant<size_t, 1>>>::value,
+        "");
+    static_assert(std::is_same<_impl::expand_detail::remainder_factors<1>::type, meta::list<>>::value, "");
+    static_assert(std::is_same<_impl::expand_detail::remainder_factors<3>::type,
+                      meta::list<std::integral_constant<size_t, 2>, std::integral_constant<size_t, 1>>>::value,
+        "");
+
+    // two full chunks and a remainder of 4 + 2 + 1 tracers, with expanded temporaries
+    run_lap_lap(expand_factor<8>(), 23);
+    // a remainder only
+    run_lap_lap(expand_factor<8>(), 5);
+    // expand factors that are not powers of two
+    run_lap_lap(expand_factor<3>(), 11);
+}
+
+TEST_F(expandable_parameters_lap, concurrent_chunks) {
+    run_lap_lap(expand_factor<2, 2>(), 7);
+    run_lap_lap(expand_factor<4, 3>(), 23);
+    run_lap_lap(expand_factor<2, 2>(), 1);
+}
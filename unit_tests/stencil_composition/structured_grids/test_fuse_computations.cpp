@@ -0,0 +1,158 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        struct lap_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0)) -
+                              4 * eval(in());
+            }
+        };
+
+        struct scale_functor {
+            using in = in_accessor<0>;
+            using coeff = in_accessor<1>;
+            using out = inout_accessor<2>;
+            using param_list = make_param_list<in, coeff, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(coeff()) * eval(in());
+            }
+        };
+
+        struct update_functor {
+            using in = in_accessor<0>;
+            using tendency = in_accessor<1>;
+            using out = inout_accessor<2>;
+            using param_list = make_param_list<in, tendency, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in()) + eval(tendency());
+            }
+        };
+
+        struct smooth_update_functor {
+            using in = in_accessor<0>;
+            using tendency = in_accessor<1, extent<-1, 1, 0, 0>>;
+            using out = inout_accessor<2>;
+            using param_list = make_param_list<in, tendency, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in()) + (float_type).5 * (eval(tendency(-1, 0, 0)) + eval(tendency(1, 0, 0)));
+            }
+        };
+
+        struct fuse_computations_test : computation_fixture<2> {
+            fuse_computations_test() : computation_fixture<2>(13, 11, 5) {}
+
+            static float_type u(int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17; }
+            static float_type lap_u(int i, int j, int k) {
+                return u(i - 1, j, k) + u(i + 1, j, k) + u(i, j - 1, k) + u(i, j + 1, k) - 4 * u(i, j, k);
+            }
+            static float_type coeff(int i, int j, int k) { return .1 + .01 * ((i + j + k) % 3); }
+
+            // tendency = lap(u), computed through a temporary
+            auto make_tendency() const GT_AUTO_RETURN(make_computation(make_multistage(execute::parallel(),
+                make_stage<copy_functor>(p_0, p_tmp_0),
+                make_stage<lap_functor>(p_tmp_0, p_1))));
+
+            // out = u + coeff * tendency, using a temporary with the same placeholder as `make_tendency`
+            auto make_update(storage_type const &c) const
+                GT_AUTO_RETURN(make_computation(p_3 = c,
+                    make_multistage(execute::forward(),
+                        make_stage<scale_functor>(p_1, p_3, p_tmp_0),
+                        make_stage<update_functor>(p_0, p_tmp_0, p_2))));
+
+            // out = u + (tendency(i - 1) + tendency(i + 1)) / 2
+            auto make_smooth_update() const GT_AUTO_RETURN(make_computation(
+                make_multistage(execute::parallel(), make_stage<smooth_update_functor>(p_0, p_1, p_2))));
+        };
+
+        TEST_F(fuse_computations_test, same_result_as_sequential_runs) {
+            auto c = make_storage(coeff);
+            auto tendency = make_tendency();
+            auto update = make_update(c);
+
+            auto in = make_storage(u);
+            auto expected_tendency = make_storage(-1.);
+            auto expected_out = make_storage(-1.);
+            tendency.run(p_0 = in, p_1 = expected_tendency);
+            update.run(p_0 = in, p_1 = expected_tendency, p_2 = expected_out);
+
+            auto fused = fuse_computations(tendency, update);
+            auto actual_tendency = make_storage(-1.);
+            auto actual_out = make_storage(-1.);
+            fused.run(p_0 = in, p_1 = actual_tendency, p_2 = actual_out);
+
+            verify(expected_tendency, actual_tendency);
+            verify(expected_out, actual_out);
+            verify(make_storage([](int i, int j, int k) { return u(i, j, k) + coeff(i, j, k) * lap_u(i, j, k); }),
+                actual_out);
+        }
+
+        TEST_F(fuse_computations_test, promoted_temporary) {
+            auto fused = fuse_computations(as_temporaries(p_1), make_tendency(), make_smooth_update());
+
+            auto out = make_storage(-1.);
+            fused.run(p_0 = make_storage(u), p_2 = out);
+
+            verify(make_storage([](int i, int j, int k) {
+                return u(i, j, k) + (float_type).5 * (lap_u(i - 1, j, k) + lap_u(i + 1, j, k));
+            }),
+                out);
+        }
+
+        TEST_F(fuse_computations_test, repeated_runs) {
+            auto fused = fuse_computations(as_temporaries(p_1), make_tendency(), make_update(make_storage(coeff)));
+
+            auto in = make_storage(u);
+            auto out = make_storage(-1.);
+            for (int run = 0; run < 3; ++run) {
+                fused.run(p_0 = in, p_2 = out);
+                verify(make_storage([](int i, int j, int k) { return u(i, j, k) + coeff(i, j, k) * lap_u(i, j, k); }),
+                    out);
+            }
+        }
+
+        TEST_F(fuse_computations_test, different_grids) {
+            auto other = ::gridtools::make_computation<backend_t>(
+                ::gridtools::make_grid(i_halo_descriptor(), j_halo_descriptor(), axis<1>(d3() - 1)),
+                make_multistage(execute::parallel(), make_stage<smooth_update_functor>(p_0, p_1, p_2)));
+            EXPECT_THROW(fuse_computations(as_temporaries(p_1), make_tendency(), other), std::runtime_error);
+        }
+    } // namespace
+} // namespace gridtools
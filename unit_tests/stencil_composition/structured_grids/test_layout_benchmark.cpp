@@ -0,0 +1,170 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/tools/layout_benchmark.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        using namespace dimension_orders;
+
+        static_assert(std::is_same<dimension_order_layout_t<jki, 3>, layout_map<2, 0, 1>>::value, "");
+        static_assert(std::is_same<dimension_order_layout_t<ijk, 3>, layout_map<0, 1, 2>>::value, "");
+        static_assert(std::is_same<dimension_order_layout_t<kij, 3>, layout_map<1, 2, 0>>::value, "");
+        static_assert(std::is_same<dimension_order_layout_t<jki, 4>, layout_map<3, 1, 2, 0>>::value, "");
+        static_assert(std::is_same<dimension_order_layout_t<kij, 2>, layout_map<0, 1>>::value, "");
+        static_assert(std::is_same<dimension_order_layout_t<kji, 2>, layout_map<1, 0>>::value, "");
+
+        // the default layout of the mc backend is jki
+        using mc_traits_t = storage_traits<backend::mc>;
+        static_assert(std::is_same<mc_traits_t::ordered_storage_info_t<0, jki, 3, halo<1, 1, 0>>,
+                          mc_traits_t::storage_info_t<0, 3, halo<1, 1, 0>>>::value,
+            "");
+        static_assert(std::is_same<mc_traits_t::ordered_special_storage_info_t<1, jki, selector<1, 0, 1>>,
+                          mc_traits_t::special_storage_info_t<1, selector<1, 0, 1>>>::value,
+            "");
+        static_assert(std::is_same<mc_traits_t::ordered_storage_info_t<2, ikj>::layout_t, layout_map<0, 2, 1>>::value,
+            "");
+
+        TEST(dimension_order, to_string) {
+            EXPECT_EQ("ijk", to_string(ijk{}));
+            EXPECT_EQ("ikj", to_string(ikj{}));
+            EXPECT_EQ("jik", to_string(jik{}));
+            EXPECT_EQ("jki", to_string(jki{}));
+            EXPECT_EQ("kij", to_string(kij{}));
+            EXPECT_EQ("kji", to_string(kji{}));
+        }
+
+        struct lap_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = 4 * eval(in()) - (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) +
+                                                   eval(in(0, 1, 0)));
+            }
+        };
+
+        struct prefix_sum_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1, extent<0, 0, 0, 0, -1, 0>>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::first_level) {
+                eval(out()) = eval(in());
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::modify<1, 0>) {
+                eval(out()) = eval(out(0, 0, -1)) + eval(in());
+            }
+        };
+
+        float_type in_f(int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17; }
+
+        float_type lap_f(int i, int j, int k) {
+            return 4 * in_f(i, j, k) -
+                   (in_f(i - 1, j, k) + in_f(i + 1, j, k) + in_f(i, j - 1, k) + in_f(i, j + 1, k));
+        }
+
+        template <class Order>
+        using storage_t = storage_traits<backend_t>::data_store_t<float_type,
+            storage_traits<backend_t>::custom_layout_storage_info_t<0, dimension_order_layout_t<Order, 3>, halo<1, 1, 0>>>;
+
+        template <class Storage>
+        struct prefix_sum {
+            computation<> m_comp;
+            Storage m_out;
+
+            void run() { m_comp.run(); }
+        };
+
+        // a horizontal stencil followed by a vertical solver
+        struct make_prefix_sum {
+            template <class Order>
+            prefix_sum<storage_t<Order>> operator()(Order, std::array<uint_t, 3> const &size) const {
+                typename storage_t<Order>::storage_info_t info(size[0], size[1], size[2]);
+                storage_t<Order> in(info, [](int i, int j, int k) { return in_f(i, j, k); });
+                storage_t<Order> out(info, -1.);
+                arg<0, storage_t<Order>> p_in;
+                arg<1, storage_t<Order>> p_out;
+                tmp_arg<2, storage_t<Order>> p_lap;
+                auto grid = make_grid(halo_descriptor(1, 1, 1, size[0] - 2, size[0]),
+                    halo_descriptor(1, 1, 1, size[1] - 2, size[1]),
+                    size[2]);
+                return {make_computation<backend_t>(grid,
+                            p_in = in,
+                            p_out = out,
+                            make_multistage(execute::parallel(), make_stage<lap_functor>(p_in, p_lap)),
+                            make_multistage(execute::forward(), make_stage<prefix_sum_functor>(p_lap, p_out))),
+                    out};
+            }
+        };
+
+        struct check_f {
+            std::array<uint_t, 3> m_size;
+
+            template <class Order>
+            void operator()(Order order) const {
+                auto comp = make_prefix_sum{}(order, m_size);
+                comp.run();
+                comp.m_out.sync();
+                auto view = make_host_view(comp.m_out);
+                for (int i = 1; i < m_size[0] - 1; ++i)
+                    for (int j = 1; j < m_size[1] - 1; ++j) {
+                        float_type expected = 0;
+                        for (int k = 0; k < m_size[2]; ++k) {
+                            expected += lap_f(i, j, k);
+                            EXPECT_EQ(expected, view(i, j, k)) << to_string(order) << " " << i << " " << j << " " << k;
+                        }
+                    }
+            }
+        };
+
+        TEST(layout_benchmark, orders_give_same_result) {
+            host::for_each<meta::list<ijk, ikj, jik, jki, kij, kji>>(check_f{{{13, 9, 6}}});
+        }
+
+        // checks the structure of the timings and of the report, the measured times themselves are not compared
+        TEST(layout_benchmark, report) {
+            std::vector<std::array<uint_t, 3>> sizes = {{{12, 10, 4}}, {{6, 6, 9}}};
+            auto timings = benchmark_layouts<jki, ijk, kij>(make_prefix_sum{}, sizes, 1);
+            ASSERT_EQ(6, timings.size());
+            for (auto const &timing : timings)
+                EXPECT_GT(timing.seconds, 0);
+            EXPECT_EQ("jki", timings[0].order);
+            EXPECT_EQ("kij", timings[5].order);
+            EXPECT_EQ(sizes[1], timings[5].size);
+
+            auto best = best_layouts(timings);
+            ASSERT_EQ(2, best.size());
+            EXPECT_EQ(sizes[0], best[0].size);
+            EXPECT_EQ(sizes[1], best[1].size);
+
+            auto report = layout_report(timings);
+            EXPECT_EQ(6, std::count(report.begin(), report.end(), '\n'));
+            EXPECT_NE(std::string::npos, report.find(best[0].order + ": "));
+        }
+
+        TEST(layout_benchmark, repetitions) {
+            EXPECT_THROW(benchmark_layouts<jki>(make_prefix_sum{}, {{{8, 8, 4}}}, 0), std::runtime_error);
+        }
+    } // namespace
+} // namespace gridtools
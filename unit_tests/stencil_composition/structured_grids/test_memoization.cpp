@@ -0,0 +1,146 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/memoization.hpp>
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/stencil_composition/stencil_functions.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        std::atomic<int> lap_calls(0);
+
+        struct lap_function {
+            using out = inout_accessor<0>;
+            using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+            using param_list = make_param_list<out, in>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                ++lap_calls;
+                eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0)) -
+                              4 * eval(in());
+            }
+        };
+
+        struct grad_functor {
+            using in = in_accessor<0, extent<-1, 2, -1, 2>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = call<lap_function>::at<1, 0, 0>::with(eval, in()) +
+                              call<lap_function>::with(eval, in(0, 1, 0)) - 2 * call<lap_function>::with(eval, in());
+            }
+        };
+
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        using memoized_grad_functor = memoized<grad_functor, memoize<lap_function, grad_functor::in>>;
+
+        struct memoization : computation_fixture<3> {
+            memoization() : computation_fixture<3>(23, 19, 4) {}
+
+            static float_type in(int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17; }
+            static float_type lap(int i, int j, int k) {
+                return in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k) - 4 * in(i, j, k);
+            }
+            static float_type grad(int i, int j, int k) {
+                return lap(i + 1, j, k) + lap(i, j + 1, k) - 2 * lap(i, j, k);
+            }
+
+            template <class Functor>
+            int run_grad() {
+                auto out = make_storage(-1.);
+                lap_calls = 0;
+                make_computation(make_multistage(execute::parallel(),
+                                     make_stage<copy_functor>(p_0, p_tmp_0),
+                                     make_stage<Functor>(p_tmp_0, p_1)))
+                    .run(p_0 = make_storage(in), p_1 = out);
+                verify(make_storage(grad), out);
+                return lap_calls;
+            }
+        };
+
+        TEST_F(memoization, expansion) {
+            using mss_t = decltype(make_multistage(execute::parallel(),
+                make_stage<copy_functor>(p_0, p_tmp_0),
+                make_independent(make_stage<memoized_grad_functor>(p_tmp_0, p_1),
+                    make_stage<memoized_grad_functor>(p_tmp_0, p_2))));
+            using testee_t = GT_META_CALL(expand_memoized_stages, std::tuple<mss_t>);
+            using esfs_t = typename std::tuple_element<0, testee_t>::type::esf_sequence_t;
+
+            // the stages of the independent group share the stage that computes the laplacian
+            static_assert(std::tuple_size<esfs_t>::value == 3, "");
+            using memo_esf_t = typename std::tuple_element<1, esfs_t>::type;
+            static_assert(std::is_same<typename memo_esf_t::esf_function_t, lap_function>::value, "");
+            using memo_plh_t = typename std::tuple_element<0, typename memo_esf_t::args_t>::type;
+            static_assert(is_tmp_arg<memo_plh_t>::value, "");
+            static_assert(
+                std::is_same<typename std::tuple_element<1, typename memo_esf_t::args_t>::type, tmp_arg<0>>::value, "");
+
+            using independent_t = typename std::tuple_element<2, esfs_t>::type;
+            using grad_esf_t = typename std::tuple_element<0, typename independent_t::esf_list>::type;
+            static_assert(std::is_same<typename grad_esf_t::args_t, std::tuple<tmp_arg<0>, arg<1>, memo_plh_t>>::value,
+                "");
+            // the laplacian is read at offsets (0, 0), (1, 0) and (0, 1)
+            using memo_accessor_t = GT_META_CALL(meta::last, typename grad_esf_t::esf_function_t::param_list);
+            static_assert(std::is_same<typename memo_accessor_t::extent_t, extent<0, 1, 0, 1>>::value, "");
+        }
+
+        TEST_F(memoization, plain_stages_are_kept) {
+            using mss_t = decltype(make_multistage(
+                execute::forward(), make_stage<copy_functor>(p_0, p_tmp_0), make_stage<grad_functor>(p_tmp_0, p_1)));
+            using testee_t = GT_META_CALL(expand_memoized_stages, std::tuple<mss_t>);
+            static_assert(std::is_same<testee_t, std::tuple<mss_t>>::value, "");
+        }
+
+        TEST_F(memoization, one_evaluation_per_point) {
+            // the blocks of the threads overlap by the extents, the number of evaluations depends on the threads
+            const int max_threads = omp_get_max_threads();
+            omp_set_num_threads(1);
+            int plain_calls = run_grad<grad_functor>();
+            int memoized_calls = run_grad<memoized_grad_functor>();
+            omp_set_num_threads(max_threads);
+            int ni = d1() - 2 * halo_size;
+            int nj = d2() - 2 * halo_size;
+            EXPECT_EQ(plain_calls, 3 * ni * nj * d3());
+            // the laplacian is computed once per point of the compute domain extended by the memoized extent
+            EXPECT_GE(memoized_calls, (ni + 1) * (nj + 1) * d3());
+            EXPECT_LT(memoized_calls, plain_calls / 2);
+        }
+
+        TEST_F(memoization, not_expanded) {
+            // without the transformation, a memoized stage computes the same values as the original one
+            auto out = make_storage(-1.);
+            make_computation(make_multistage(execute::parallel(),
+                                 make_stage<copy_functor>(p_0, p_tmp_0),
+                                 make_stage<grad_functor>(p_tmp_0, p_tmp_1),
+                                 make_stage<memoized<copy_functor>>(p_tmp_1, p_1)))
+                .run(p_0 = make_storage(in), p_1 = out);
+            verify(make_storage(grad), out);
+        }
+    } // namespace
+} // namespace gridtools
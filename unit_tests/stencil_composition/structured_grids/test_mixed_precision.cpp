@@ -0,0 +1,144 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        struct mixed_precision : computation_fixture<> {
+            mixed_precision() : computation_fixture<>(13, 9, 7) {}
+
+            using float_storage_type = storage_tr::data_store_t<float, storage_info_t>;
+            using double_storage_type = storage_tr::data_store_t<double, storage_info_t>;
+
+            static float_type in(int i, int j, int k) { return i * 1.1 + j * 2.3 + k * .7; }
+            // the value after a round trip through the single-precision temporary
+            static float_type third(int i, int j, int k) { return (double)(float)(in(i, j, k) / 3.) * 3; }
+        };
+
+        using tmp_t = mixed_precision_tmp_arg<0, double, mixed_precision::float_storage_type>;
+
+        GT_STATIC_ASSERT((std::is_same<tmp_t::data_store_t::data_t, float>::value), "");
+        GT_STATIC_ASSERT((std::is_same<compute_type<tmp_t>::type, double>::value), "");
+        GT_STATIC_ASSERT((std::is_same<deref_type<tmp_t, intent::in>::type, double>::value), "");
+        GT_STATIC_ASSERT((std::is_same<deref_type<tmp_t, intent::inout>::type, float &>::value), "");
+        GT_STATIC_ASSERT(
+            (std::is_same<compute_type<arg<0, mixed_precision::float_storage_type>>::type, float>::value), "");
+        GT_STATIC_ASSERT(
+            (std::is_same<compute_type<mixed_precision_arg<0, float, mixed_precision::double_storage_type>>::type,
+                float>::value),
+            "");
+
+        struct to_third {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in()) / 3.;
+            }
+        };
+
+        struct from_third {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                GT_STATIC_ASSERT((std::is_same<decltype(eval(in())), double>::value), "not converted at deref");
+                eval(out()) = eval(in()) * 3;
+            }
+        };
+
+        struct from_third_below {
+            using in = in_accessor<0, extent<0, 0, 0, 0, -1, 0>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::first_level) {
+                eval(out()) = eval(in()) * 3;
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis<1>::full_interval::modify<1, 0>) {
+                eval(out()) = eval(in(0, 0, -1)) * 3;
+            }
+        };
+
+        TEST_F(mixed_precision, temporaries) {
+            auto out = make_storage(-1.);
+            make_computation(p_0 = make_storage(in),
+                p_1 = out,
+                make_multistage(execute::parallel(),
+                    make_stage<to_third>(p_0, tmp_t()),
+                    make_stage<from_third>(tmp_t(), p_1)))
+                .run();
+            verify(make_storage(third), out);
+        }
+
+        TEST_F(mixed_precision, k_caches) {
+            auto out = make_storage(-1.);
+            make_computation(p_0 = make_storage(in),
+                p_1 = out,
+                make_multistage(execute::forward(),
+                    define_caches(cache<cache_type::k, cache_io_policy::local>(tmp_t())),
+                    make_stage<to_third>(p_0, tmp_t()),
+                    make_stage<from_third_below>(tmp_t(), p_1)))
+                .run();
+            verify(make_storage([](int i, int j, int k) { return third(i, j, k ? k - 1 : 0); }), out);
+        }
+
+        TEST_F(mixed_precision, fields) {
+            // a field stored in double and computed in float, the reverse of the temporaries above
+            auto in_double = make_storage<double_storage_type>(in);
+            auto out = make_storage(-1.);
+            make_computation(mixed_precision_arg<0, float, double_storage_type>() = in_double,
+                p_1 = out,
+                make_multistage(execute::parallel(),
+                    make_stage<to_third>(mixed_precision_arg<0, float, double_storage_type>(), p_tmp_0),
+                    make_stage<to_third>(p_tmp_0, p_1)))
+                .run();
+            verify(make_storage([](int i, int j, int k) { return (float_type)((float)in(i, j, k) / 3.) / 3.; }), out);
+        }
+
+        // the memoized values of a function are read in the compute type of its input
+        GT_STATIC_ASSERT(
+            (std::is_same<compute_type<plh<memoization_impl_::memo_tag<0, 0, to_third, meta::list<tmp_t>>,
+                              mixed_precision::float_storage_type,
+                              tmp_t::location_t,
+                              true>>::type,
+                double>::value),
+            "");
+
+        TEST_F(mixed_precision, fused_computations) {
+            // the renamed temporary and the promoted field are read in double by `from_third`
+            using field_t = mixed_precision_arg<2, double, float_storage_type>;
+            auto thirds = make_computation(make_multistage(
+                execute::parallel(), make_stage<to_third>(p_0, tmp_t()), make_stage<from_third>(tmp_t(), p_1)));
+            auto store = make_computation(make_multistage(execute::parallel(), make_stage<to_third>(p_1, field_t())));
+            auto load = make_computation(make_multistage(execute::parallel(), make_stage<from_third>(field_t(), p_3)));
+
+            auto out = make_storage(-1.);
+            auto loaded = make_storage(-1.);
+            fuse_computations(as_temporaries(field_t()), thirds, store, load)
+                .run(p_0 = make_storage(in), p_1 = out, p_3 = loaded);
+            verify(make_storage(third), out);
+            verify(make_storage([](int i, int j, int k) { return (double)(float)(third(i, j, k) / 3.) * 3; }), loaded);
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,158 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/expandable_parameters/make_computation.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        struct lap_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = 4 * eval(in()) - (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) +
+                                                   eval(in(0, 1, 0)));
+            }
+        };
+
+        struct rebind_grid : computation_fixture<2> {
+            rebind_grid() : computation_fixture<2>(29, 23, 7) {}
+
+            static float_type in(int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17; }
+            static float_type lap(int i, int j, int k) {
+                return 4 * in(i, j, k) - (in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k));
+            }
+            static float_type lap_lap(int i, int j, int k) {
+                return 4 * lap(i, j, k) - (lap(i - 1, j, k) + lap(i + 1, j, k) + lap(i, j - 1, k) + lap(i, j + 1, k));
+            }
+
+            // the compute domain [i, i + ni) x [j, j + nj) x [0, nk)
+            static grid<axis<1>::axis_interval_t> sub_grid(uint_t i, uint_t ni, uint_t j, uint_t nj, uint_t nk) {
+                return gridtools::make_grid(
+                    halo_descriptor(halo_size, halo_size, i, i + ni - 1, i + ni + halo_size),
+                    halo_descriptor(halo_size, halo_size, j, j + nj - 1, j + nj + halo_size),
+                    nk);
+            }
+
+            // the expected values on the compute domain of `grid`, `init` elsewhere
+            template <class Grid>
+            static std::function<float_type(int, int, int)> on(Grid const &grid, float_type init) {
+                int i0 = grid.i_low_bound(), i1 = grid.i_high_bound(), j0 = grid.j_low_bound(),
+                    j1 = grid.j_high_bound(), k1 = grid.k_max();
+                return [=](int i, int j, int k) {
+                    return i >= i0 && i <= i1 && j >= j0 && j <= j1 && k <= k1 ? lap_lap(i, j, k) : init;
+                };
+            }
+
+            // the temporary is written and read in different multistages, such that it is never cached
+            auto make_lap_lap(grid<axis<1>::axis_interval_t> const &grid)
+                GT_AUTO_RETURN(gridtools::make_computation<backend_t>(grid,
+                    p_0 = make_storage(in),
+                    make_multistage(execute::parallel(), make_stage<lap_functor>(p_0, p_tmp_0)),
+                    make_multistage(execute::parallel(), make_stage<lap_functor>(p_tmp_0, p_1))));
+        };
+
+        template <class Computation>
+        void const *tmp_storage_info(Computation const &comp) {
+            return std::get<0>(comp.tmp_arg_storage_pairs()).m_value.get_storage_info_ptr().get();
+        }
+
+        TEST_F(rebind_grid, shrink_and_grow) {
+            auto small = sub_grid(5, 9, 4, 6, 3);
+            auto out = make_storage(-1.);
+            auto comp = make_lap_lap(small);
+            comp.run(p_1 = out);
+            verify(make_storage(on(small, -1)), out);
+
+            // a smaller grid reuses the temporary
+            auto smaller = sub_grid(11, 4, 13, 5, 2);
+            auto tmp = tmp_storage_info(comp);
+            comp.rebind_grid(smaller);
+            EXPECT_EQ(tmp, tmp_storage_info(comp));
+            out = make_storage(-1.);
+            comp.run(p_1 = out);
+            verify(make_storage(on(smaller, -1)), out);
+
+            // the full grid needs a larger one
+            comp.rebind_grid(make_grid());
+            EXPECT_NE(tmp, tmp_storage_info(comp));
+            comp.run(p_1 = out);
+            verify(make_storage(on(make_grid(), -1)), out);
+
+            // which is reused afterwards
+            tmp = tmp_storage_info(comp);
+            comp.rebind_grid(small);
+            EXPECT_EQ(tmp, tmp_storage_info(comp));
+            out = make_storage(-1.);
+            comp.run(p_1 = out);
+            verify(make_storage(on(small, -1)), out);
+        }
+
+        TEST_F(rebind_grid, invalid_grid) {
+            auto out = make_storage(-1.);
+            auto comp = make_lap_lap(make_grid());
+
+            // the halos are smaller than the extents of the input
+            EXPECT_THROW(comp.rebind_grid(gridtools::make_grid(
+                             halo_descriptor(1, 1, 1, d1() - 2, d1()), halo_descriptor(d2()), d3())),
+                std::runtime_error);
+            // the grid exceeds the data stores
+            EXPECT_THROW(comp.rebind_grid(sub_grid(halo_size, d1(), halo_size, 1, 1)), std::runtime_error);
+
+            // the computation is still bound to the old grid
+            comp.run(p_1 = out);
+            verify(make_storage(on(make_grid(), -1)), out);
+        }
+
+        TEST_F(rebind_grid, type_erased) {
+            auto out = make_storage(-1.);
+            computation<arg<1>> comp = make_lap_lap(make_grid());
+            auto small = sub_grid(3, 7, 2, 8, 5);
+            comp.rebind_grid(small);
+            comp.run(p_1 = out);
+            verify(make_storage(on(small, -1)), out);
+
+            EXPECT_THROW(comp.rebind_grid(gridtools::make_grid(d1(), d2(), axis<2>(3, 4))), std::runtime_error);
+        }
+
+        TEST_F(rebind_grid, expandable_parameters) {
+            using storages_t = std::vector<storage_type>;
+            storages_t ins, outs;
+            for (int t = 0; t != 5; ++t) {
+                ins.push_back(make_storage(in));
+                outs.push_back(make_storage(-1.));
+            }
+            arg<0, storages_t> p_in;
+            arg<1, storages_t> p_out;
+            tmp_arg<2, storages_t> p_tmp;
+            auto comp = make_expandable_computation<backend_t>(expand_factor<2>(),
+                sub_grid(4, 5, 6, 7, 4),
+                p_in = ins,
+                p_out = outs,
+                make_multistage(execute::parallel(), make_stage<lap_functor>(p_in, p_tmp)),
+                make_multistage(execute::parallel(), make_stage<lap_functor>(p_tmp, p_out)));
+            comp.rebind_grid(make_grid());
+            comp.run();
+            for (auto const &out : outs)
+                verify(make_storage(lap_lap), out);
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,124 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/reductions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        struct reductions : computation_fixture<2> {
+            reductions() : computation_fixture<2>(29, 23, 7) {}
+
+            // values in the halo are large to detect points outside of the compute domain
+            std::function<float_type(int, int, int)> with_halo(std::function<float_type(int, int, int)> f) const {
+                int ni = d1(), nj = d2();
+                return [=](int i, int j, int k) {
+                    bool halo = i < (int)halo_size || j < (int)halo_size || i >= ni - (int)halo_size ||
+                                j >= nj - (int)halo_size;
+                    return halo ? (float_type)1e6 : f(i, j, k);
+                };
+            }
+
+            static float_type in(int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17 - (float_type)8.5; }
+
+            // serial reference over the compute domain
+            template <class F, class G>
+            long double reference(F const &f, G const &combine, long double init) const {
+                long double res = init;
+                for (int i = halo_size; i != (int)(d1() - halo_size); ++i)
+                    for (int j = halo_size; j != (int)(d2() - halo_size); ++j)
+                        for (int k = 0; k != (int)d3(); ++k)
+                            res = combine(res, f(i, j, k));
+                return res;
+            }
+
+            static long double plus(long double a, long double b) { return a + b; }
+        };
+
+        TEST_F(reductions, operations) {
+            auto data = make_storage(with_halo(in));
+            auto grid = make_grid();
+            const float_type eps = 16 * std::numeric_limits<float_type>::epsilon();
+
+            auto sum = reference(in, plus, 0);
+            auto norm1 = reference([](int i, int j, int k) { return std::abs(in(i, j, k)); }, plus, 0);
+            auto norm2 = std::sqrt(reference([](int i, int j, int k) { return in(i, j, k) * in(i, j, k); }, plus, 0));
+            auto min = reference(in, [](long double a, long double b) { return std::min(a, b); }, 1e9);
+            auto max = reference(in, [](long double a, long double b) { return std::max(a, b); }, -1e9);
+
+            EXPECT_NEAR(sum, reduce(grid, reduction::sum(data)), eps * norm1);
+            EXPECT_NEAR(norm1, reduce(grid, reduction::norm1(data)), eps * norm1);
+            EXPECT_NEAR(norm2, reduce(grid, reduction::norm2(data)), eps * norm2);
+            EXPECT_EQ(min, reduce(grid, reduction::min(data)));
+            EXPECT_EQ(max, reduce(grid, reduction::max(data)));
+            EXPECT_EQ(std::max(-min, max), reduce(grid, reduction::norm_inf(data)));
+        }
+
+        TEST_F(reductions, fused) {
+            auto a = make_storage(with_halo(in));
+            auto b = make_storage(with_halo([](int i, int j, int k) { return (float_type)(i - j + k); }));
+            auto grid = make_grid();
+
+            float_type sum, min, max;
+            std::tie(sum, min, max) =
+                reduce(reduction_order::pairwise, grid, reduction::sum(a), reduction::min(b), reduction::max(b));
+            EXPECT_EQ(reduce(reduction_order::pairwise, grid, reduction::sum(a)), sum);
+            EXPECT_EQ((float_type)halo_size - (float_type)(d2() - halo_size - 1), min);
+            EXPECT_EQ((float_type)(d1() - halo_size - 1) - (float_type)halo_size + d3() - 1, max);
+        }
+
+        TEST_F(reductions, masked_dimensions) {
+            auto data = make_storage<j_storage_type>([](int, int j, int) { return (float_type)j; });
+            float_type expected = 0;
+            for (int j = halo_size; j != (int)(d2() - halo_size); ++j)
+                expected += j;
+            expected *= (d1() - 2 * halo_size) * d3();
+            EXPECT_EQ(expected, reduce(reduction_order::kahan, make_grid(), reduction::sum(data)));
+        }
+
+        TEST_F(reductions, compensated_sum) {
+            // alternating large and small values, the small ones are lost by a plain sum
+            auto value = [](int i, int j, int k) { return (i + j + k) % 2 ? (float_type)1e8 : (float_type)1e-3; };
+            auto data = make_storage(with_halo(value));
+            auto grid = make_grid();
+            auto expected = reference(value, plus, 0);
+
+            auto kahan = reduce(reduction_order::kahan, grid, reduction::sum(data));
+            EXPECT_NEAR(expected, kahan, expected * std::numeric_limits<float_type>::epsilon());
+            auto pairwise = reduce(reduction_order::pairwise, grid, reduction::sum(data));
+            EXPECT_LE(std::abs(expected - kahan), std::abs(expected - pairwise));
+        }
+
+#ifndef GT_USE_THREAD_POOL
+        TEST_F(reductions, deterministic_for_any_number_of_threads) {
+            auto data = make_storage(with_halo([](int i, int j, int k) { return std::sin(i * 1.3 + j * .7 + k); }));
+            auto grid = make_grid();
+            const int max_threads = omp_get_max_threads();
+            for (auto order : {reduction_order::pairwise, reduction_order::kahan}) {
+                omp_set_num_threads(1);
+                auto serial = reduce(order, grid, reduction::norm2(data));
+                omp_set_num_threads(3);
+                EXPECT_EQ(serial, reduce(order, grid, reduction::norm2(data)));
+                omp_set_num_threads(max_threads);
+            }
+        }
+#endif
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,138 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        using axis_t = axis<2>;
+        using static_axis_t = static_axis<axis_t, 20, 40>;
+
+        static_assert(std::is_same<static_axis_t::static_splitters_t, static_splitters<0, 20, 60>>::value, "");
+        static_assert(std::is_same<static_axis<axis<1>, 60>::static_splitters_t, static_splitters<0, 60>>::value, "");
+        static_assert(static_splitters<0, 20, 60>::at(2) == 60, "");
+        static_assert(std::is_same<decltype(make_grid(1, 1, static_axis_t{})),
+                          grid<axis_t::axis_interval_t, static_splitters<0, 20, 60>>>::value,
+            "");
+        static_assert(is_grid<decltype(make_grid(1, 1, static_axis_t{}))>::value, "");
+
+        using lower_t = axis_t::get_interval<0>;
+        using upper_t = axis_t::get_interval<1>;
+
+        TEST(static_axis, same_bounds_as_runtime_axis) {
+            auto static_grid = make_grid(4, 5, static_axis_t{});
+            auto runtime_grid = make_grid(4, 5, axis_t(20, 40));
+            EXPECT_EQ(runtime_grid.value_list, static_grid.value_list);
+            EXPECT_EQ(runtime_grid.k_min(), static_grid.k_min());
+            EXPECT_EQ(runtime_grid.k_max(), static_grid.k_max());
+            EXPECT_EQ(60, static_grid.k_total_length());
+            EXPECT_EQ(runtime_grid.value_at<upper_t::FromLevel>(), static_grid.value_at<upper_t::FromLevel>());
+            EXPECT_EQ(runtime_grid.value_at<lower_t::ToLevel>(), static_grid.value_at<lower_t::ToLevel>());
+            using inner_t = axis_t::full_interval::modify<1, -1>;
+            EXPECT_EQ(runtime_grid.value_at<inner_t::ToLevel>(), static_grid.value_at<inner_t::ToLevel>());
+        }
+
+        struct forward_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1, extent<0, 0, 0, 0, -1, 0>>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, lower_t::first_level) {
+                eval(out()) = eval(in());
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, lower_t::modify<1, 0>) {
+                eval(out()) = eval(out(0, 0, -1)) + eval(in());
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, upper_t) {
+                eval(out()) = eval(out(0, 0, -1)) - 2 * eval(in());
+            }
+        };
+
+        struct backward_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1, extent<0, 0, 0, 0, 0, 1>>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis_t::full_interval::last_level) {
+                eval(out()) = eval(in());
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, axis_t::full_interval::modify<0, -1>) {
+                eval(out()) = eval(out(0, 0, 1)) * float_type{.5} + eval(in());
+            }
+        };
+
+        struct parallel_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, lower_t) {
+                eval(out()) = 3 * eval(in());
+            }
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval, upper_t) {
+                eval(out()) = -eval(in());
+            }
+        };
+
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3>;
+        using storage_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+
+        const uint_t d1 = 7, d2 = 5, d3 = 60;
+
+        template <class Functor, class Execution, class Grid>
+        storage_t run(Grid const &grid) {
+            storage_info_t info(d1, d2, d3);
+            storage_t in(info, [](int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17; });
+            storage_t out(info, -12345.);
+            arg<0, storage_t> p_in;
+            arg<1, storage_t> p_out;
+            make_computation<backend_t>(
+                grid, p_in = in, p_out = out, make_multistage(Execution(), make_stage<Functor>(p_in, p_out)))
+                .run();
+            out.sync();
+            return out;
+        }
+
+        template <class Functor, class Execution>
+        void check() {
+            auto expected = run<Functor, Execution>(make_grid(d1, d2, axis_t(20, 40)));
+            auto actual = run<Functor, Execution>(make_grid(d1, d2, static_axis_t{}));
+            auto expected_view = make_host_view(expected);
+            auto actual_view = make_host_view(actual);
+            for (uint_t i = 0; i < d1; ++i)
+                for (uint_t j = 0; j < d2; ++j)
+                    for (uint_t k = 0; k < d3; ++k) {
+                        EXPECT_NE(-12345, expected_view(i, j, k));
+                        EXPECT_EQ(expected_view(i, j, k), actual_view(i, j, k)) << i << " " << j << " " << k;
+                    }
+        }
+
+        TEST(static_axis, forward) { check<forward_functor, execute::forward>(); }
+
+        TEST(static_axis, backward) { check<backward_functor, execute::backward>(); }
+
+        TEST(static_axis, parallel) { check<parallel_functor, execute::parallel>(); }
+    } // namespace
+} // namespace gridtools
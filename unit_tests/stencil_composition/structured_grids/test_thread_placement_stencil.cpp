@@ -0,0 +1,81 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/common/thread_placement.hpp>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        struct lap_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = 4 * eval(in()) - (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) +
+                                                   eval(in(0, 1, 0)));
+            }
+        };
+
+        struct smooth_functor {
+            using in = in_accessor<0>;
+            using lap = in_accessor<1, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<2>;
+            using param_list = make_param_list<in, lap, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in()) - (float_type).25 * (4 * eval(lap()) - (eval(lap(-1, 0, 0)) +
+                                                                                    eval(lap(1, 0, 0)) +
+                                                                                    eval(lap(0, -1, 0)) +
+                                                                                    eval(lap(0, 1, 0))));
+            }
+        };
+
+        struct thread_placement_stencil : computation_fixture<2> {
+            thread_placement_stencil() : computation_fixture<2>(68, 68, 20) {}
+        };
+
+        /**
+         * Runs a two stage stencil with a temporary for every placement and checks that the results do not depend on
+         * the placement.
+         */
+        TEST_F(thread_placement_stencil, placements) {
+            auto in_f = [](int i, int j, int k) -> float_type { return (i * 7 + j * 13 + k * 3) % 17; };
+            auto lap = [&](int i, int j, int k) {
+                return 4 * in_f(i, j, k) -
+                       (in_f(i - 1, j, k) + in_f(i + 1, j, k) + in_f(i, j - 1, k) + in_f(i, j + 1, k));
+            };
+            auto expected = [&](int i, int j, int k) {
+                return in_f(i, j, k) - (float_type).25 * (4 * lap(i, j, k) - (lap(i - 1, j, k) + lap(i + 1, j, k) +
+                                                                                 lap(i, j - 1, k) + lap(i, j + 1, k)));
+            };
+
+            auto out = make_storage();
+            auto comp = make_computation(p_0 = make_storage(in_f),
+                p_1 = out,
+                make_multistage(execute::parallel(),
+                    make_stage<lap_functor>(p_0, p_tmp_0),
+                    make_stage<smooth_functor>(p_0, p_tmp_0, p_1)));
+
+            for (auto name : {"none", "compact", "compact-nosmt", "scatter", "scatter-nosmt"}) {
+                set_thread_placement(thread_placement::parse(name));
+                comp.run();
+                verify(make_storage(expected), out);
+            }
+            set_thread_placement(thread_placement());
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,157 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/column_mask.hpp>
+#include <gridtools/stencil_composition/expandable_parameters/make_computation.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+namespace gridtools {
+    namespace {
+        struct lap_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = 4 * eval(in()) - (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) +
+                                                   eval(in(0, 1, 0)));
+            }
+        };
+
+        struct position_functor {
+            using out = inout_accessor<0>;
+            using param_list = make_param_list<out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval.i() * 10000 + eval.j() * 100 + eval.k();
+            }
+        };
+
+        struct tile_size : computation_fixture<2> {
+            tile_size() : computation_fixture<2>(29, 23, 7) {}
+
+            static float_type in(int i, int j, int k) { return (i * 7 + j * 13 + k * 3) % 17; }
+            static float_type lap(int i, int j, int k) {
+                return 4 * in(i, j, k) - (in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k));
+            }
+            static float_type lap_lap(int i, int j, int k) {
+                return 4 * lap(i, j, k) - (lap(i - 1, j, k) + lap(i + 1, j, k) + lap(i, j - 1, k) + lap(i, j + 1, k));
+            }
+
+            // the temporary is written and read in different multistages, such that it is never cached
+            auto make_lap_lap() GT_AUTO_RETURN(make_computation(p_0 = make_storage(in),
+                make_multistage(execute::parallel(), make_stage<lap_functor>(p_0, p_tmp_0)),
+                make_multistage(execute::parallel(), make_stage<lap_functor>(p_tmp_0, p_1))));
+        };
+
+#ifdef GT_BACKEND_X86
+        const std::vector<std::pair<uint_t, uint_t>> tiles = {{1, 1}, {3, 5}, {8, 8}, {64, 2}, {100, 100}};
+
+        TEST_F(tile_size, temporaries) {
+            auto comp = make_lap_lap();
+            for (auto const &tile : tiles) {
+                comp.set_tile_size(tile.first, tile.second);
+                EXPECT_EQ(tile.first, comp.backend().tile_i);
+                EXPECT_EQ(tile.second, comp.backend().tile_j);
+                auto out = make_storage(-1.);
+                comp.run(p_1 = out);
+                verify(make_storage(lap_lap), out);
+            }
+        }
+
+        TEST_F(tile_size, positional) {
+            auto comp = gridtools::make_positional_computation<backend_t>(
+                make_grid(), make_multistage(execute::forward(), make_stage<position_functor>(p_0)));
+            for (auto const &tile : tiles) {
+                comp.set_tile_size(tile.first, tile.second);
+                auto out = make_storage(-1.);
+                comp.run(p_0 = out);
+                verify(make_storage([](int i, int j, int k) {
+                    bool inner = i >= 2 && i < 27 && j >= 2 && j < 21;
+                    return inner ? i * 10000 + j * 100 + k : -1;
+                }),
+                    out);
+            }
+        }
+
+        TEST_F(tile_size, masked) {
+            auto comp = make_lap_lap();
+            comp.set_tile_size(3, 2);
+            auto out = make_storage(-1.);
+            comp.run_masked(
+                column_mask(d1() - 4, d2() - 4, [](int_t i, int_t j) { return (i + j) % 3 == 0; }), p_1 = out);
+            verify(make_storage([](int i, int j, int k) {
+                bool inner = i >= 2 && i < 27 && j >= 2 && j < 21;
+                return inner && (i + j - 4) % 3 == 0 ? lap_lap(i, j, k) : -1;
+            }),
+                out);
+        }
+
+        TEST_F(tile_size, type_erased) {
+            computation<arg<1>> comp = make_lap_lap();
+            comp.set_tile_size(5, 3);
+            auto out = make_storage(-1.);
+            comp.run(p_1 = out);
+            verify(make_storage(lap_lap), out);
+        }
+
+        TEST_F(tile_size, expandable_parameters) {
+            using storages_t = std::vector<storage_type>;
+            storages_t ins, outs;
+            for (int t = 0; t != 5; ++t) {
+                ins.push_back(make_storage(in));
+                outs.push_back(make_storage(-1.));
+            }
+            arg<0, storages_t> p_in;
+            arg<1, storages_t> p_out;
+            tmp_arg<2, storages_t> p_tmp;
+            auto comp = make_expandable_computation<backend_t>(expand_factor<2>(),
+                make_grid(),
+                p_in = ins,
+                p_out = outs,
+                make_multistage(execute::parallel(), make_stage<lap_functor>(p_in, p_tmp)),
+                make_multistage(execute::parallel(), make_stage<lap_functor>(p_tmp, p_out)));
+            comp.set_tile_size(13, 4);
+            comp.run();
+            for (auto const &out : outs)
+                verify(make_storage(lap_lap), out);
+        }
+
+        TEST_F(tile_size, environment) {
+            setenv("GT_TILE_I", "6", 1);
+            setenv("GT_TILE_J", "0", 1);
+            auto comp = make_lap_lap();
+            unsetenv("GT_TILE_I");
+            unsetenv("GT_TILE_J");
+            EXPECT_EQ(6, comp.backend().tile_i);
+            EXPECT_EQ(GT_DEFAULT_TILE_J, comp.backend().tile_j);
+            auto out = make_storage(-1.);
+            comp.run(p_1 = out);
+            verify(make_storage(lap_lap), out);
+
+            EXPECT_THROW(comp.set_tile_size(0, 4), std::runtime_error);
+        }
+#else
+        TEST_F(tile_size, not_supported) {
+            computation<arg<1>> comp = make_lap_lap();
+            EXPECT_THROW(comp.set_tile_size(5, 3), std::runtime_error);
+        }
+#endif
+    } // namespace
+} // namespace gridtools
@@ -10,6 +10,7 @@
 
 #include <gridtools/stencil_composition/computation.hpp>
 
+#include <future>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -120,5 +121,17 @@ namespace gridtools {
             testee.run(a{} = data(), b{} = data());
             EXPECT_EQ(testee.get_count(), 2);
         }
+
+        TEST(computation, run_async) {
+            computation<a, b> testee = my_computation{};
+            data_store_t::storage_info_t info(3);
+            data_store_t x(info, "x"), y(info, "y");
+            std::vector<std::future<void>> futures;
+            for (int i = 0; i < 10; ++i)
+                futures.push_back(testee.run_async(a{} = x, b{} = y));
+            for (auto &future : futures)
+                future.get();
+            EXPECT_EQ(testee.get_count(), 10);
+        }
     } // namespace
 } // namespace gridtools
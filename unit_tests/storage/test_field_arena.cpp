@@ -0,0 +1,205 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/storage/field_arena.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        using traits_t = storage_traits<backend_t>;
+        using storage_info_t = traits_t::storage_info_t<0, 3, halo<1, 1, 0>>;
+        using data_store_t = traits_t::data_store_t<float_type, storage_info_t>;
+
+        std::size_t set_offset(data_store_t const &field) {
+            auto const &info = field.info();
+            auto origin = field.get_storage_ptr()->get_cpu_ptr() + info.first_index_of_inner_region();
+            return reinterpret_cast<std::uintptr_t>(origin) % 4096;
+        }
+
+        std::size_t distance(std::size_t a, std::size_t b) {
+            std::size_t d = (a + 4096 - b) % 4096;
+            return std::min(d, 4096 - d);
+        }
+
+        // sizes whose planes are multiples of the page size, separately allocated fields alias
+        TEST(field_arena, staggered_offsets) {
+            field_arena arena(4);
+            storage_info_t info(64, 64, 8);
+            std::vector<data_store_t> fields;
+            for (int f = 0; f < 8; ++f)
+                fields.push_back(arena.make<data_store_t>(info, "f" + std::to_string(f)));
+
+            auto const &placements = arena.placements();
+            ASSERT_EQ(8, placements.size());
+            for (int f = 0; f < 8; ++f) {
+                EXPECT_EQ(f / 4, placements[f].group);
+                EXPECT_EQ(placements[f].set_offset, set_offset(fields[f]));
+                EXPECT_EQ(0, set_offset(fields[f]) % 64);
+            }
+            // the fields of a group are spread over the sets, also relative to the neighbouring rows
+            for (int group = 0; group < 2; ++group)
+                for (int a = 4 * group; a < 4 * group + 4; ++a)
+                    for (int b = 4 * group; b < a; ++b)
+                        for (auto stride : info.strides()) {
+                            std::size_t shift = stride * sizeof(float_type) % 4096;
+                            EXPECT_GE(distance(set_offset(fields[a]), set_offset(fields[b])), 512);
+                            EXPECT_GE(distance((set_offset(fields[a]) + shift) % 4096, set_offset(fields[b])), 512);
+                        }
+        }
+
+        TEST(field_arena, fields_do_not_overlap) {
+            field_arena arena(3, 1 << 17);
+            storage_info_t info(20, 30, 10);
+            std::vector<data_store_t> fields;
+            for (int f = 0; f < 10; ++f)
+                fields.push_back(arena.make<data_store_t>(info, f, "f" + std::to_string(f)));
+            arena.next_group();
+            EXPECT_GT(arena.placements().size(), 0);
+            EXPECT_LT(1, arena.placements().back().region);
+            EXPECT_LE(2 << 17, arena.allocated_bytes());
+
+            for (int f = 0; f < 10; ++f) {
+                auto view = make_host_view(fields[f]);
+                for (int i = 0; i < 20; ++i)
+                    for (int j = 0; j < 30; ++j)
+                        for (int k = 0; k < 10; ++k) {
+                            EXPECT_EQ(f, view(i, j, k));
+                            view(i, j, k) = 1000 * f + i + j + k;
+                        }
+            }
+            for (int f = 0; f < 10; ++f) {
+                auto view = make_host_view(fields[f]);
+                for (int i = 0; i < 20; ++i)
+                    for (int j = 0; j < 30; ++j)
+                        for (int k = 0; k < 10; ++k)
+                            EXPECT_EQ(1000 * f + i + j + k, view(i, j, k));
+            }
+        }
+
+        TEST(field_arena, next_group) {
+            field_arena arena;
+            storage_info_t info(8, 8, 4);
+            arena.make<data_store_t>(info);
+            arena.next_group();
+            arena.next_group();
+            arena.make<data_store_t>(info);
+            arena.make<data_store_t>(info);
+            auto const &placements = arena.placements();
+            EXPECT_EQ(0, placements[0].group);
+            EXPECT_EQ(1, placements[1].group);
+            EXPECT_EQ(1, placements[2].group);
+            // the first field of a group is placed at set offset 0
+            EXPECT_EQ(0, placements[1].set_offset);
+            EXPECT_NE(0, placements[2].set_offset);
+        }
+
+        TEST(field_arena, report) {
+            field_arena arena;
+            arena.make<data_store_t>(storage_info_t(8, 8, 4), "u");
+            arena.make<data_store_t>(storage_info_t(8, 8, 4));
+            auto report = arena.report();
+            EXPECT_NE(std::string::npos, report.find("2 fields in 1 regions"));
+            EXPECT_NE(std::string::npos, report.find("u: group 0, region 0, offset "));
+            EXPECT_NE(std::string::npos, report.find("<unnamed>"));
+        }
+
+        // out = sum of 8 fields at the point and at its neighbour in j
+        struct many_fields_functor {
+            using f0 = in_accessor<0, extent<0, 0, 0, 1>>;
+            using f1 = in_accessor<1, extent<0, 0, 0, 1>>;
+            using f2 = in_accessor<2, extent<0, 0, 0, 1>>;
+            using f3 = in_accessor<3, extent<0, 0, 0, 1>>;
+            using f4 = in_accessor<4, extent<0, 0, 0, 1>>;
+            using f5 = in_accessor<5, extent<0, 0, 0, 1>>;
+            using f6 = in_accessor<6, extent<0, 0, 0, 1>>;
+            using f7 = in_accessor<7, extent<0, 0, 0, 1>>;
+            using out = inout_accessor<8>;
+            using param_list = make_param_list<f0, f1, f2, f3, f4, f5, f6, f7, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(f0()) + eval(f0(0, 1, 0)) + eval(f1()) + eval(f1(0, 1, 0)) + eval(f2()) +
+                              eval(f2(0, 1, 0)) + eval(f3()) + eval(f3(0, 1, 0)) + eval(f4()) + eval(f4(0, 1, 0)) +
+                              eval(f5()) + eval(f5(0, 1, 0)) + eval(f6()) + eval(f6(0, 1, 0)) + eval(f7()) +
+                              eval(f7(0, 1, 0));
+            }
+        };
+
+        /**
+         * Runs a stencil on 9 fields allocated separately (hugepage_alloc) and in an arena and checks that the results
+         * are equal.
+         */
+        TEST(field_arena, stencil) {
+            const int n = 64, nk = 16;
+            storage_info_t info(n, n, nk);
+            auto init = [](int i, int j, int k) -> float_type { return (i * 7 + j * 13 + k * 3) % 17; };
+            field_arena arena(9);
+            std::vector<data_store_t> separate, placed;
+            for (int f = 0; f < 9; ++f) {
+                separate.emplace_back(info, init);
+                placed.push_back(arena.make<data_store_t>(info));
+                auto src = make_host_view(separate.back());
+                auto dst = make_host_view(placed.back());
+                for (int i = 0; i < n; ++i)
+                    for (int j = 0; j < n; ++j)
+                        for (int k = 0; k < nk; ++k)
+                            dst(i, j, k) = src(i, j, k);
+            }
+
+            auto run = [&](std::vector<data_store_t> const &fields) {
+                arg<0, data_store_t> p_0;
+                arg<1, data_store_t> p_1;
+                arg<2, data_store_t> p_2;
+                arg<3, data_store_t> p_3;
+                arg<4, data_store_t> p_4;
+                arg<5, data_store_t> p_5;
+                arg<6, data_store_t> p_6;
+                arg<7, data_store_t> p_7;
+                arg<8, data_store_t> p_out;
+                auto comp = make_computation<backend_t>(make_grid(n, halo_descriptor(0, 1, 1, n - 2, n), nk),
+                    p_0 = fields[0],
+                    p_1 = fields[1],
+                    p_2 = fields[2],
+                    p_3 = fields[3],
+                    p_4 = fields[4],
+                    p_5 = fields[5],
+                    p_6 = fields[6],
+                    p_7 = fields[7],
+                    p_out = fields[8],
+                    make_multistage(execute::parallel(),
+                        make_stage<many_fields_functor>(p_0, p_1, p_2, p_3, p_4, p_5, p_6, p_7, p_out)));
+                comp.run();
+            };
+            run(separate);
+            run(placed);
+
+            auto expected = make_host_view(separate[8]);
+            auto actual = make_host_view(placed[8]);
+            for (int i = 0; i < n; ++i)
+                for (int j = 1; j < n - 1; ++j)
+                    for (int k = 0; k < nk; ++k)
+                        EXPECT_EQ(expected(i, j, k), actual(i, j, k));
+        }
+
+        TEST(field_arena, invalid) {
+            EXPECT_THROW(field_arena(0), std::runtime_error);
+            EXPECT_THROW(field_arena(4, 1 << 20, 100), std::runtime_error);
+        }
+    } // namespace
+} // namespace gridtools
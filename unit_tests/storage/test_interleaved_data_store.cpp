@@ -0,0 +1,204 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/storage/interleaved_data_store.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/interface/layout_transformation/layout_transformation.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        using interleaved_data_store_impl_::group_layout;
+        static_assert(std::is_same<group_layout<layout_map<2, 0, 1>>::type, layout_map<3, 0, 1, 2>>::value, "");
+        static_assert(std::is_same<group_layout<layout_map<0, 1, 2>>::type, layout_map<0, 1, 3, 2>>::value, "");
+        static_assert(std::is_same<group_layout<layout_map<1, -1, 0>>::type, layout_map<2, -1, 0, 1>>::value, "");
+
+        using traits_t = storage_traits<backend_t>;
+        using storage_info_t = traits_t::storage_info_t<7, 3, halo<1, 1, 0>>;
+        using field_t = traits_t::data_store_t<float_type, storage_info_t>;
+        using wind_t = interleaved_data_store<field_t, 3, 8>;
+        using component_t = wind_t::component_t;
+        static_assert(component_t::storage_info_t::id == 8, "");
+        static_assert(std::is_same<component_t::storage_info_t::layout_t, storage_info_t::layout_t>::value, "");
+
+        const uint_t d1 = 13, d2 = 9, d3 = 5;
+
+        TEST(interleaved_data_store, components_alias_the_group) {
+            wind_t wind(storage_info_t(d1, d2, d3), 1, "wind");
+            EXPECT_EQ(3, wind.size());
+            EXPECT_EQ("wind_2", wind[2].name());
+
+            auto group = make_host_view(wind.group());
+            auto const &group_strides = wind.group().strides();
+            for (uint_t c = 0; c < 3; ++c) {
+                EXPECT_EQ(wind[0].strides(), wind[c].strides());
+                auto view = make_host_view(wind[c]);
+                for (uint_t i = 0; i < d1; ++i)
+                    for (uint_t j = 0; j < d2; ++j)
+                        for (uint_t k = 0; k < d3; ++k) {
+                            EXPECT_EQ(1, view(i, j, k));
+                            view(i, j, k) = 100 * c + i + 10 * j + k;
+                            EXPECT_EQ(&group(i, j, k, c), &view(i, j, k));
+                            EXPECT_EQ(&view(i, j, k), &make_host_view(wind[0])(i, j, k) + c * group_strides[3]);
+                        }
+            }
+            for (uint_t c = 0; c < 3; ++c)
+                for (uint_t i = 0; i < d1; ++i)
+                    for (uint_t j = 0; j < d2; ++j)
+                        for (uint_t k = 0; k < d3; ++k)
+                            EXPECT_EQ(100 * c + i + 10 * j + k, group(i, j, k, c));
+        }
+
+        TEST(interleaved_data_store, rows_are_adjacent) {
+            wind_t wind(storage_info_t(d1, d2, d3));
+            using layout_t = storage_info_t::layout_t;
+            auto const &strides = wind[0].strides();
+            uint_t contiguous = layout_t::find(layout_t::max());
+            uint_t next = layout_t::find(layout_t::max() - 1);
+            EXPECT_EQ(1, strides[contiguous]);
+            // the rows of the other components lie between two rows of a component
+            auto row_length = wind.group().strides()[3];
+            EXPECT_GE(row_length, wind[0].info().total_lengths()[contiguous]);
+            EXPECT_EQ(3 * row_length, strides[next]);
+        }
+
+        struct sum_functor {
+            using u = in_accessor<0>;
+            using v = in_accessor<1, extent<-1, 1, -1, 1>>;
+            using w = in_accessor<2>;
+            using out = inout_accessor<3>;
+            using param_list = make_param_list<u, v, w, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(u()) + eval(v(1, 0, 0)) - eval(v(0, -1, 0)) + eval(w());
+            }
+        };
+
+        TEST(interleaved_data_store, computation) {
+            storage_info_t info(d1, d2, d3);
+            wind_t wind(info);
+            for (uint_t c = 0; c < 3; ++c) {
+                auto view = make_host_view(wind[c]);
+                for (uint_t i = 0; i < d1; ++i)
+                    for (uint_t j = 0; j < d2; ++j)
+                        for (uint_t k = 0; k < d3; ++k)
+                            view(i, j, k) = 100 * c + i + 10 * j + k;
+            }
+            using out_storage_info_t = traits_t::storage_info_t<0, 3, halo<1, 1, 0>>;
+            using out_t = traits_t::data_store_t<float_type, out_storage_info_t>;
+            out_t out(out_storage_info_t(d1, d2, d3), -1);
+
+            arg<0, component_t> p_u;
+            arg<1, component_t> p_v;
+            arg<2, component_t> p_w;
+            arg<3, out_t> p_out;
+            auto grid = make_grid(halo_descriptor(1, 1, 1, d1 - 2, d1), halo_descriptor(1, 1, 1, d2 - 2, d2), d3);
+            make_computation<backend_t>(grid,
+                p_u = wind[0],
+                p_v = wind[1],
+                p_w = wind[2],
+                p_out = out,
+                make_multistage(execute::parallel(), make_stage<sum_functor>(p_u, p_v, p_w, p_out)))
+                .run();
+
+            out.sync();
+            auto view = make_host_view(out);
+            for (uint_t i = 0; i < d1; ++i)
+                for (uint_t j = 0; j < d2; ++j)
+                    for (uint_t k = 0; k < d3; ++k) {
+                        bool inner = i >= 1 && i < d1 - 1 && j >= 1 && j < d2 - 1;
+                        float_type u = i + 10 * j + k;
+                        float_type expected = u + (u + 100 + 1) - (u + 100 - 10) + (u + 200);
+                        EXPECT_EQ(inner ? expected : -1, view(i, j, k)) << i << " " << j << " " << k;
+                    }
+        }
+
+        // the components and the ordinary fields have different storage info types, hence their own strides
+        TEST(interleaved_data_store, mixed_with_ordinary_fields) {
+            storage_info_t info(d1, d2, d3);
+            wind_t wind(info, 1);
+            field_t ordinary(info, 2);
+            field_t out(info, -1);
+
+            arg<0, field_t> p_u;
+            arg<1, component_t> p_v;
+            arg<2, component_t> p_w;
+            arg<3, field_t> p_out;
+            auto grid = make_grid(halo_descriptor(1, 1, 1, d1 - 2, d1), halo_descriptor(1, 1, 1, d2 - 2, d2), d3);
+            make_computation<backend_t>(grid,
+                p_u = ordinary,
+                p_v = wind[1],
+                p_w = wind[2],
+                p_out = out,
+                make_multistage(execute::parallel(), make_stage<sum_functor>(p_u, p_v, p_w, p_out)))
+                .run();
+
+            out.sync();
+            auto view = make_host_view(out);
+            for (uint_t i = 0; i < d1; ++i)
+                for (uint_t j = 0; j < d2; ++j)
+                    for (uint_t k = 0; k < d3; ++k) {
+                        bool inner = i >= 1 && i < d1 - 1 && j >= 1 && j < d2 - 1;
+                        EXPECT_EQ(inner ? 3 : -1, view(i, j, k)) << i << " " << j << " " << k;
+                    }
+        }
+
+        TEST(interleaved_data_store, layout_transformation) {
+            wind_t wind(storage_info_t(d1, d2, d3), 0);
+            std::vector<float_type> src(d1 * d2 * d3);
+            for (uint_t i = 0; i < src.size(); ++i)
+                src[i] = i;
+            auto const &strides = wind[1].strides();
+            interface::transform(&make_host_view(wind[1])(0, 0, 0),
+                src.data(),
+                {d1, d2, d3},
+                {strides[0], strides[1], strides[2]},
+                {1, d1, d1 * d2});
+
+            auto v0 = make_host_view(wind[0]);
+            auto v1 = make_host_view(wind[1]);
+            auto v2 = make_host_view(wind[2]);
+            for (uint_t i = 0; i < d1; ++i)
+                for (uint_t j = 0; j < d2; ++j)
+                    for (uint_t k = 0; k < d3; ++k) {
+                        EXPECT_EQ(i + d1 * j + d1 * d2 * k, v1(i, j, k));
+                        EXPECT_EQ(0, v0(i, j, k));
+                        EXPECT_EQ(0, v2(i, j, k));
+                    }
+        }
+
+        TEST(interleaved_data_store, comm_halos) {
+            wind_t wind(storage_info_t(d1, d2, d3));
+            array<halo_descriptor, 3> halos = {halo_descriptor(1, 1, 1, d1 - 2, d1),
+                halo_descriptor(1, 1, 1, d2 - 2, d2),
+                halo_descriptor(0, 0, 0, d3 - 1, d3)};
+            auto res = wind.comm_halos(halos);
+            using layout_t = storage_info_t::layout_t;
+            auto const &strides = wind[0].strides();
+            for (uint_t d = 0; d < 3; ++d) {
+                EXPECT_EQ(halos[d].minus(), res[d].minus());
+                EXPECT_EQ(halos[d].plus(), res[d].plus());
+                EXPECT_EQ(halos[d].begin(), res[d].begin());
+                EXPECT_EQ(halos[d].end(), res[d].end());
+                if (layout_t::at(d) == 0)
+                    EXPECT_EQ(halos[d].total_length(), res[d].total_length());
+                else
+                    EXPECT_EQ(strides[layout_t::find(layout_t::at(d) - 1)], res[d].total_length() * strides[d]);
+            }
+        }
+    } // namespace
+} // namespace gridtools